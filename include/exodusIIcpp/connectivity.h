@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "exodusIIcpp/span.h"
+
+namespace exodusIIcpp {
+
+/// Connectivity of all elements of a mesh
+///
+/// Elements from all element blocks are stored in compressed sparse row (CSR) format, ordered by
+/// their global index. Elements can have different types and numbers of nodes.
+class Connectivity {
+protected:
+    /// Offsets into `node_ids`. Nodes of element `e` are `node_ids[offsets[e]..offsets[e + 1])`.
+    std::vector<int64_t> offsets;
+    /// Node IDs of all elements
+    std::vector<int> node_ids;
+    /// Element type of each element, index into `elem_types`
+    std::vector<int> type_tags;
+    /// Element types
+    std::vector<std::string> elem_types;
+
+public:
+    Connectivity();
+
+    /// Get the number of elements
+    ///
+    /// @return The number of elements
+    int64_t get_num_elements() const;
+
+    /// Get nodes of an element
+    ///
+    /// This does not allocate any memory, the returned span views the connectivity array.
+    ///
+    /// @param elem_idx Global index of the element: `[0..<number of elements>)`
+    /// @return Node IDs that comprise the element
+    Span<const int> get_element_nodes(int64_t elem_idx) const;
+
+    /// Get the element type of an element
+    ///
+    /// @param elem_idx Global index of the element: `[0..<number of elements>)`
+    /// @return Element type
+    const std::string & get_element_type(int64_t elem_idx) const;
+
+    /// Get offsets into the array of node IDs
+    ///
+    /// @return Offsets, there is `<number of elements> + 1` of them
+    const std::vector<int64_t> & get_offsets() const;
+
+    /// Get node IDs of all elements
+    ///
+    /// @return Node IDs of all elements
+    const std::vector<int> & get_node_ids() const;
+
+    /// Get element type tags
+    ///
+    /// @return Index into the array of element types for each element
+    /// @see get_element_types
+    const std::vector<int> & get_type_tags() const;
+
+    /// Get element types
+    ///
+    /// @return Element types present in the mesh
+    const std::vector<std::string> & get_element_types() const;
+
+    /// Set the connectivity
+    ///
+    /// Arrays are moved into this object, no copies are made.
+    ///
+    /// @param offsets Offsets into `node_ids`, must contain `<number of elements> + 1` values
+    /// @param node_ids Node IDs of all elements
+    /// @param type_tags Element type of each element, index into `elem_types`
+    /// @param elem_types Element types
+    void set(std::vector<int64_t> offsets,
+             std::vector<int> node_ids,
+             std::vector<int> type_tags,
+             std::vector<std::string> elem_types);
+};
+
+} // namespace exodusIIcpp
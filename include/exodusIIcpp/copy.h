@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "exodusIIcpp/file.h"
+
+namespace exodusIIcpp {
+
+/// Copy the mesh of one ExodusII file into another
+///
+/// Copies the title, information records, coordinates and their names, node and element ID maps,
+/// element blocks, node sets and side sets, including their names. Coordinates and connectivity
+/// are streamed in chunks, so the mesh is never held in memory as a whole.
+///
+/// @param src File opened for reading
+/// @param dest File opened for writing, not initialized yet
+void copy_mesh(File & src, File & dest);
+
+/// Copy time steps from one ExodusII file into another
+///
+/// Time steps are stored in `dest` as steps `1..time_steps.size()`. Variables are copied one at a
+/// time (per element block for elemental variables) and one time step at a time, so only a single
+/// time step of a single variable is held in memory. All global variables of a time step are
+/// copied at once.
+///
+/// With `max_buffered_values > 0`, runs of consecutive time steps are read in ranges covering as
+/// many whole storage chunks of `src` as fit into that many values, so that compressed chunks
+/// holding several time steps are decompressed once. Variables whose chunk does not fit are still
+/// read one time step at a time, so at most `max(max_buffered_values, n)` values are held in
+/// memory, where `n` is the number of values of one time step of the largest variable.
+///
+/// @param src File opened for reading
+/// @param dest File opened for writing with the mesh already written, see `copy_mesh`. No
+/// variables may be defined on it yet.
+/// @param time_steps Time steps (1-based) of `src` to copy, in the order they are stored in `dest`
+/// @param dropped_variables Names of nodal, elemental and global variables that are not copied
+/// @param max_buffered_values Number of values of a variable read at once, 0 to read one time
+/// step at a time
+void copy_time_steps(File & src,
+                     File & dest,
+                     const std::vector<int> & time_steps,
+                     const std::vector<std::string> & dropped_variables = {},
+                     int64_t max_buffered_values = 0);
+
+/// Join results of restarted runs along time into one ExodusII file
+///
+/// All files must have the same mesh, which is checked by comparing their mesh fingerprints. The
+/// mesh is copied from the first file. Where time ranges overlap, the later file takes over: time
+/// steps of a file at or after the first time of any later file are skipped. Variables are taken
+/// from the first file and matched by name in the others. All files must have the same element
+/// blocks and must define the copied elemental variables on the same blocks. The time steps of
+/// each file are copied like in `copy_time_steps`.
+///
+/// @param file_paths Files to join, ordered as the runs were restarted
+/// @param dest File opened for writing, not initialized yet
+/// @param dropped_variables Names of nodal, elemental and global variables that are not copied
+/// @param max_buffered_values Number of values of a variable read at once, 0 to read one time
+/// step at a time, see `copy_time_steps`
+void join_time_steps(const std::vector<fs::path> & file_paths,
+                     File & dest,
+                     const std::vector<std::string> & dropped_variables = {},
+                     int64_t max_buffered_values = 0);
+
+/// Join the parts of a decomposed run into one ExodusII file
+///
+/// The inverse of `Decomposition::write`. The numbering of the joined mesh is built once from the
+/// node and element ID maps of the parts: nodes are ordered by their IDs, elements by their element
+/// blocks and then by their IDs. Shared nodes take their values from the first part that has them.
+/// All parts must have the same element blocks, variables and number of time steps. Variables are
+/// taken from the first part and matched by name in the others. Global variables are copied from
+/// the first part. An elemental variable is defined on a block if any part defines it there;
+/// elements of the parts that do not define it get NaN.
+///
+/// Time steps are streamed one at a time, so one time step of the selected variables is held in
+/// memory. All parts are kept open while the time steps are streamed. `n_threads` threads take
+/// parts one by one, read their values and scatter them into the joined variables. The ExodusII
+/// library is not thread-safe, so every read, including decompression, happens under one lock and
+/// the reads are serial. Only the scattering of one part overlaps with the read of another, so
+/// more threads help only when the scattering is a noticeable part of the time, e.g. for
+/// uncompressed files in the page cache.
+///
+/// @param part_paths Files with the parts, e.g. `mesh.e.4.0` ... `mesh.e.4.3`
+/// @param dest File opened for writing, not initialized yet
+/// @param dropped_variables Names of nodal, elemental and global variables that are not copied
+/// @param n_threads Number of threads scattering the values of the parts
+void join_parts(const std::vector<fs::path> & part_paths,
+                File & dest,
+                const std::vector<std::string> & dropped_variables = {},
+                unsigned int n_threads = 1);
+
+} // namespace exodusIIcpp
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "exodusIIcpp/file.h"
+
+namespace exodusIIcpp {
+
+/// Decomposition of a mesh into parts for parallel runs
+///
+/// Elements are partitioned by recursive coordinate bisection (RCB) of their centroids: a set of
+/// elements is split across the longest side of its bounding box, in proportion to the number of
+/// parts on either side, until there is one set per part. Elements without nodes, e.g. of NULL
+/// element blocks, have no centroid and are added to the smallest parts afterwards. Parts differ in
+/// size by at most one element.
+class Decomposition {
+protected:
+    /// Number of parts
+    int n_parts;
+    /// Part (0-based) of each element, indexed by global element index
+    std::vector<int> elem_parts;
+
+    /// Split a range of elements among parts `[part, part + n)`
+    ///
+    /// @param first First element of the range
+    /// @param last End of the range
+    /// @param part First part
+    /// @param n Number of parts
+    /// @param centroids Element centroids `[x0, y0, z0, x1, y1, z1, ...]`
+    void bisect(int64_t * first,
+                int64_t * last,
+                int part,
+                int n,
+                const std::vector<double> & centroids);
+
+public:
+    /// Decompose a mesh
+    ///
+    /// @param file File with coordinates and element blocks read
+    /// @param n_parts Number of parts
+    Decomposition(const File & file, int n_parts);
+
+    /// Get the number of parts
+    ///
+    /// @return Number of parts
+    int get_num_parts() const;
+
+    /// Get the part of each element
+    ///
+    /// @return Part (0-based) of each element, indexed by global element index
+    const std::vector<int> & get_element_parts() const;
+
+    /// Write the parts of the mesh into Nemesis files, one per part
+    ///
+    /// Each file holds the elements of its part and the nodes they reference, node and element ID
+    /// maps with the IDs in the original mesh, the node and side sets restricted to the part, and
+    /// the Nemesis load balance information including nodal and elemental communication maps.
+    /// The IDs are taken from the ID maps of `file` if they were read, otherwise they are the
+    /// 1-based indices in the original mesh. Parts are built by `n_threads` threads at once. The
+    /// files themselves are written one at a time, because the ExodusII library is not
+    /// thread-safe.
+    ///
+    /// @param file File with coordinates and element blocks read, the one passed to the
+    /// constructor. Node sets and side sets are written only if they were read.
+    /// @param file_path Path of the original mesh, see `get_part_file_path`
+    /// @param n_threads Number of threads building parts
+    /// @see File::read_node_id_map, File::read_elem_id_map
+    void write(const File & file, const fs::path & file_path, unsigned int n_threads = 1) const;
+
+    /// Get the path of the file holding a part
+    ///
+    /// Follows the Nemesis convention `<file_path>.<n_parts>.<part>`, with `part` zero-padded to the
+    /// number of digits of `n_parts`, e.g. `mesh.e.16.03`.
+    ///
+    /// @param file_path Path of the original mesh
+    /// @param n_parts Number of parts
+    /// @param part Part (0-based)
+    /// @return Path of the file holding the part
+    static fs::path get_part_file_path(const fs::path & file_path, int n_parts, int part);
+};
+
+} // namespace exodusIIcpp
@@ -5,6 +5,7 @@
 
 #include <string>
 #include <vector>
+#include "exodusIIcpp/span.h"
 
 namespace exodusIIcpp {
 
@@ -62,6 +63,15 @@ public:
     /// @return List of node IDs that comprise the element
     std::vector<int> get_element_connectivity(std::size_t element_idx) const;
 
+    /// Get the element connectivity without allocating memory
+    ///
+    /// @param element_idx Index of an element in the block. `0..<n>`, where `<n>`
+    /// is the size of the block. @see get_size
+    /// @return View of the node IDs that comprise the element
+    /// @note An exception is thrown if the index is out of range or the connectivity is not loaded,
+    /// e.g. for blocks read by `File::read_block_info`.
+    Span<const int> get_element_nodes(std::size_t element_idx) const;
+
     /// Get the number of elements in this element block
     ///
     /// @return The number of elements in this element block
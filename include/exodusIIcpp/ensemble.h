@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "exodusIIcpp/file.h"
+
+namespace exodusIIcpp {
+
+/// Ensemble of result files, typically from a parameter study
+///
+/// Members with identical meshes (same mesh fingerprint) share one in-memory mesh, so the mesh is
+/// read only once per distinct mesh. Variables are read for all members at
+/// once into a stacked buffer. At most `max_open_files` members are kept open; the least
+/// recently used one is closed when another one has to be opened.
+///
+/// An `Ensemble` must not be used from several threads at once.
+class Ensemble {
+protected:
+    /// Member of the ensemble
+    struct Member {
+        /// Path to the file
+        fs::path file_path;
+        /// Index of the mesh of this member
+        std::size_t mesh_idx;
+        /// Names of nodal variables
+        std::vector<std::string> nodal_var_names;
+        /// Names of elemental variables
+        std::vector<std::string> elem_var_names;
+        /// Names of global variables
+        std::vector<std::string> global_var_names;
+    };
+
+    /// Members
+    std::vector<Member> members;
+    /// Distinct meshes, with coordinates, element blocks, node sets and side sets read in
+    std::vector<std::unique_ptr<File>> meshes;
+    /// Fingerprint of each distinct mesh
+    std::vector<uint64_t> mesh_fingerprints;
+    /// Maximum number of files kept open at once
+    std::size_t max_open_files;
+    /// Open files as (member index, file) pairs, the least recently used first
+    mutable std::list<std::pair<std::size_t, std::unique_ptr<File>>> open_files;
+
+    /// Get an open file for a member, opening it if needed
+    const File & open_member(std::size_t member) const;
+
+    /// Check that all members share one mesh
+    void check_single_mesh() const;
+
+public:
+    /// Open an ensemble
+    ///
+    /// Every file is opened once to read its variable names and fingerprint its mesh. Files are
+    /// opened by `n_threads` threads, each holding one file open at a time. The ExodusII library
+    /// is not thread-safe, so all reads happen under one lock and are serial; only the hashing of
+    /// one file overlaps with the reads of others. Meshes not seen before are then read in from
+    /// their first member. Members are opened again when their variables are read.
+    ///
+    /// @param file_paths Paths to the member files
+    /// @param max_open_files Maximum number of files kept open at once
+    /// @param n_threads Number of threads opening and fingerprinting the files
+    explicit Ensemble(const std::vector<fs::path> & file_paths,
+                      std::size_t max_open_files = 16,
+                      unsigned int n_threads = 1);
+
+    /// Get the number of members
+    ///
+    /// @return Number of members
+    std::size_t get_num_members() const;
+
+    /// Get the path to the file of a member
+    ///
+    /// @param member Member index
+    /// @return Path to the file
+    const fs::path & get_file_path(std::size_t member) const;
+
+    /// Get the number of distinct meshes
+    ///
+    /// @return Number of distinct meshes
+    std::size_t get_num_meshes() const;
+
+    /// Get the index of the mesh of a member
+    ///
+    /// @param member Member index
+    /// @return Index of the mesh, meshes are numbered in the order they first appear
+    std::size_t get_mesh_index(std::size_t member) const;
+
+    /// Get the mesh of a member
+    ///
+    /// @param member Member index
+    /// @return Mesh with coordinates, element blocks, node sets and side sets read in. Members with
+    /// identical meshes share the same instance.
+    const File & get_mesh(std::size_t member) const;
+
+    /// Get the fingerprint of the mesh of a member
+    ///
+    /// @param member Member index
+    /// @return Fingerprint of the mesh
+    /// @see File::mesh_fingerprint
+    uint64_t get_mesh_fingerprint(std::size_t member) const;
+
+    /// Get the number of files that are currently open
+    ///
+    /// @return Number of open files
+    std::size_t get_num_open_files() const;
+
+    /// Read a nodal variable of all members
+    ///
+    /// All members must share one mesh.
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_name Variable name
+    /// @return Values indexed by `member * n_nodes + node_idx`
+    std::vector<double> read_nodal_variable(int time_step, const std::string & var_name) const;
+
+    /// Read an elemental variable of all members
+    ///
+    /// All members must share one mesh.
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_name Variable name
+    /// @return Values indexed by `member * n_elems + global element index`. Values of elements in
+    /// blocks where the variable is not defined are set to NaN.
+    std::vector<double> read_elemental_variable(int time_step, const std::string & var_name) const;
+
+    /// Read a global variable of all members
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_name Variable name
+    /// @return Values indexed by member
+    std::vector<double> read_global_variable(int time_step, const std::string & var_name) const;
+};
+
+} // namespace exodusIIcpp
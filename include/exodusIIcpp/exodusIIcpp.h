@@ -3,10 +3,23 @@
 
 #pragma once
 
+#include "connectivity.h"
+#include "copy.h"
+#include "decomposition.h"
 #include "element_block.h"
+#include "ensemble.h"
 #include "enums.h"
 #include "error.h"
 #include "exception.h"
 #include "file.h"
+#include "geometry.h"
+#include "id_map.h"
+#include "load_balance.h"
 #include "node_set.h"
+#include "probe.h"
+#include "reordering.h"
 #include "side_set.h"
+#include "skin.h"
+#include "span.h"
+#include "spatial_index.h"
+#include "step_writer.h"
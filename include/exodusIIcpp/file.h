@@ -3,19 +3,36 @@
 
 #pragma once
 
+#include <initializer_list>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <utility>
 #include <filesystem>
+#include "exodusIIcpp/connectivity.h"
 #include "exodusIIcpp/element_block.h"
 #include "exodusIIcpp/enums.h"
 #include "exodusIIcpp/error.h"
+#include "exodusIIcpp/geometry.h"
+#include "exodusIIcpp/id_map.h"
+#include "exodusIIcpp/load_balance.h"
 #include "exodusIIcpp/node_set.h"
+#include "exodusIIcpp/reordering.h"
 #include "exodusIIcpp/side_set.h"
+#include "exodusIIcpp/span.h"
+#ifdef EXODUSIICPP_WITH_MPI
+    #include <mpi.h>
+#endif
 
 namespace fs = std::filesystem;
 
 namespace exodusIIcpp {
 
+/// ExodusII file
+///
+/// A `File` must not be used from several threads at once. The ExodusII library is not
+/// thread-safe either, so calls on different `File` objects have to be serialized by the caller,
+/// unless netCDF and HDF5 were built thread-safe.
 class File {
 protected:
     /// File open/create policy
@@ -30,6 +47,8 @@ protected:
     std::string title;
     /// ExodusII file handle
     int exoid;
+    /// `true` if the file is shared by all ranks of an MPI communicator
+    bool parallel;
     /// Number of spatial dimensions
     int n_dim;
     /// Number of nodes
@@ -52,14 +71,51 @@ protected:
     std::vector<std::string> coord_names;
     /// Element map
     std::vector<int> elem_map;
+    /// Node ID map
+    IdMap node_id_map;
+    /// Element ID map
+    IdMap elem_id_map;
+    /// Element block IDs, in the order they are stored in the file
+    std::vector<int> blk_ids;
+    /// Prefix sum of element block sizes. Elements of the block at index `i` have global indices
+    /// `[blk_elem_ofst[i], blk_elem_ofst[i + 1])`.
+    std::vector<int64_t> blk_elem_ofst;
     /// Element blocks
     std::vector<ElementBlock> element_blocks;
+    /// Connectivity of all elements
+    Connectivity connectivity;
     /// Face sets
     std::vector<SideSet> side_sets;
     /// Node sets
     std::vector<NodeSet> node_sets;
     /// Times
     std::vector<double> time_values;
+    /// Whether the number of time steps and the nodal and global variable names are cached, which
+    /// they are in append mode
+    bool append_cache;
+    /// Number of time steps in the file, cached in append mode
+    int n_times;
+    /// Nodal variable names, cached in append mode
+    std::vector<std::string> nodal_var_names;
+    /// Elemental variable names, as read or written
+    std::vector<std::string> elem_var_names;
+    /// Global variable names, cached in append mode
+    std::vector<std::string> global_var_names;
+    /// Elemental variable truth table, as read or written. Empty for files open for writing or
+    /// appending that store no table, where variables are defined on the blocks they are written on
+    std::vector<int> elem_var_tab;
+    /// Reordering applied to the data being written
+    Reordering reordering;
+
+    /// Make transfers of all variables defined so far collective, if the file is shared by the
+    /// ranks of an MPI communicator
+    ///
+    /// Called before each partial transfer, because netCDF makes variables independent when they
+    /// are defined, and ExodusII defines some of them lazily.
+    void set_collective_access() const;
+
+    /// Get the elemental variable truth table, the cached one if there is one
+    std::vector<int> elem_var_truth_table() const;
 
 public:
     File();
@@ -88,6 +144,53 @@ public:
     /// @param file_path Path to the file to open
     void append(const fs::path & file_path);
 
+#ifdef EXODUSIICPP_WITH_MPI
+    /// Open/create an ExodusII file shared by all ranks of an MPI communicator
+    ///
+    /// Collective over `comm`. @see open_par
+    ///
+    /// @param file_path Path to the file to open/create
+    /// @param file_access Desired file access
+    /// @param comm Communicator of the ranks sharing the file
+    File(fs::path file_path, exodusIIcpp::FileAccess file_access, MPI_Comm comm);
+
+    /// Open an ExodusII file for reading by all ranks of an MPI communicator
+    ///
+    /// Collective over `comm`. All ranks then have to make the same calls on the file in the same
+    /// order. The partial reads and writes switch the variables to collective access: each rank
+    /// passes its own range, ranks with nothing to transfer pass an empty range. Write the
+    /// elemental variable truth table before the first transfer, so that no elemental variable
+    /// gets defined during a collective write.
+    ///
+    /// @param file_path Path to the file to open
+    /// @param comm Communicator of the ranks sharing the file
+    /// @param info MPI-IO hints
+    void open_par(const fs::path & file_path, MPI_Comm comm, MPI_Info info = MPI_INFO_NULL);
+
+    /// Create an ExodusII file for writing by all ranks of an MPI communicator
+    ///
+    /// The file is stored in the netCDF-4 (HDF5) format. @see open_par
+    ///
+    /// @param file_path Path to the file to create
+    /// @param comm Communicator of the ranks sharing the file
+    /// @param info MPI-IO hints
+    void create_par(const fs::path & file_path, MPI_Comm comm, MPI_Info info = MPI_INFO_NULL);
+
+    /// Open an existing ExodusII file for appending by all ranks of an MPI communicator
+    ///
+    /// @see open_par
+    ///
+    /// @param file_path Path to the file to open
+    /// @param comm Communicator of the ranks sharing the file
+    /// @param info MPI-IO hints
+    void append_par(const fs::path & file_path, MPI_Comm comm, MPI_Info info = MPI_INFO_NULL);
+#endif
+
+    /// Is the file shared by all ranks of an MPI communicator
+    ///
+    /// @return `true` if opened by `open_par`, `create_par` or `append_par`
+    bool is_parallel() const;
+
     /// Is file opened
     ///
     /// @return `true` if opened, `false` otherwise
@@ -168,17 +271,64 @@ public:
     /// @return Array with coordinate names
     const std::vector<std::string> & get_coord_names() const;
 
+    /// Get node ID map
+    ///
+    /// @return Node ID map
+    /// @see read_node_id_map
+    const IdMap & get_node_id_map() const;
+
+    /// Get element ID map
+    ///
+    /// @return Element ID map
+    /// @see read_elem_id_map
+    const IdMap & get_elem_id_map() const;
+
     /// Get element blocks
     ///
     /// @return The list of element blocks
     const std::vector<ElementBlock> & get_element_blocks() const;
 
+    /// Get element block IDs
+    ///
+    /// @return IDs of element blocks, in the order they are stored in the file
+    const std::vector<int> & get_element_block_ids() const;
+
     /// Get an element block
     ///
     /// @param idx Index of the element block: `[0..<number of element blocks>)`
     /// @return The element block at index `idx`
     const ElementBlock & get_element_block(std::size_t idx) const;
 
+    /// Get connectivity of all elements
+    ///
+    /// @return Connectivity of all elements ordered by global element index
+    /// @see read_connectivity
+    const Connectivity & get_connectivity() const;
+
+    /// Get index of an element block
+    ///
+    /// @param block_id Element block ID
+    /// @return Index of the element block: `[0..<number of element blocks>)`
+    std::size_t get_element_block_index(int block_id) const;
+
+    /// Get global index of an element
+    ///
+    /// Elements are numbered consecutively across element blocks in the order the blocks are
+    /// stored in the file. This is done in constant time.
+    ///
+    /// @param block_idx Index of the element block: `[0..<number of element blocks>)`
+    /// @param local_idx Index of the element within the block: `[0..<size of the block>)`
+    /// @return Global (0-based) index of the element
+    int64_t get_global_element_index(std::size_t block_idx, int64_t local_idx) const;
+
+    /// Get element block index and local index of an element
+    ///
+    /// This is done in `O(log <number of element blocks>)` time.
+    ///
+    /// @param global_idx Global (0-based) index of the element
+    /// @return Pair of (element block index, index of the element within the block)
+    std::pair<std::size_t, int64_t> get_local_element_index(int64_t global_idx) const;
+
     /// Get side sets
     ///
     /// @return The list of side sets
@@ -204,6 +354,9 @@ public:
 
     /// Get number of time steps
     ///
+    /// In append mode, the number is cached when the file is opened and kept up to date by
+    /// `write_time` and `append_step`, so no call into the ExodusII library is made.
+    ///
     /// @return Number of time steps
     int get_num_times() const;
 
@@ -214,16 +367,22 @@ public:
 
     /// Get nodal variable names
     ///
+    /// In append mode, the names are cached when the file is opened.
+    ///
     /// @return Nodal variable names
     std::vector<std::string> get_nodal_variable_names() const;
 
     /// Get elemental variable names
     ///
+    /// In append mode, the names are cached when the file is opened.
+    ///
     /// @return Elemental variable names
     std::vector<std::string> get_elemental_variable_names() const;
 
     /// Get global variable names
     ///
+    /// In append mode, the names are cached when the file is opened.
+    ///
     /// @return Global variable names
     std::vector<std::string> get_global_variable_names() const;
 
@@ -234,6 +393,54 @@ public:
     /// @return Vector of nodal values for the given variable
     std::vector<double> get_nodal_variable_values(int time_step, int var_idx) const;
 
+    /// Get nodal variable values at once into a buffer
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_idx Variable index (1-based)
+    /// @param values Nodal values, resized as needed. Reusing the buffer over many calls avoids
+    /// allocating memory for each of them.
+    void get_nodal_variable_values(int time_step, int var_idx, std::vector<double> & values) const;
+
+    /// Get nodal variable values for a contiguous range of nodes
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_idx Variable index (1-based)
+    /// @param start_idx Index of the first node (0-based)
+    /// @param count Number of nodes
+    /// @return Vector of `count` nodal values
+    std::vector<double> get_partial_nodal_variable_values(int time_step,
+                                                          int var_idx,
+                                                          int64_t start_idx,
+                                                          int64_t count) const;
+
+    /// Get elemental variable values for a contiguous range of elements in an element block
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_idx Variable index (1-based)
+    /// @param block_id Block ID
+    /// @param start_idx Index of the first element within the block (0-based)
+    /// @param count Number of elements
+    /// @return Vector of `count` elemental values
+    std::vector<double> get_partial_elemental_variable_values(int time_step,
+                                                              int var_idx,
+                                                              int block_id,
+                                                              int64_t start_idx,
+                                                              int64_t count) const;
+
+    /// Get elemental variable values for a contiguous range of elements across element blocks
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_idx Variable index (1-based)
+    /// @param start_idx Global index of the first element (0-based)
+    /// @param count Number of elements
+    /// @return Vector of `count` elemental values. Values on blocks where the variable is not
+    /// defined are set to NaN.
+    /// @see get_global_element_index
+    std::vector<double> get_partial_elemental_variable_values(int time_step,
+                                                              int var_idx,
+                                                              int64_t start_idx,
+                                                              int64_t count) const;
+
     /// Get elemental variable values for a given block at once
     ///
     /// @param time_step Time step index (1-based)
@@ -243,6 +450,68 @@ public:
     std::vector<double>
     get_elemental_variable_values(int time_step, int var_idx, int block_id) const;
 
+    /// Get elemental variable values for a given block at once into a buffer
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_idx Variable index (1-based)
+    /// @param block_id Block ID
+    /// @param values Elemental values of the block, resized as needed
+    void get_elemental_variable_values(int time_step,
+                                       int var_idx,
+                                       int block_id,
+                                       std::vector<double> & values) const;
+
+    /// Get elemental variable values for all element blocks at once
+    ///
+    /// @param time_step Time step index (1-based)
+    /// @param var_idx Variable index (1-based)
+    /// @return Vector of elemental values indexed by global element index. Values on blocks where
+    /// the variable is not defined are set to NaN.
+    /// @see get_global_element_index
+    std::vector<double> get_elemental_variable_values(int time_step, int var_idx) const;
+
+    /// Get nodal variable values over a range of time steps into a buffer
+    ///
+    /// All time steps are read with a single call. Ranges that cover whole storage chunks avoid
+    /// reading a chunk more than once.
+    ///
+    /// @param var_idx Variable index (1-based)
+    /// @param begin_step First time step (1-based)
+    /// @param end_step Last time step (1-based)
+    /// @param values Nodal values ordered by time step, resized as needed
+    /// @see get_nodal_variable_steps_per_chunk
+    void get_nodal_variable_steps(int var_idx,
+                                  int begin_step,
+                                  int end_step,
+                                  std::vector<double> & values) const;
+
+    /// Get elemental variable values of an element block over a range of time steps into a buffer
+    ///
+    /// @param var_idx Variable index (1-based)
+    /// @param block_id Block ID
+    /// @param begin_step First time step (1-based)
+    /// @param end_step Last time step (1-based)
+    /// @param values Elemental values of the block ordered by time step, resized as needed
+    /// @see get_elemental_variable_steps_per_chunk
+    void get_elemental_variable_steps(int var_idx,
+                                      int block_id,
+                                      int begin_step,
+                                      int end_step,
+                                      std::vector<double> & values) const;
+
+    /// Get the number of time steps stored in one chunk of a nodal variable
+    ///
+    /// @param var_idx Variable index (1-based)
+    /// @return Number of time steps per chunk, 1 if the values are not stored in chunks
+    int get_nodal_variable_steps_per_chunk(int var_idx) const;
+
+    /// Get the number of time steps stored in one chunk of an elemental variable
+    ///
+    /// @param var_idx Variable index (1-based)
+    /// @param block_id Block ID
+    /// @return Number of time steps per chunk, 1 if the values are not stored in chunks
+    int get_elemental_variable_steps_per_chunk(int var_idx, int block_id) const;
+
     /// Get values of global variables for a given time steps
     ///
     /// @param time_step Time step index (1-based)
@@ -258,6 +527,42 @@ public:
     std::vector<double>
     get_global_variable_values(int var_idx, int begin_idx, int end_idx = -1) const;
 
+    /// Compute geometric summary of the mesh
+    ///
+    /// Computes the bounding box of the mesh, and bounding boxes, element centroids and element
+    /// characteristic lengths of each element block in a single pass over the connectivity.
+    /// Coordinates and element blocks must be read before calling this. The elements are split
+    /// into chunks that are summarized by `n_threads` threads. The summary is not stored in the
+    /// file: info records can be written to files opened for writing or appending, but they hold
+    /// short lines of text, too little for the per-element data.
+    ///
+    /// @param n_threads Number of threads
+    /// @return Geometric summary of the mesh
+    /// @see read_coords, read_blocks
+    GeometrySummary compute_geometry_summary(unsigned int n_threads = 1) const;
+
+    /// Compute a fingerprint of the mesh
+    ///
+    /// The fingerprint is an XXH64 digest of the counts, coordinates, element blocks (IDs, element
+    /// types and connectivity), node sets and side sets. The data is read from the file in chunks,
+    /// so nothing has to be read in before calling this. The reads are serial, the chunks are
+    /// hashed by `n_threads` threads and their digests are combined in order, so the fingerprint
+    /// does not depend on the number of threads. Files with identical meshes have the same
+    /// fingerprint.
+    ///
+    /// The ExodusII library is not thread-safe. To fingerprint several files concurrently, pass a
+    /// mutex that serializes all ExodusII calls: it is held for every read, while the chunks are
+    /// hashed outside of it.
+    ///
+    /// @param use_info_record If `true` and the file has a fingerprint stored by
+    /// `write_info_with_fingerprint`, return the stored fingerprint without reading the mesh
+    /// @param n_threads Number of threads
+    /// @param io_mutex Mutex locked around every ExodusII call, or `nullptr`
+    /// @return Fingerprint of the mesh
+    uint64_t mesh_fingerprint(bool use_info_record = true,
+                              unsigned int n_threads = 1,
+                              std::mutex * io_mutex = nullptr) const;
+
     // Read API
 
     /// Read *all* data from the ExodusII file
@@ -272,9 +577,60 @@ public:
     /// Read element map from the ExodusII file
     void read_elem_map();
 
+    /// Read node ID map from the ExodusII file
+    ///
+    /// If the file does not contain a node ID map, the identity map `1..<number of nodes>` is read.
+    void read_node_id_map();
+
+    /// Read element ID map from the ExodusII file
+    ///
+    /// If the file does not contain an element ID map, the identity map
+    /// `1..<number of elements>` is read.
+    void read_elem_id_map();
+
     /// Read element blocks from the ExodusII file
     void read_blocks();
 
+    /// Read element block information without its connectivity
+    ///
+    /// @param block_id Element block ID
+    /// @return Element block with ID, name, element type and sizes set. The connectivity array is
+    /// left empty. @see read_partial_connectivity
+    ElementBlock read_block_info(int block_id) const;
+
+    /// Read connectivity of a contiguous range of elements in an element block
+    ///
+    /// @param block_id Element block ID
+    /// @param start_idx Index of the first element within the block (0-based)
+    /// @param count Number of elements
+    /// @param connect Connectivity of the elements, resized as needed
+    void read_partial_connectivity(int block_id,
+                                   int64_t start_idx,
+                                   int64_t count,
+                                   std::vector<int> & connect) const;
+
+    /// Read coordinates of a contiguous range of nodes
+    ///
+    /// Only the components up to the spatial dimension are read; the others are left empty.
+    ///
+    /// @param start_idx Index of the first node (0-based)
+    /// @param count Number of nodes
+    /// @param x x-coordinates, resized as needed
+    /// @param y y-coordinates, resized as needed
+    /// @param z z-coordinates, resized as needed
+    void read_partial_coords(int64_t start_idx,
+                             int64_t count,
+                             std::vector<double> & x,
+                             std::vector<double> & y,
+                             std::vector<double> & z) const;
+
+    /// Read connectivity of all element blocks into a single CSR array
+    ///
+    /// Connectivity is read directly into the final buffers, no per-block copies are made. Element
+    /// blocks are not populated by this call.
+    /// @see get_connectivity
+    void read_connectivity();
+
     /// Read block names
     ///
     /// @return Map of block ID -> block name
@@ -283,6 +639,17 @@ public:
     /// Read node sets from the ExodusII file
     void read_node_sets();
 
+    /// Read node set IDs
+    ///
+    /// @return IDs of node sets, in the order they are stored in the file
+    std::vector<int> read_node_set_ids() const;
+
+    /// Read a single node set
+    ///
+    /// @param set_id Node set ID
+    /// @return Node set
+    NodeSet read_node_set(int set_id) const;
+
     /// Read node set names
     ///
     /// @return Map of Node set ID -> node set name
@@ -291,35 +658,115 @@ public:
     /// Read side sets from the ExodusII file
     void read_side_sets();
 
+    /// Read side set IDs
+    ///
+    /// @return IDs of side sets, in the order they are stored in the file
+    std::vector<int> read_side_set_ids() const;
+
+    /// Read a single side set
+    ///
+    /// @param set_id Side set ID
+    /// @return Side set
+    SideSet read_side_set(int set_id) const;
+
     /// Read side set names
     ///
     /// @return Map of Side set ID -> side set name
     std::map<int, std::string> read_side_set_names() const;
 
+    /// Read information records
+    ///
+    /// @return List of information records
+    std::vector<std::string> read_info() const;
+
+    /// Read the elemental variable truth table
+    ///
+    /// @return Flags stored row-wise by element block: entry `[blk_idx * n_elem_vars + var_idx]`
+    /// (both 0-based) is nonzero if the variable is defined on the block
+    std::vector<int> read_elem_var_truth_table() const;
+
     /// Read times
     void read_times();
 
     // Write API
 
+    /// Set the reordering applied to the mesh and field data being written
+    ///
+    /// Once set, all write calls take data in the original numbering and store it in the new one.
+    /// Node and element ID maps with the original (1-based) indices are written right away, so the
+    /// original numbering can be recovered from the file. ID maps written later are reordered as
+    /// well. Call after `init` and before writing any mesh or field data. The reordering must be
+    /// computed for the numbers of nodes and elements passed to `init`, otherwise an exception is
+    /// thrown.
+    ///
+    /// @param reordering Reordering to apply
+    void set_reordering(const Reordering & reordering);
+
+    /// Get the reordering applied to the data being written
+    ///
+    /// @return Reordering applied to the data being written
+    const Reordering & get_reordering() const;
+
     /// Write 1-D coordinates to the ExodusII file
     ///
     /// @param x x-coordinates
-    void write_coords(const std::vector<double> & x);
+    void write_coords(Span<const double> x);
+
+    /// Write 1-D coordinates given as a braced list to the ExodusII file
+    ///
+    /// @param x x-coordinates
+    void write_coords(std::initializer_list<double> x);
 
     /// Write 2-D coordinates to the ExodusII file
     ///
     /// @param x x-coordinates
     /// @param y y-coordinates
-    void write_coords(const std::vector<double> & x, const std::vector<double> & y);
+    void write_coords(Span<const double> x, Span<const double> y);
+
+    /// Write 2-D coordinates given as braced lists to the ExodusII file
+    ///
+    /// @param x x-coordinates
+    /// @param y y-coordinates
+    void write_coords(std::initializer_list<double> x, std::initializer_list<double> y);
 
     /// Write 3-D coordinates to the ExodusII file
     ///
     /// @param x x-coordinates
     /// @param y y-coordinates
     /// @param z z-coordinates
-    void write_coords(const std::vector<double> & x,
-                      const std::vector<double> & y,
-                      const std::vector<double> & z);
+    void write_coords(Span<const double> x, Span<const double> y, Span<const double> z);
+
+    /// Write 3-D coordinates given as braced lists to the ExodusII file
+    ///
+    /// @param x x-coordinates
+    /// @param y y-coordinates
+    /// @param z z-coordinates
+    void write_coords(std::initializer_list<double> x,
+                      std::initializer_list<double> y,
+                      std::initializer_list<double> z);
+
+    /// Write coordinates of a contiguous range of nodes to the ExodusII file
+    ///
+    /// @param start_idx Index of the first node (0-based)
+    /// @param x x-coordinates
+    /// @param y y-coordinates (empty for 1D meshes)
+    /// @param z z-coordinates (empty for 1D and 2D meshes)
+    /// @note Not supported when a reordering is set.
+    void write_partial_coords(int64_t start_idx,
+                              Span<const double> x,
+                              Span<const double> y,
+                              Span<const double> z);
+
+    /// Write coordinates of a contiguous range of nodes given as braced lists to the ExodusII file
+    ///
+    /// @param start_idx Index of the first node (0-based)
+    /// @param x x-coordinates
+    /// @param y y-coordinates (empty for 1D meshes)
+    /// @param z z-coordinates (empty for 1D and 2D meshes)
+    void write_partial_coords(int64_t start_idx,
+                              std::initializer_list<double> x,
+                              std::initializer_list<double> y,
+                              std::initializer_list<double> z);
 
     /// Write coordinate names to the ExodusII file
     void write_coord_names();
@@ -334,6 +781,32 @@ public:
     /// @param info List of information records
     void write_info(std::vector<std::string> info);
 
+    /// Write information records with the mesh fingerprint appended
+    ///
+    /// Call this instead of `write_info` after the mesh has been written, so that
+    /// `mesh_fingerprint` does not have to read the mesh.
+    ///
+    /// @param info List of information records
+    void write_info_with_fingerprint(std::vector<std::string> info = {});
+
+    /// Write node ID map to the ExodusII file
+    ///
+    /// @param ids Global node IDs ordered by local node index
+    void write_node_id_map(const std::vector<int64_t> & ids);
+
+    /// Write element ID map to the ExodusII file
+    ///
+    /// @param ids Global element IDs ordered by local element index
+    void write_elem_id_map(const std::vector<int64_t> & ids);
+
+    /// Write Nemesis load balance information to the ExodusII file
+    ///
+    /// Stores the global counts, the internal/border node and element maps and the communication
+    /// maps of a part of a decomposed mesh. Call after `init` and before writing any bulk data.
+    ///
+    /// @param lb Load balance information of the part stored in this file
+    void write_load_balance(const LoadBalance & lb);
+
     /// Write time slice to the ExodusII file
     ///
     /// @param time_step Time step number
@@ -377,11 +850,58 @@ public:
     /// @param n_elems_in_block Number of elements in the block
     /// @param connect Connectivity array ``[el1_n1, el1_n2, ..., el2_n1, el2_n2, ...]``
     /// @note The number of nodes per element is infered from the size of ``connect`` array and the
-    /// number of elements in the block `n_elems_in_block`.
+    /// number of elements in the block `n_elems_in_block`, an exception is thrown if they do not
+    /// match. An empty block has an empty ``connect`` array.
+    void write_block(int64_t blk_id,
+                     const char * elem_type,
+                     int64_t n_elems_in_block,
+                     Span<const int> connect);
+
+    /// Write element block with connectivity given as a braced list to the ExodusII file
+    ///
+    /// @param blk_id Element block index
+    /// @param elem_type Element type
+    /// @param n_elems_in_block Number of elements in the block
+    /// @param connect Connectivity array ``[el1_n1, el1_n2, ..., el2_n1, el2_n2, ...]``
     void write_block(int64_t blk_id,
                      const char * elem_type,
                      int64_t n_elems_in_block,
-                     const std::vector<int> & connect);
+                     std::initializer_list<int> connect);
+
+    /// Define an element block without writing its connectivity
+    ///
+    /// @param blk_id Element block ID
+    /// @param elem_type Element type
+    /// @param n_elems_in_block Number of elements in the block
+    /// @param n_nodes_per_elem Number of nodes per element
+    /// @see write_partial_connectivity
+    void write_block_info(int64_t blk_id,
+                          const char * elem_type,
+                          int64_t n_elems_in_block,
+                          int64_t n_nodes_per_elem);
+
+    /// Write connectivity of a contiguous range of elements of an element block
+    ///
+    /// @param blk_id Element block ID, the block must be defined by `write_block_info`
+    /// @param start_idx Index of the first element within the block (0-based)
+    /// @param count Number of elements
+    /// @param connect Connectivity of the elements
+    /// @note Not supported when a reordering is set.
+    void write_partial_connectivity(int64_t blk_id,
+                                    int64_t start_idx,
+                                    int64_t count,
+                                    Span<const int> connect);
+
+    /// Write connectivity of a contiguous range of elements given as a braced list
+    ///
+    /// @param blk_id Element block ID, the block must be defined by `write_block_info`
+    /// @param start_idx Index of the first element within the block (0-based)
+    /// @param count Number of elements
+    /// @param connect Connectivity of the elements
+    void write_partial_connectivity(int64_t blk_id,
+                                    int64_t start_idx,
+                                    int64_t count,
+                                    std::initializer_list<int> connect);
 
     /// Write nodal variable names to the ExodusII file
     ///
@@ -398,12 +918,69 @@ public:
     /// @param var_names Names of global variables
     void write_global_var_names(const std::vector<std::string> & var_names);
 
+    /// Write the elemental variable truth table to the ExodusII file
+    ///
+    /// Defines all elemental variables at once instead of one by one on their first write, which
+    /// avoids repeatedly re-entering the netCDF define mode. Call after the element blocks and the
+    /// elemental variable names were written.
+    ///
+    /// @param table Truth table laid out as returned by `read_elem_var_truth_table`
+    void write_elem_var_truth_table(const std::vector<int> & table);
+
     /// Write nodal variable values to the ExodusII file
     ///
     /// @param step_num Time step index
     /// @param var_index Variable index
     /// @param values Values to write
-    void write_nodal_var(int step_num, int var_index, const std::vector<double> & values);
+    void write_nodal_var(int step_num, int var_index, Span<const double> values);
+
+    /// Write nodal variable values given as a braced list to the ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param values Values to write
+    void write_nodal_var(int step_num, int var_index, std::initializer_list<double> values);
+
+    /// Write elemental variable values for all element blocks to the ExodusII file
+    ///
+    /// Values on blocks the variable is not defined on according to the truth table written to or
+    /// read from the file are not written, the file has no storage for them. Files without a
+    /// stored truth table accept values on every block.
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param values Values to write indexed by global element index
+    /// @see get_global_element_index
+    void write_elem_var(int step_num, int var_index, Span<const double> values);
+
+    /// Write elemental variable values for all element blocks given as a braced list to the
+    /// ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param values Values to write indexed by global element index
+    void write_elem_var(int step_num, int var_index, std::initializer_list<double> values);
+
+    /// Write elemental variable values for a single element block to the ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param blk_id Element block ID
+    /// @param values Values to write
+    /// @note Not supported when a reordering is set.
+    void write_elem_var(int step_num, int var_index, int64_t blk_id, Span<const double> values);
+
+    /// Write elemental variable values for a single element block given as a braced list to the
+    /// ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param blk_id Element block ID
+    /// @param values Values to write
+    void write_elem_var(int step_num,
+                        int var_index,
+                        int64_t blk_id,
+                        std::initializer_list<double> values);
 
     /// Write nodal variable value to the ExodusII file
     ///
@@ -431,6 +1008,85 @@ public:
                                 int64_t start_index,
                                 double var_value);
 
+    /// Write nodal variable values of a contiguous range of nodes to the ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param start_idx Index of the first node (0-based)
+    /// @param values Values to write
+    /// @note Not supported when a reordering is set.
+    void write_partial_nodal_var_range(int step_num,
+                                       int var_index,
+                                       int64_t start_idx,
+                                       Span<const double> values);
+
+    /// Write nodal variable values of a contiguous range of nodes given as a braced list to the
+    /// ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param start_idx Index of the first node (0-based)
+    /// @param values Values to write
+    void write_partial_nodal_var_range(int step_num,
+                                       int var_index,
+                                       int64_t start_idx,
+                                       std::initializer_list<double> values);
+
+    /// Write elemental variable values of a contiguous range of elements of an element block to the
+    /// ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param blk_id Element block ID
+    /// @param start_idx Index of the first element within the block (0-based)
+    /// @param values Values to write
+    /// @note Not supported when a reordering is set.
+    void write_partial_elem_var_range(int step_num,
+                                      int var_index,
+                                      int64_t blk_id,
+                                      int64_t start_idx,
+                                      Span<const double> values);
+
+    /// Write elemental variable values of a contiguous range of elements of an element block given
+    /// as a braced list to the ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param blk_id Element block ID
+    /// @param start_idx Index of the first element within the block (0-based)
+    /// @param values Values to write
+    void write_partial_elem_var_range(int step_num,
+                                      int var_index,
+                                      int64_t blk_id,
+                                      int64_t start_idx,
+                                      std::initializer_list<double> values);
+
+    /// Write elemental variable values of a contiguous range of elements across element blocks to
+    /// the ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param start_idx Global index of the first element (0-based)
+    /// @param values Values to write
+    /// @note Not supported when a reordering is set.
+    /// @see get_global_element_index
+    void write_partial_elem_var_range(int step_num,
+                                      int var_index,
+                                      int64_t start_idx,
+                                      Span<const double> values);
+
+    /// Write elemental variable values of a contiguous range of elements across element blocks
+    /// given as a braced list to the ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param var_index Variable index
+    /// @param start_idx Global index of the first element (0-based)
+    /// @param values Values to write
+    void write_partial_elem_var_range(int step_num,
+                                      int var_index,
+                                      int64_t start_idx,
+                                      std::initializer_list<double> values);
+
     /// Write global variable value to the ExodusII file
     ///
     /// @param step_num Time step index
@@ -438,6 +1094,37 @@ public:
     /// @param value Value to write
     void write_global_var(int step_num, int var_index, double value);
 
+    /// Write values of all global variables to the ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param values Values of all global variables, ordered by variable index
+    void write_global_vars(int step_num, Span<const double> values);
+
+    /// Write values of all global variables given as a braced list to the ExodusII file
+    ///
+    /// @param step_num Time step index
+    /// @param values Values of all global variables, ordered by variable index
+    void write_global_vars(int step_num, std::initializer_list<double> values);
+
+    /// Append a whole time step to a file opened in append mode
+    ///
+    /// Writes the time and the values of all variables as the next time step. The number of time
+    /// steps, the variable names and the elemental variable truth table cached when the file was
+    /// opened are used, so no metadata is read back from the file. Elemental variables are written
+    /// only on the blocks the stored truth table defines them on, see `write_elem_var`. The step
+    /// is written by a `StepWriter`. Call `update` to flush the step to disk.
+    ///
+    /// @param time Time of the new time step
+    /// @param nodal Values of each nodal variable, ordered by variable index; one value per node
+    /// @param elemental Values of each elemental variable, ordered by variable index; one value
+    /// per element, ordered by global element index
+    /// @param global Values of all global variables, ordered by variable index
+    /// @return Index of the new time step
+    int append_step(double time,
+                    const std::vector<Span<const double>> & nodal,
+                    const std::vector<Span<const double>> & elemental,
+                    Span<const double> global);
+
     /// Update the file
     ///
     /// Call after the time step data were all saved
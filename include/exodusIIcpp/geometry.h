@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+namespace exodusIIcpp {
+
+/// Axis-aligned bounding box
+///
+/// Unused dimensions (for 1D and 2D meshes) have both bounds set to zero.
+struct BoundingBox {
+    /// Lower bounds in x, y and z
+    std::array<double, 3> min;
+    /// Upper bounds in x, y and z
+    std::array<double, 3> max;
+};
+
+/// Geometric statistics of an element block
+struct BlockGeometry {
+    /// Element block ID
+    int block_id;
+    /// Bounding box of the nodes referenced by the block
+    BoundingBox bbox;
+    /// Element centroids `[x0, y0, z0, x1, y1, z1, ...]`, empty for blocks whose elements have no
+    /// nodes
+    std::vector<double> centroids;
+    /// Characteristic length of each element, i.e. the length of the diagonal of its bounding box
+    std::vector<double> char_lengths;
+    /// Smallest characteristic length in the block
+    double min_char_length;
+    /// Largest characteristic length in the block
+    double max_char_length;
+};
+
+/// Geometric summary of a mesh
+struct GeometrySummary {
+    /// Bounding box of all nodes
+    BoundingBox bbox;
+    /// Statistics of element blocks in the order they are stored in the file
+    std::vector<BlockGeometry> blocks;
+};
+
+} // namespace exodusIIcpp
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace exodusIIcpp {
+
+/// ID map
+///
+/// Maps local (0-based) indices of nodes or elements to their global IDs and back. The reverse
+/// lookup uses a dense array when the IDs are compact and an open-addressing hash table otherwise,
+/// so both directions are `O(1)`.
+class IdMap {
+protected:
+    /// Global IDs, `ids[i]` is the global ID of the local entity `i`
+    std::vector<int64_t> ids;
+    /// Smallest global ID (dense reverse lookup)
+    int64_t min_id;
+    /// Dense reverse lookup: `dense[id - min_id]` is the local index or -1
+    std::vector<int64_t> dense;
+    /// Hash table keys (sparse reverse lookup)
+    std::vector<int64_t> hash_keys;
+    /// Hash table values, -1 marks an empty slot (sparse reverse lookup)
+    std::vector<int64_t> hash_values;
+
+    /// Build the reverse lookup structure
+    void build_reverse_lookup();
+
+public:
+    IdMap();
+
+    /// Get the number of entries in the map
+    ///
+    /// @return The number of entries in the map
+    std::size_t get_size() const;
+
+    /// Get global ID of an entity
+    ///
+    /// @param idx Local index of the entity. Can be `0..<size of the map>`.
+    /// @return Global ID
+    int64_t get_id(std::size_t idx) const;
+
+    /// Get local index of an entity
+    ///
+    /// @param id Global ID of the entity
+    /// @return Local (0-based) index of the entity or -1 if the ID is not in the map
+    int64_t get_index(int64_t id) const;
+
+    /// Get all global IDs
+    ///
+    /// @return Global IDs ordered by local index
+    const std::vector<int64_t> & get_ids() const;
+
+    /// Set global IDs
+    ///
+    /// @param ids Global IDs ordered by local index. IDs must be unique.
+    void set_ids(const std::vector<int64_t> & ids);
+};
+
+} // namespace exodusIIcpp
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace exodusIIcpp {
+
+/// Communication map of a part of a decomposed mesh
+///
+/// Lists the nodes or element sides of a part that are shared with another part.
+struct CommMap {
+    /// Map ID
+    int id;
+    /// Local (1-based) node or element IDs
+    std::vector<int> ids;
+    /// Local side numbers, used by elemental communication maps only
+    std::vector<int> sides;
+    /// Parts (0-based) the nodes or element sides are shared with
+    std::vector<int> procs;
+};
+
+/// Nemesis load balance information of a part of a decomposed mesh
+struct LoadBalance {
+    /// Number of parts
+    int n_parts;
+    /// Part (0-based) stored in the file
+    int part;
+    /// Number of nodes in the whole mesh
+    int64_t n_global_nodes;
+    /// Number of elements in the whole mesh
+    int64_t n_global_elems;
+    /// IDs of the element blocks of the whole mesh
+    std::vector<int> global_blk_ids;
+    /// Number of elements in each element block of the whole mesh
+    std::vector<int> global_blk_counts;
+    /// IDs of the node sets of the whole mesh
+    std::vector<int> global_ns_ids;
+    /// Number of nodes in each node set of the whole mesh
+    std::vector<int> global_ns_counts;
+    /// IDs of the side sets of the whole mesh
+    std::vector<int> global_ss_ids;
+    /// Number of sides in each side set of the whole mesh
+    std::vector<int> global_ss_counts;
+    /// Local (1-based) IDs of nodes used by this part only
+    std::vector<int> internal_nodes;
+    /// Local (1-based) IDs of nodes shared with other parts
+    std::vector<int> border_nodes;
+    /// Local (1-based) IDs of elements with no node shared with other parts
+    std::vector<int> internal_elems;
+    /// Local (1-based) IDs of elements with a node shared with other parts
+    std::vector<int> border_elems;
+    /// Nodal communication maps, one per neighboring part
+    std::vector<CommMap> node_cmaps;
+    /// Elemental communication maps, one per neighboring part
+    std::vector<CommMap> elem_cmaps;
+};
+
+} // namespace exodusIIcpp
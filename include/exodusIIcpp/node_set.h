@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -19,6 +20,28 @@ protected:
     int id;
     /// Node IDs
     std::vector<int> node_ids;
+    /// Indicates if the membership index was built
+    mutable bool indexed;
+    /// Sorted unique node IDs (part of the membership index)
+    mutable std::vector<int> sorted_ids;
+    /// Membership bits for dense node sets (part of the membership index). Bit `b` of word `w`
+    /// represents node ID `64 * (first_word + w) + b`. Empty for sparse node sets.
+    mutable std::vector<uint64_t> bits;
+    /// Index of the first word in `bits`
+    mutable int64_t first_word;
+
+    /// Build the membership index
+    void build_index() const;
+
+    /// Set operations
+    enum class Operation { UNION, INTERSECTION, DIFFERENCE };
+
+    /// Combine this node set with another node set
+    ///
+    /// @param other The other node set
+    /// @param op Set operation to perform
+    /// @return Node set with sorted node IDs
+    NodeSet combine(const NodeSet & other, Operation op) const;
 
 public:
     NodeSet();
@@ -64,6 +87,41 @@ public:
     ///
     /// @param nodes List of node IDs that will comprise the node set
     void set_nodes(const std::vector<int> & nodes);
+
+    /// Check if a node is in the node set
+    ///
+    /// The first call builds a membership index (a sorted array, plus a bitset if the node IDs are
+    /// dense enough), so the lookups are `O(log n)` or `O(1)`.
+    ///
+    /// @param node_id Node ID
+    /// @return `true` if the node is in the node set, `false` otherwise
+    /// @note Building the index is not thread-safe. Call `contains` once before sharing the node
+    /// set between threads.
+    bool contains(int node_id) const;
+
+    /// Compute union of this node set and another node set
+    ///
+    /// The result has no ID (-1) and no name, set them before writing it.
+    ///
+    /// @param other The other node set
+    /// @return Node set with sorted node IDs contained in either of the node sets
+    NodeSet union_with(const NodeSet & other) const;
+
+    /// Compute intersection of this node set and another node set
+    ///
+    /// The result has no ID (-1) and no name, set them before writing it.
+    ///
+    /// @param other The other node set
+    /// @return Node set with sorted node IDs contained in both node sets
+    NodeSet intersection_with(const NodeSet & other) const;
+
+    /// Compute difference of this node set and another node set
+    ///
+    /// The result has no ID (-1) and no name, set them before writing it.
+    ///
+    /// @param other The other node set
+    /// @return Node set with sorted node IDs contained in this node set but not in `other`
+    NodeSet difference_with(const NodeSet & other) const;
 };
 
 } // namespace exodusIIcpp
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "exodusIIcpp/spatial_index.h"
+
+namespace exodusIIcpp {
+
+class File;
+
+/// Interpolation of nodal variables at arbitrary points
+///
+/// Points are located once, when the probe is constructed. Nodes of the elements containing the
+/// points are grouped into contiguous ranges, so that interpolation reads only those ranges from
+/// the file instead of whole fields.
+///
+/// Values are interpolated with linear shape functions. Higher-order elements are interpolated
+/// using their corner nodes only, their mid-side and interior nodes are ignored.
+class Probe {
+protected:
+    /// Location of each probe point
+    std::vector<PointLocation> locations;
+    /// Ranges of nodes to read, (start, count) pairs
+    std::vector<std::pair<int64_t, int64_t>> node_ranges;
+    /// Offsets into `buffer_idx` and `weights` for each point
+    std::vector<int64_t> point_ofst;
+    /// Position of the contributing nodes in the concatenated node ranges
+    std::vector<int64_t> buffer_idx;
+    /// Shape function values of the contributing nodes
+    std::vector<double> weights;
+
+public:
+    /// Build a probe
+    ///
+    /// @param file File with coordinates and element blocks read in
+    /// @param index Spatial index built over `file`
+    /// @param points Probe points
+    Probe(const File & file,
+          const SpatialIndex & index,
+          const std::vector<std::array<double, 3>> & points);
+
+    /// Get the number of probe points
+    ///
+    /// @return Number of probe points
+    std::size_t get_num_points() const;
+
+    /// Get the location of the probe points
+    ///
+    /// @return Location of each probe point
+    const std::vector<PointLocation> & get_locations() const;
+
+    /// Get the ranges of nodes that are read during interpolation
+    ///
+    /// @return (first node index (0-based), number of nodes) pairs
+    const std::vector<std::pair<int64_t, int64_t>> & get_node_ranges() const;
+
+    /// Interpolate a nodal variable at the probe points
+    ///
+    /// @param file File the probe was built for
+    /// @param var_idx Nodal variable index (1-based)
+    /// @param time_steps Time step indices (1-based)
+    /// @return Interpolated values indexed by `[time step][point]`. Values at points outside of the
+    /// mesh are set to NaN.
+    std::vector<std::vector<double>>
+    interpolate(const File & file, int var_idx, const std::vector<int> & time_steps) const;
+};
+
+} // namespace exodusIIcpp
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "exodusIIcpp/element_block.h"
+#include "exodusIIcpp/span.h"
+
+namespace exodusIIcpp {
+
+/// Methods for computing a mesh reordering
+/* clang-format off */
+enum class ReorderingMethod {
+    /// Reverse Cuthill-McKee ordering of the node graph
+    RCM,
+    /// Hilbert space-filling curve
+    HILBERT,
+    /// Morton (Z-order) space-filling curve
+    MORTON
+};
+/* clang-format on */
+
+/// Permutation of nodes and elements that improves memory locality
+///
+/// Nodes are reordered globally. Elements are reordered within their element block, so blocks stay
+/// contiguous. With `RCM`, elements are sorted by the lowest new index of their nodes; with the
+/// space-filling curves, elements are sorted by the curve position of their centroid.
+///
+/// Indices are 0-based, element indices are global across element blocks.
+class Reordering {
+protected:
+    /// New node index -> original node index
+    std::vector<int64_t> node_order;
+    /// Original node index -> new node index
+    std::vector<int64_t> node_index;
+    /// New element index -> original element index
+    std::vector<int64_t> elem_order;
+    /// Original element index -> new element index
+    std::vector<int64_t> elem_index;
+    /// Prefix sum of element block sizes
+    std::vector<int64_t> blk_elem_ofst;
+
+    /// Gather `values` in the order given by `order`
+    template <typename T>
+    static std::vector<T>
+    permute(const std::vector<int64_t> & order, Span<const T> values)
+    {
+        std::vector<T> result(order.size());
+        for (std::size_t i = 0; i < order.size(); i++)
+            result[i] = values[order[i]];
+        return result;
+    }
+
+public:
+    /// Identity reordering
+    Reordering();
+
+    /// Compute a reordering
+    ///
+    /// @param method Reordering method
+    /// @param x x-coordinates
+    /// @param y y-coordinates (empty for 1D meshes)
+    /// @param z z-coordinates (empty for 1D and 2D meshes)
+    /// @param blocks Element blocks, in the order they will be written
+    Reordering(ReorderingMethod method,
+               const std::vector<double> & x,
+               const std::vector<double> & y,
+               const std::vector<double> & z,
+               const std::vector<ElementBlock> & blocks);
+
+    /// Check if this is the identity reordering
+    ///
+    /// @return `true` if no reordering is applied, `false` otherwise
+    bool empty() const;
+
+    /// Get the number of nodes
+    ///
+    /// @return Number of nodes
+    int64_t get_num_nodes() const;
+
+    /// Get the number of elements
+    ///
+    /// @return Number of elements
+    int64_t get_num_elements() const;
+
+    /// Get the new order of nodes
+    ///
+    /// @return Original node indices in the new order
+    const std::vector<int64_t> & get_node_order() const;
+
+    /// Get the new index of each node
+    ///
+    /// @return New node indices in the original order
+    const std::vector<int64_t> & get_node_index() const;
+
+    /// Get the new order of elements
+    ///
+    /// @return Original element indices in the new order
+    const std::vector<int64_t> & get_elem_order() const;
+
+    /// Get the new index of each element
+    ///
+    /// @return New element indices in the original order
+    const std::vector<int64_t> & get_elem_index() const;
+
+    /// Get the prefix sum of element block sizes
+    ///
+    /// @return Elements of the block at index `i` have indices `[ofst[i], ofst[i + 1])`
+    const std::vector<int64_t> & get_block_offsets() const;
+
+    /// Permute node values into the new order
+    ///
+    /// @param values Values in the original node order
+    /// @return Values in the new node order
+    template <typename T>
+    std::vector<T>
+    permute_nodal(const std::vector<T> & values) const
+    {
+        return permute(this->node_order, Span<const T>(values));
+    }
+
+    /// Permute nodal values into the new order
+    ///
+    /// @param values Values in the original node order
+    /// @return Values in the new node order
+    template <typename T>
+    std::vector<T>
+    permute_nodal(Span<const T> values) const
+    {
+        return permute(this->node_order, values);
+    }
+
+    /// Permute element values into the new order
+    ///
+    /// @param values Values in the original element order
+    /// @return Values in the new element order
+    template <typename T>
+    std::vector<T>
+    permute_elemental(const std::vector<T> & values) const
+    {
+        return permute(this->elem_order, Span<const T>(values));
+    }
+
+    /// Permute element values into the new order
+    ///
+    /// @param values Values in the original element order
+    /// @return Values in the new element order
+    template <typename T>
+    std::vector<T>
+    permute_elemental(Span<const T> values) const
+    {
+        return permute(this->elem_order, values);
+    }
+};
+
+} // namespace exodusIIcpp
@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <vector>
+#include "exodusIIcpp/element_block.h"
+#include "exodusIIcpp/side_set.h"
+
+namespace exodusIIcpp {
+
+/// Extract the exterior surface (skin) of a mesh
+///
+/// Sides that are referenced by exactly one element are exterior. Sides are matched by their
+/// sorted corner nodes, so higher-order elements are supported as well. The elements are split
+/// into `n_threads` contiguous ranges that are matched concurrently, then the sides left open in
+/// each range are matched against each other, also concurrently. The result does not depend on
+/// the number of threads.
+///
+/// @param blocks Element blocks that comprise the mesh, in the order they are stored in the file
+/// @param n_threads Number of threads
+/// @return Side set with (element ID, local side number) pairs of all exterior sides. Element IDs
+/// are 1-based and global across `blocks`, side numbers follow the ExodusII convention.
+SideSet skin(const std::vector<ElementBlock> & blocks, unsigned int n_threads = 1);
+
+/// Extract the exterior surface (skin) of a mesh and build a surface element block
+///
+/// @param blocks Element blocks that comprise the mesh, in the order they are stored in the file
+/// @param surface Element block that will receive the exterior sides as linear elements
+/// (`BAR2`, `TRI3` or `QUAD4`) ordered the same way as the returned side set. Sides are oriented
+/// with their normals pointing outwards.
+/// @param n_threads Number of threads
+/// @return Side set with (element ID, local side number) pairs of all exterior sides
+/// @note All exterior sides must have the same shape, otherwise an exception is thrown.
+SideSet skin(const std::vector<ElementBlock> & blocks,
+             ElementBlock & surface,
+             unsigned int n_threads = 1);
+
+} // namespace exodusIIcpp
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace exodusIIcpp {
+
+/// Non-owning view of a contiguous sequence of values
+///
+/// The viewed memory must outlive the span. There is no constructor from a braced list, whose
+/// values live only until the end of the full expression; functions that use the values before
+/// returning have overloads taking a `std::initializer_list` instead.
+template <typename T>
+class Span {
+public:
+    using value_type = std::remove_cv_t<T>;
+
+    Span() : ptr(nullptr), n(0) {}
+
+    /// Create a span from a pointer and a number of values
+    ///
+    /// @param data Pointer to the first value
+    /// @param size Number of values
+    Span(T * data, std::size_t size) : ptr(data), n(size) {}
+
+    /// Create a span viewing the contents of a vector
+    ///
+    /// @param vec Vector to view
+    Span(std::vector<value_type> & vec) : ptr(vec.data()), n(vec.size()) {}
+
+    /// Create a read-only span viewing the contents of a vector
+    ///
+    /// @param vec Vector to view
+    template <typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+    Span(const std::vector<value_type> & vec) : ptr(vec.data()), n(vec.size())
+    {
+    }
+
+    /// Get pointer to the first value
+    ///
+    /// @return Pointer to the first value
+    T *
+    data() const
+    {
+        return this->ptr;
+    }
+
+    /// Get the number of values
+    ///
+    /// @return The number of values
+    std::size_t
+    size() const
+    {
+        return this->n;
+    }
+
+    /// Check if the span is empty
+    ///
+    /// @return `true` if the span has no values, `false` otherwise
+    bool
+    empty() const
+    {
+        return this->n == 0;
+    }
+
+    T &
+    operator[](std::size_t idx) const
+    {
+        return this->ptr[idx];
+    }
+
+    T *
+    begin() const
+    {
+        return this->ptr;
+    }
+
+    T *
+    end() const
+    {
+        return this->ptr + this->n;
+    }
+
+private:
+    /// Pointer to the first value
+    T * ptr;
+    /// Number of values
+    std::size_t n;
+};
+
+} // namespace exodusIIcpp
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace exodusIIcpp {
+
+class File;
+
+/// Location of a point in a mesh
+struct PointLocation {
+    /// Index of the element block containing the point, -1 if the point is outside of the mesh
+    int block_idx;
+    /// ID of the element block containing the point, -1 if the point is outside of the mesh
+    int block_id;
+    /// Index of the element within the element block, -1 if the point is outside of the mesh
+    int64_t elem_idx;
+    /// Parametric coordinates of the point within the element
+    std::array<double, 3> xi;
+};
+
+/// Spatial index over the elements and nodes of a mesh
+///
+/// The index is a bounding volume hierarchy (BVH) stored as a flat array. Corner coordinates of
+/// the elements are copied next to each other in the order of the leaves, so that a query touches
+/// contiguous memory.
+///
+/// Point location supports `BAR`, `TRI`, `QUAD`, `TET` and `HEX` elements whose dimension matches
+/// the mesh dimension. Higher-order elements are located using their corner nodes. Parametric
+/// coordinates are in `[-1, 1]` for `BAR`, `QUAD` and `HEX` elements. For `TRI` and `TET` elements
+/// they are the reference coordinates `(r, s)` and `(r, s, t)` of the unit triangle and unit
+/// tetrahedron, i.e. non-negative with `r + s (+ t) <= 1`.
+class SpatialIndex {
+protected:
+    /// Node of the bounding volume hierarchy
+    struct TreeNode {
+        /// Lower bounds of the bounding box
+        double min[3];
+        /// Upper bounds of the bounding box
+        double max[3];
+        /// Leaves: index of the first item, inner nodes: index of the left child. The right child
+        /// directly follows the left one.
+        int64_t offset;
+        /// Number of items in a leaf, 0 for inner nodes
+        int64_t count;
+    };
+
+    /// Compute the bounding box of items `order[begin..end)` and split them
+    ///
+    /// @param bounds Bounding boxes of the items, `[min_x, min_y, min_z, max_x, max_y, max_z, ...]`
+    /// @param order Order of the items, partitioned around the split position
+    /// @param begin First item
+    /// @param end End item
+    /// @param nd Tree node with the bounding box of the items. If the items form a leaf, it is the
+    /// leaf.
+    /// @return Position of the median split along the longest axis of the centroid bounds, -1 if
+    /// the items form a leaf
+    static int64_t split_items(const std::vector<double> & bounds,
+                               std::vector<int64_t> & order,
+                               int64_t begin,
+                               int64_t end,
+                               TreeNode & nd);
+
+    /// Build a bounding volume hierarchy
+    ///
+    /// The top of the tree is built by the calling thread, the subtrees below it are built by
+    /// `n_threads` threads and then spliced in.
+    ///
+    /// @param bounds Bounding boxes of the items, `[min_x, min_y, min_z, max_x, max_y, max_z, ...]`
+    /// @param tree Resulting tree
+    /// @param order Resulting order of the items in the leaves
+    /// @param n_threads Number of threads
+    static void build_tree(const std::vector<double> & bounds,
+                           std::vector<TreeNode> & tree,
+                           std::vector<int64_t> & order,
+                           unsigned int n_threads);
+
+    /// Spatial dimension
+    int dim;
+    /// Element hierarchy
+    std::vector<TreeNode> elem_tree;
+    /// Element block index of each element, in leaf order
+    std::vector<int> elem_block_idx;
+    /// Element block ID of each element, in leaf order
+    std::vector<int> elem_block_id;
+    /// Index of each element within its block, in leaf order
+    std::vector<int64_t> elem_local_idx;
+    /// Shape of each element, in leaf order
+    std::vector<int> elem_shape;
+    /// Offsets into `elem_coords`, in leaf order
+    std::vector<int64_t> elem_coord_ofst;
+    /// Corner coordinates of the elements, `[x0, y0, z0, x1, y1, z1, ...]`, in leaf order
+    std::vector<double> elem_coords;
+    /// Node hierarchy
+    std::vector<TreeNode> node_tree;
+    /// Node IDs, in leaf order
+    std::vector<int> node_ids;
+    /// Node coordinates, `[x0, y0, z0, x1, y1, z1, ...]`, in leaf order
+    std::vector<double> node_coords;
+
+public:
+    /// Build the spatial index
+    ///
+    /// The index is built in memory by `n_threads` threads, no ExodusII calls are made.
+    ///
+    /// @param file File with coordinates and element blocks read in
+    /// @param n_threads Number of threads
+    /// @see File::read_coords, File::read_blocks
+    explicit SpatialIndex(const File & file, unsigned int n_threads = 1);
+
+    /// Get the spatial dimension of the indexed mesh
+    ///
+    /// @return Spatial dimension
+    int get_dim() const;
+
+    /// Locate points in the mesh
+    ///
+    /// @param points Points to locate. Components beyond the mesh dimension are ignored.
+    /// @param n_threads Number of threads the points are split among
+    /// @return Location of each point. If a point lies on a boundary shared by several elements,
+    /// any one of them is returned.
+    std::vector<PointLocation> locate(const std::vector<std::array<double, 3>> & points,
+                                      unsigned int n_threads = 1) const;
+
+    /// Find nearest nodes
+    ///
+    /// @param points Query points. Components beyond the mesh dimension are ignored.
+    /// @param n_threads Number of threads the points are split among
+    /// @return ID (1-based) of the node nearest to each point, -1 if the mesh has no nodes
+    std::vector<int> find_nearest_nodes(const std::vector<std::array<double, 3>> & points,
+                                        unsigned int n_threads = 1) const;
+};
+
+} // namespace exodusIIcpp
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include "exodusIIcpp/span.h"
+
+namespace exodusIIcpp {
+
+class File;
+
+/// Writer of whole time steps
+///
+/// Collects the values of the variables of a time step as views of the caller's buffers, no copy
+/// is made, and writes them all at once in the order the variables are laid out in the file: the
+/// time, all global variables with a single call, nodal variables by index, then elemental
+/// variables by index, with single-block values ordered by element block. The buffers must stay
+/// alive until the last `write`. Variables that were not added are not written.
+class StepWriter {
+protected:
+    /// File the time steps are written to
+    File & file;
+    /// Values of all global variables
+    Span<const double> global_values;
+    /// Nodal values by variable index
+    std::map<int, Span<const double>> nodal_values;
+    /// Elemental values of all element blocks by variable index
+    std::map<int, Span<const double>> elem_values;
+    /// Elemental values of single element blocks by (block index, variable index)
+    std::map<std::pair<std::size_t, int>, Span<const double>> blk_elem_values;
+
+public:
+    /// Create a writer
+    ///
+    /// @param file File opened for writing or appending, with element blocks written or read
+    explicit StepWriter(File & file);
+
+    /// Add the values of all global variables
+    ///
+    /// @param values Values ordered by variable index
+    void add_global_vars(Span<const double> values);
+
+    /// Add the values of a nodal variable
+    ///
+    /// @param var_index Variable index
+    /// @param values Values, one per node
+    void add_nodal_var(int var_index, Span<const double> values);
+
+    /// Add the values of an elemental variable on all element blocks
+    ///
+    /// @param var_index Variable index
+    /// @param values Values indexed by global element index
+    void add_elem_var(int var_index, Span<const double> values);
+
+    /// Add the values of an elemental variable on one element block
+    ///
+    /// @param var_index Variable index
+    /// @param blk_id Element block ID
+    /// @param values Values of the elements in the block
+    void add_elem_var(int var_index, int64_t blk_id, Span<const double> values);
+
+    /// Temporaries cannot be added, they would be gone before `write`
+    void add_global_vars(std::vector<double> && values) = delete;
+    void add_nodal_var(int var_index, std::vector<double> && values) = delete;
+    void add_elem_var(int var_index, std::vector<double> && values) = delete;
+    void add_elem_var(int var_index, int64_t blk_id, std::vector<double> && values) = delete;
+
+    /// Write the collected values as a time step
+    ///
+    /// The collected values are kept, so the same buffers can be refilled and written as the next
+    /// time step.
+    ///
+    /// @param step_num Time step index
+    /// @param time Time of the time step
+    void write(int step_num, double time) const;
+
+    /// Forget all collected values
+    void clear();
+};
+
+} // namespace exodusIIcpp
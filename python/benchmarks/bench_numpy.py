@@ -0,0 +1,63 @@
+# SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+# SPDX-License-Identifier: MIT
+
+"""Measure the cost of moving bulk mesh data between exodusIIcpp and NumPy.
+
+Usage: python bench_numpy.py [--nodes N] [--file PATH]
+"""
+
+import argparse
+import os
+import tempfile
+import time
+
+import exodusIIcpp
+import numpy as np
+
+
+def timed(label, fn):
+    start = time.perf_counter()
+    result = fn()
+    print(f"{label:<32} {time.perf_counter() - start:8.3f} s")
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--nodes", type=int, default=5_000_000, help="number of nodes")
+    parser.add_argument("--file", help="ExodusII file to write (temporary file by default)")
+    args = parser.parse_args()
+
+    n_nodes = args.nodes
+    n_elems = n_nodes - 1
+    x = np.linspace(0.0, 1.0, n_nodes)
+    connect = np.empty(2 * n_elems, dtype=np.int32)
+    connect[0::2] = np.arange(1, n_nodes)
+    connect[1::2] = np.arange(2, n_nodes + 1)
+    u = np.sin(x)
+
+    path = args.file or os.path.join(tempfile.mkdtemp(), "bench.e")
+    f = exodusIIcpp.File(path, exodusIIcpp.FileAccess.WRITE)
+    f.init("bench", 1, n_nodes, n_elems, 1, 0, 0)
+    timed("write_coords", lambda: f.write_coords(x))
+    timed("write_block", lambda: f.write_block(1, "BAR2", n_elems, connect))
+    f.write_time(1, 0.0)
+    f.write_nodal_var_names(["u"])
+    timed("write_nodal_var", lambda: f.write_nodal_var(1, 1, u))
+    f.close()
+
+    g = exodusIIcpp.File(path, exodusIIcpp.FileAccess.READ)
+    timed("read_coords", g.read_coords)
+    timed("read_blocks", g.read_blocks)
+    gx = timed("get_x_coords", g.get_x_coords)
+    conn = timed("get_connectivity", lambda: g.get_element_block(0).get_connectivity())
+    vals = timed("get_nodal_variable_values", lambda: g.get_nodal_variable_values(1, 1))
+    g.close()
+
+    assert np.array_equal(gx, x)
+    assert np.array_equal(conn, connect)
+    assert np.allclose(vals, u)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,7 +1,11 @@
 // SPDX-FileCopyrightText: 2025 David Andrs <andrsd@gmail.com>
 // SPDX-License-Identifier: MIT
 
+#include <map>
+#include <mutex>
+#include <stdexcept>
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 #include <pybind11/stl/filesystem.h>
 #include "exodusIIcpp/exodusIIcpp.h"
@@ -11,6 +15,183 @@ using namespace exodusIIcpp;
 
 namespace py = pybind11;
 
+/// Serializes calls into the ExodusII library, which is not thread-safe (neither are netCDF and
+/// HDF5 unless built so)
+static std::mutex io_mutex;
+
+/// Holds `io_mutex` for its lifetime
+struct IoLock {
+    IoLock() { io_mutex.lock(); }
+    ~IoLock() { io_mutex.unlock(); }
+};
+
+/// Call guard for functions that touch the disk or read the storage of a `File`
+///
+/// Holding the I/O lock also keeps a concurrent `File.read` from reallocating the coordinates or
+/// blocks while a geometry query runs over them.
+/// The GIL is released before the I/O lock is taken (and re-acquired after it is released), so
+/// other Python threads keep running while a thread waits for the lock or for the disk.
+using IoGuard = py::call_guard<py::gil_scoped_release, IoLock>;
+
+/// Run `fn` with the GIL released and the I/O lock held
+///
+/// `fn` must not touch Python objects. Its result is returned after the GIL is re-acquired, so it
+/// can be converted into Python objects safely.
+template <typename F>
+static auto
+release_gil(F && fn)
+{
+    py::gil_scoped_release release;
+    IoLock lock;
+    return fn();
+}
+
+/// Deleter that closes files under the I/O lock, so a garbage-collected object does not call into
+/// the ExodusII library while another thread does
+template <typename T>
+struct LockedDelete {
+    void
+    operator()(T * obj) const
+    {
+        IoLock lock;
+        delete obj;
+    }
+};
+
+template <typename T>
+using InArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/// Number of live NumPy views and references into each object, by the address of the object
+///
+/// Keeping the owner of a view alive does not keep the viewed storage alive: a method that
+/// reallocates it would leave the view dangling. Such methods refuse to run while the object has
+/// views, see `check_no_views`. Methods run with the GIL released, so the counts have their own
+/// mutex.
+static std::map<const void *, std::size_t> n_views;
+static std::mutex n_views_mutex;
+
+/// Count `view` as a view of `obj` until `view` is garbage collected
+static void
+track_view(const void * obj, py::handle view)
+{
+    {
+        std::lock_guard<std::mutex> lock(n_views_mutex);
+        n_views[obj]++;
+    }
+    py::cpp_function release([obj](py::handle weakref) {
+        {
+            std::lock_guard<std::mutex> lock(n_views_mutex);
+            if (--n_views[obj] == 0)
+                n_views.erase(obj);
+        }
+        weakref.dec_ref();
+    });
+    py::weakref(view, release).release();
+}
+
+/// Throw if `obj` has live views, whose storage a change of `obj` could free
+static void
+check_no_views(const void * obj)
+{
+    std::lock_guard<std::mutex> lock(n_views_mutex);
+    if (n_views.count(obj) > 0)
+        throw std::runtime_error("Object has live NumPy views or references into it. Delete them "
+                                 "or copy the arrays before modifying the object.");
+}
+
+/// Bind a method that reallocates storage that may be viewed, it refuses to run while there are
+/// views
+template <typename C, typename... Args>
+static auto
+mutator(void (C::*method)(Args...))
+{
+    return [method](C & self, Args... args) {
+        check_no_views(&self);
+        (self.*method)(std::forward<Args>(args)...);
+    };
+}
+
+/// Create a read-only NumPy array viewing the contents of a vector, no copy is made
+///
+/// @param vec Vector to view
+/// @param obj Object that owns `vec`, the array counts as its view
+/// @param owner Python object of `obj`, it is kept alive as long as the array exists
+template <typename T>
+static py::array_t<T>
+as_array(const std::vector<T> & vec, const void * obj, py::handle owner)
+{
+    py::array_t<T> arr(vec.size(), vec.data(), owner);
+    arr.attr("setflags")(py::arg("write") = false);
+    track_view(obj, arr);
+    return arr;
+}
+
+/// Create a reference to data owned by `obj`, which counts as its view
+///
+/// @param data Data to reference
+/// @param obj Object that owns `data`
+/// @param owner Python object of `obj`, it is kept alive as long as the reference exists
+template <typename T>
+static py::object
+internal_reference(const T & data, const void * obj, py::handle owner)
+{
+    auto ref = py::cast(&data, py::return_value_policy::reference_internal, owner);
+    track_view(obj, ref);
+    return ref;
+}
+
+/// Create a NumPy array that takes over the contents of a vector, no copy is made
+template <typename T>
+static py::array_t<T>
+to_array(std::vector<T> && vec)
+{
+    auto * data = new std::vector<T>(std::move(vec));
+    py::capsule owner(data, [](void * ptr) { delete static_cast<std::vector<T> *>(ptr); });
+    return py::array_t<T>(data->size(), data->data(), owner);
+}
+
+/// Bind a getter that returns a reference to a vector as a NumPy view
+template <typename C, typename T>
+static auto
+array_getter(const std::vector<T> & (C::*getter)() const)
+{
+    return [getter](py::object self) {
+        auto & obj = self.cast<const C &>();
+        return as_array((obj.*getter)(), &obj, self);
+    };
+}
+
+/// View the contents of a NumPy array, no copy is made if the array is contiguous and has the
+/// right type
+template <typename T>
+static Span<const T>
+as_span(const InArray<T> & arr)
+{
+    return Span<const T>(arr.data(), arr.size());
+}
+
+template <typename T>
+static std::vector<T>
+to_vector(const InArray<T> & arr)
+{
+    return std::vector<T>(arr.data(), arr.data() + arr.size());
+}
+
+/// Step writer that keeps the arrays it views alive until it is cleared
+struct PyStepWriter : public StepWriter {
+    using StepWriter::StepWriter;
+
+    /// Arrays viewed by the writer
+    std::vector<py::object> arrays;
+
+    Span<const double>
+    keep(const InArray<double> & arr)
+    {
+        this->arrays.push_back(arr);
+        return as_span(arr);
+    }
+};
+
 PYBIND11_MODULE(exodusIIcpp, m)
 {
     m.doc() = "pybind11 plugin for exodusIIcpp";
@@ -29,11 +210,42 @@ PYBIND11_MODULE(exodusIIcpp, m)
         .def("get_num_nodes_per_element", &ElementBlock::get_num_nodes_per_element)
         .def("get_element_type", &ElementBlock::get_element_type)
         .def("get_element_connectivity", &ElementBlock::get_element_connectivity)
+        .def("get_element_nodes",
+             [](const ElementBlock & self, std::size_t element_idx) {
+                 auto nodes = self.get_element_nodes(element_idx);
+                 return std::vector<int>(nodes.begin(), nodes.end());
+             })
         .def("get_num_elements", &ElementBlock::get_num_elements)
-        .def("get_connectivity", &ElementBlock::get_connectivity)
+        .def("get_connectivity", array_getter(&ElementBlock::get_connectivity))
         .def("set_id", &ElementBlock::set_id)
         .def("set_name", &ElementBlock::set_name)
-        .def("set_connectivity", &ElementBlock::set_connectivity);
+        .def("set_connectivity",
+             [](ElementBlock & self,
+                const char * elem_type,
+                int n_elems_in_block,
+                int n_nodes_per_elem,
+                const InArray<int> & connect) {
+                 check_no_views(&self);
+                 self.set_connectivity(elem_type,
+                                       n_elems_in_block,
+                                       n_nodes_per_elem,
+                                       to_vector(connect));
+             });
+
+    py::class_<exodusIIcpp::Connectivity>(m, "Connectivity")
+        .def(py::init())
+        .def("get_num_elements", &Connectivity::get_num_elements)
+        .def("get_element_nodes",
+             [](const Connectivity & self, int64_t elem_idx) {
+                 auto nodes = self.get_element_nodes(elem_idx);
+                 return std::vector<int>(nodes.begin(), nodes.end());
+             })
+        .def("get_element_type", &Connectivity::get_element_type)
+        .def("get_offsets", array_getter(&Connectivity::get_offsets))
+        .def("get_node_ids", array_getter(&Connectivity::get_node_ids))
+        .def("get_type_tags", array_getter(&Connectivity::get_type_tags))
+        .def("get_element_types", &Connectivity::get_element_types)
+        .def("set", mutator(&Connectivity::set));
 
     py::class_<exodusIIcpp::NodeSet>(m, "NodeSet")
         .def(py::init())
@@ -41,10 +253,18 @@ PYBIND11_MODULE(exodusIIcpp, m)
         .def("get_name", &NodeSet::get_name)
         .def("get_size", &NodeSet::get_size)
         .def("get_node_id", &NodeSet::get_node_id)
-        .def("get_node_ids", &NodeSet::get_node_ids)
+        .def("get_node_ids", array_getter(&NodeSet::get_node_ids))
         .def("set_id", &NodeSet::set_id)
         .def("set_name", &NodeSet::set_name)
-        .def("set_nodes", &NodeSet::set_nodes);
+        .def("set_nodes",
+             [](NodeSet & self, const InArray<int> & nodes) {
+                 check_no_views(&self);
+                 self.set_nodes(to_vector(nodes));
+             })
+        .def("contains", &NodeSet::contains)
+        .def("union_with", &NodeSet::union_with)
+        .def("intersection_with", &NodeSet::intersection_with)
+        .def("difference_with", &NodeSet::difference_with);
 
     py::class_<exodusIIcpp::SideSet>(m, "SideSet")
         .def(py::init())
@@ -52,24 +272,115 @@ PYBIND11_MODULE(exodusIIcpp, m)
         .def("get_name", &SideSet::get_name)
         .def("get_size", &SideSet::get_size)
         .def("get_element_id", &SideSet::get_element_id)
-        .def("get_element_ids", &SideSet::get_element_ids)
-        .def("get_side_ids", &SideSet::get_side_ids)
+        .def("get_element_ids", array_getter(&SideSet::get_element_ids))
+        .def("get_side_ids", array_getter(&SideSet::get_side_ids))
         .def("get_side_id", &SideSet::get_side_id)
         .def("set_id", &SideSet::set_id)
         .def("set_name", &SideSet::set_name)
-        .def("set_sides", &SideSet::set_sides)
-        .def("add", &SideSet::add);
+        .def("set_sides",
+             [](SideSet & self, const InArray<int> & elems, const InArray<int> & sides) {
+                 check_no_views(&self);
+                 self.set_sides(to_vector(elems), to_vector(sides));
+             })
+        .def("add", mutator(&SideSet::add));
+
+    m.def("skin",
+          static_cast<SideSet (*)(const std::vector<ElementBlock> &, unsigned int)>(&skin),
+          py::arg("blocks"),
+          py::arg("n_threads") = 1);
+    m.def("skin",
+          static_cast<SideSet (*)(const std::vector<ElementBlock> &, ElementBlock &, unsigned int)>(
+              &skin),
+          py::arg("blocks"),
+          py::arg("surface"),
+          py::arg("n_threads") = 1);
+
+    py::class_<exodusIIcpp::IdMap>(m, "IdMap")
+        .def(py::init())
+        .def("get_size", &IdMap::get_size)
+        .def("get_id", &IdMap::get_id)
+        .def("get_index", &IdMap::get_index)
+        .def("get_ids", array_getter(&IdMap::get_ids))
+        .def("set_ids", mutator(&IdMap::set_ids));
+
+    py::class_<exodusIIcpp::BoundingBox>(m, "BoundingBox")
+        .def(py::init())
+        .def_readwrite("min", &BoundingBox::min)
+        .def_readwrite("max", &BoundingBox::max);
+
+    py::class_<exodusIIcpp::BlockGeometry>(m, "BlockGeometry")
+        .def(py::init())
+        .def_readwrite("block_id", &BlockGeometry::block_id)
+        .def_readwrite("bbox", &BlockGeometry::bbox)
+        .def_readwrite("centroids", &BlockGeometry::centroids)
+        .def_readwrite("char_lengths", &BlockGeometry::char_lengths)
+        .def_readwrite("min_char_length", &BlockGeometry::min_char_length)
+        .def_readwrite("max_char_length", &BlockGeometry::max_char_length);
+
+    py::class_<exodusIIcpp::GeometrySummary>(m, "GeometrySummary")
+        .def(py::init())
+        .def_readwrite("bbox", &GeometrySummary::bbox)
+        .def_readwrite("blocks", &GeometrySummary::blocks);
+
+    py::enum_<exodusIIcpp::ReorderingMethod>(m, "ReorderingMethod")
+        .value("RCM", exodusIIcpp::ReorderingMethod::RCM)
+        .value("HILBERT", exodusIIcpp::ReorderingMethod::HILBERT)
+        .value("MORTON", exodusIIcpp::ReorderingMethod::MORTON);
 
-    py::class_<exodusIIcpp::File>(m, "File")
+    py::class_<exodusIIcpp::Reordering>(m, "Reordering")
         .def(py::init())
-        .def(py::init<const fs::path &, exodusIIcpp::FileAccess>())
-        .def("open", &File::open)
-        .def("create", &File::create)
-        .def("append", &File::append)
+        .def(py::init<ReorderingMethod,
+                      const std::vector<double> &,
+                      const std::vector<double> &,
+                      const std::vector<double> &,
+                      const std::vector<ElementBlock> &>())
+        .def("empty", &Reordering::empty)
+        .def("get_num_nodes", &Reordering::get_num_nodes)
+        .def("get_num_elements", &Reordering::get_num_elements)
+        .def("get_node_order", &Reordering::get_node_order)
+        .def("get_node_index", &Reordering::get_node_index)
+        .def("get_elem_order", &Reordering::get_elem_order)
+        .def("get_elem_index", &Reordering::get_elem_index)
+        .def("get_block_offsets", &Reordering::get_block_offsets);
+
+    py::class_<exodusIIcpp::CommMap>(m, "CommMap")
+        .def(py::init())
+        .def_readwrite("id", &CommMap::id)
+        .def_readwrite("ids", &CommMap::ids)
+        .def_readwrite("sides", &CommMap::sides)
+        .def_readwrite("procs", &CommMap::procs);
+
+    py::class_<exodusIIcpp::LoadBalance>(m, "LoadBalance")
+        .def(py::init())
+        .def_readwrite("n_parts", &LoadBalance::n_parts)
+        .def_readwrite("part", &LoadBalance::part)
+        .def_readwrite("n_global_nodes", &LoadBalance::n_global_nodes)
+        .def_readwrite("n_global_elems", &LoadBalance::n_global_elems)
+        .def_readwrite("global_blk_ids", &LoadBalance::global_blk_ids)
+        .def_readwrite("global_blk_counts", &LoadBalance::global_blk_counts)
+        .def_readwrite("global_ns_ids", &LoadBalance::global_ns_ids)
+        .def_readwrite("global_ns_counts", &LoadBalance::global_ns_counts)
+        .def_readwrite("global_ss_ids", &LoadBalance::global_ss_ids)
+        .def_readwrite("global_ss_counts", &LoadBalance::global_ss_counts)
+        .def_readwrite("internal_nodes", &LoadBalance::internal_nodes)
+        .def_readwrite("border_nodes", &LoadBalance::border_nodes)
+        .def_readwrite("internal_elems", &LoadBalance::internal_elems)
+        .def_readwrite("border_elems", &LoadBalance::border_elems)
+        .def_readwrite("node_cmaps", &LoadBalance::node_cmaps)
+        .def_readwrite("elem_cmaps", &LoadBalance::elem_cmaps);
+
+    py::class_<exodusIIcpp::File, std::unique_ptr<File, LockedDelete<File>>>(m, "File")
+        .def(py::init())
+        .def(py::init<const fs::path &, exodusIIcpp::FileAccess>(), IoGuard())
+        .def("open", &File::open, IoGuard())
+        .def("create", &File::create, IoGuard())
+        .def("append", &File::append, IoGuard())
         .def("is_opened", &File::is_opened)
-        .def("init", static_cast<void (File::*)()>(&File::init))
+        .def("is_parallel", &File::is_parallel)
+        .def("init", static_cast<void (File::*)()>(&File::init), IoGuard())
         .def("init",
-             static_cast<void (File::*)(const char *, int, int, int, int, int, int)>(&File::init))
+             static_cast<void (File::*)(const char *, int, int, int, int, int, int)>(&File::init),
+             IoGuard())
         //
         .def("get_title", &File::get_title)
         .def("get_dim", &File::get_dim)
@@ -78,78 +389,454 @@ PYBIND11_MODULE(exodusIIcpp, m)
         .def("get_num_element_blocks", &File::get_num_element_blocks)
         .def("get_num_node_sets", &File::get_num_node_sets)
         .def("get_num_side_sets", &File::get_num_side_sets)
-        .def("get_x_coords", &File::get_x_coords)
-        .def("get_y_coords", &File::get_y_coords)
-        .def("get_z_coords", &File::get_z_coords)
+        .def("get_x_coords", array_getter(&File::get_x_coords))
+        .def("get_y_coords", array_getter(&File::get_y_coords))
+        .def("get_z_coords", array_getter(&File::get_z_coords))
         .def("get_coord_names", &File::get_coord_names)
-        .def("get_element_block", &File::get_element_block)
+        .def("get_node_id_map", &File::get_node_id_map)
+        .def("get_elem_id_map", &File::get_elem_id_map)
+        .def("get_element_block",
+             [](py::object self, std::size_t idx) {
+                 auto & file = self.cast<const File &>();
+                 return internal_reference(file.get_element_block(idx), &file, self);
+             })
         .def("get_element_blocks", &File::get_element_blocks)
+        .def("get_element_block_ids", &File::get_element_block_ids)
+        .def("get_connectivity",
+             [](py::object self) {
+                 auto & file = self.cast<const File &>();
+                 return internal_reference(file.get_connectivity(), &file, self);
+             })
+        .def("get_element_block_index", &File::get_element_block_index)
+        .def("get_global_element_index", &File::get_global_element_index)
+        .def("get_local_element_index", &File::get_local_element_index)
         .def("get_side_sets", &File::get_side_sets)
         .def("get_side_set_node_list",
              [](const File & self, int side_set_idx) {
                  std::vector<int> node_count_list, node_list;
-                 self.get_side_set_node_list(side_set_idx, node_count_list, node_list);
+                 release_gil([&] {
+                     self.get_side_set_node_list(side_set_idx, node_count_list, node_list);
+                 });
                  return py::make_tuple(node_count_list, node_list);
              })
         .def("get_node_sets", &File::get_node_sets)
-        .def("get_num_times", &File::get_num_times)
-        .def("get_times", &File::get_times)
-        .def("get_nodal_variable_names", &File::get_nodal_variable_names)
-        .def("get_elemental_variable_names", &File::get_elemental_variable_names)
-        .def("get_global_variable_names", &File::get_global_variable_names)
-        .def("get_nodal_variable_values", &File::get_nodal_variable_values)
-        .def("get_elemental_variable_values", &File::get_elemental_variable_values)
+        .def("get_num_times", &File::get_num_times, IoGuard())
+        .def("get_times", array_getter(&File::get_times))
+        .def("get_nodal_variable_names", &File::get_nodal_variable_names, IoGuard())
+        .def("get_elemental_variable_names", &File::get_elemental_variable_names, IoGuard())
+        .def("get_global_variable_names", &File::get_global_variable_names, IoGuard())
+        .def("get_nodal_variable_values",
+             [](const File & self, int time_step, int var_idx) {
+                 return to_array(release_gil(
+                     [&] { return self.get_nodal_variable_values(time_step, var_idx); }));
+             })
+        .def("get_partial_nodal_variable_values",
+             [](const File & self, int time_step, int var_idx, int64_t start_idx, int64_t count) {
+                 return to_array(release_gil([&] {
+                     return self.get_partial_nodal_variable_values(time_step,
+                                                                   var_idx,
+                                                                   start_idx,
+                                                                   count);
+                 }));
+             })
+        .def("get_partial_elemental_variable_values",
+             [](const File & self,
+                int time_step,
+                int var_idx,
+                int block_id,
+                int64_t start_idx,
+                int64_t count) {
+                 return to_array(release_gil([&] {
+                     return self.get_partial_elemental_variable_values(time_step,
+                                                                       var_idx,
+                                                                       block_id,
+                                                                       start_idx,
+                                                                       count);
+                 }));
+             })
+        .def("get_partial_elemental_variable_values",
+             [](const File & self, int time_step, int var_idx, int64_t start_idx, int64_t count) {
+                 return to_array(release_gil([&] {
+                     return self.get_partial_elemental_variable_values(time_step,
+                                                                       var_idx,
+                                                                       start_idx,
+                                                                       count);
+                 }));
+             })
+        .def("get_elemental_variable_values",
+             [](const File & self, int time_step, int var_idx, int block_id) {
+                 return to_array(release_gil([&] {
+                     return self.get_elemental_variable_values(time_step, var_idx, block_id);
+                 }));
+             })
+        .def("get_elemental_variable_values",
+             [](const File & self, int time_step, int var_idx) {
+                 return to_array(release_gil(
+                     [&] { return self.get_elemental_variable_values(time_step, var_idx); }));
+             })
         .def("get_global_variable_values",
-             static_cast<std::vector<double> (File::*)(int) const>(
-                 &File::get_global_variable_values))
+             [](const File & self, int time_step) {
+                 return to_array(
+                     release_gil([&] { return self.get_global_variable_values(time_step); }));
+             })
         .def("get_global_variable_values",
-             static_cast<std::vector<double> (File::*)(int, int, int) const>(
-                 &File::get_global_variable_values),
+             [](const File & self, int var_idx, int begin_idx, int end_idx) {
+                 return to_array(release_gil([&] {
+                     return self.get_global_variable_values(var_idx, begin_idx, end_idx);
+                 }));
+             },
              py::arg("var_idx"),
              py::arg("begin_idx"),
              py::arg("end_idx") = -1)
+        .def("compute_geometry_summary",
+             &File::compute_geometry_summary,
+             py::arg("n_threads") = 1,
+             IoGuard())
+        .def("mesh_fingerprint",
+             [](const File & self, bool use_info_record, unsigned int n_threads) {
+                 return self.mesh_fingerprint(use_info_record, n_threads);
+             },
+             py::arg("use_info_record") = true,
+             py::arg("n_threads") = 1,
+             IoGuard())
         // read
-        .def("read", &File::read)
-        .def("read_coords", &File::read_coords)
-        .def("read_coord_names", &File::read_coord_names)
-        .def("read_elem_map", &File::read_elem_map)
-        .def("read_blocks", &File::read_blocks)
-        .def("read_block_names", &File::read_block_names)
-        .def("read_node_sets", &File::read_node_sets)
-        .def("read_node_set_names", &File::read_node_set_names)
-        .def("read_side_sets", &File::read_side_sets)
-        .def("read_side_set_names", &File::read_side_set_names)
-        .def("read_times", &File::read_times)
+        .def("read", mutator(&File::read), IoGuard())
+        .def("read_coords", mutator(&File::read_coords), IoGuard())
+        .def("read_coord_names", &File::read_coord_names, IoGuard())
+        .def("read_elem_map", &File::read_elem_map, IoGuard())
+        .def("read_node_id_map", &File::read_node_id_map, IoGuard())
+        .def("read_elem_id_map", &File::read_elem_id_map, IoGuard())
+        .def("read_blocks", mutator(&File::read_blocks), IoGuard())
+        .def("read_block_info", &File::read_block_info, IoGuard())
+        .def("read_partial_connectivity",
+             [](const File & self, int block_id, int64_t start_idx, int64_t count) {
+                 std::vector<int> connect;
+                 release_gil(
+                     [&] { self.read_partial_connectivity(block_id, start_idx, count, connect); });
+                 return to_array(std::move(connect));
+             })
+        .def("read_partial_coords",
+             [](const File & self, int64_t start_idx, int64_t count) {
+                 std::vector<double> x, y, z;
+                 release_gil([&] { self.read_partial_coords(start_idx, count, x, y, z); });
+                 return py::make_tuple(to_array(std::move(x)),
+                                       to_array(std::move(y)),
+                                       to_array(std::move(z)));
+             })
+        .def("read_connectivity", mutator(&File::read_connectivity), IoGuard())
+        .def("read_block_names", &File::read_block_names, IoGuard())
+        .def("read_node_sets", &File::read_node_sets, IoGuard())
+        .def("read_node_set_ids", &File::read_node_set_ids, IoGuard())
+        .def("read_node_set", &File::read_node_set, IoGuard())
+        .def("read_node_set_names", &File::read_node_set_names, IoGuard())
+        .def("read_side_sets", &File::read_side_sets, IoGuard())
+        .def("read_side_set_ids", &File::read_side_set_ids, IoGuard())
+        .def("read_side_set", &File::read_side_set, IoGuard())
+        .def("read_side_set_names", &File::read_side_set_names, IoGuard())
+        .def("read_info", &File::read_info, IoGuard())
+        .def("read_elem_var_truth_table", &File::read_elem_var_truth_table, IoGuard())
+        .def("read_times", mutator(&File::read_times), IoGuard())
         // write
         .def("write_coords",
-             static_cast<void (File::*)(const std::vector<double> &)>(&File::write_coords))
+             [](File & self, const InArray<double> & x) {
+                 release_gil([&] { self.write_coords(as_span(x)); });
+             })
         .def("write_coords",
-             static_cast<void (File::*)(const std::vector<double> &, const std::vector<double> &)>(
-                 &File::write_coords))
+             [](File & self, const InArray<double> & x, const InArray<double> & y) {
+                 release_gil([&] { self.write_coords(as_span(x), as_span(y)); });
+             })
         .def("write_coords",
-             static_cast<void (File::*)(const std::vector<double> &,
-                                        const std::vector<double> &,
-                                        const std::vector<double> &)>(&File::write_coords))
-        .def("write_coord_names", static_cast<void (File::*)()>(&File::write_coord_names))
+             [](File & self,
+                const InArray<double> & x,
+                const InArray<double> & y,
+                const InArray<double> & z) {
+                 release_gil([&] { self.write_coords(as_span(x), as_span(y), as_span(z)); });
+             })
+        .def(
+            "write_partial_coords",
+            [](File & self,
+               int64_t start_idx,
+               const InArray<double> & x,
+               const InArray<double> & y,
+               const InArray<double> & z) {
+                release_gil([&] {
+                    self.write_partial_coords(start_idx, as_span(x), as_span(y), as_span(z));
+                });
+            },
+            py::arg("start_idx"),
+            py::arg("x"),
+            py::arg("y") = InArray<double>(),
+            py::arg("z") = InArray<double>())
+        .def("set_reordering", &File::set_reordering, IoGuard())
+        .def("get_reordering", &File::get_reordering)
+        .def("write_coord_names",
+             static_cast<void (File::*)()>(&File::write_coord_names),
+             IoGuard())
         .def(
             "write_coord_names",
-            static_cast<void (File::*)(const std::vector<std::string> &)>(&File::write_coord_names))
-        .def("write_info", &File::write_info)
-        .def("write_time", &File::write_time)
-        .def("write_node_set_names", &File::write_node_set_names)
-        .def("write_node_set", &File::write_node_set)
-        .def("write_side_set_names", &File::write_side_set_names)
-        .def("write_side_set", &File::write_side_set)
-        .def("write_block_names", &File::write_block_names)
-        .def("write_block", &File::write_block)
-        .def("write_nodal_var_names", &File::write_nodal_var_names)
-        .def("write_elem_var_names", &File::write_elem_var_names)
-        .def("write_global_var_names", &File::write_global_var_names)
-        .def("write_nodal_var", &File::write_nodal_var)
-        .def("write_partial_nodal_var", &File::write_partial_nodal_var)
-        .def("write_partial_elem_var", &File::write_partial_elem_var)
-        .def("write_global_var", &File::write_global_var)
+            static_cast<void (File::*)(const std::vector<std::string> &)>(&File::write_coord_names),
+            IoGuard())
+        .def("write_info", &File::write_info, IoGuard())
+        .def("write_info_with_fingerprint",
+             &File::write_info_with_fingerprint,
+             py::arg("info") = std::vector<std::string>(),
+             IoGuard())
+        .def("write_node_id_map", &File::write_node_id_map, IoGuard())
+        .def("write_elem_id_map", &File::write_elem_id_map, IoGuard())
+        .def("write_load_balance", &File::write_load_balance, IoGuard())
+        .def("write_time", &File::write_time, IoGuard())
+        .def("write_node_set_names", &File::write_node_set_names, IoGuard())
+        .def("write_node_set",
+             [](File & self, int64_t set_id, const InArray<int> & node_set) {
+                 auto nodes = to_vector(node_set);
+                 release_gil([&] { self.write_node_set(set_id, nodes); });
+             })
+        .def("write_side_set_names", &File::write_side_set_names, IoGuard())
+        .def("write_side_set",
+             [](File & self,
+                int64_t set_id,
+                const InArray<int> & elem_list,
+                const InArray<int> & side_list) {
+                 auto elems = to_vector(elem_list);
+                 auto sides = to_vector(side_list);
+                 release_gil([&] { self.write_side_set(set_id, elems, sides); });
+             })
+        .def("write_block_names", &File::write_block_names, IoGuard())
+        .def("write_block",
+             [](File & self,
+                int64_t blk_id,
+                const char * elem_type,
+                int64_t n_elems_in_block,
+                const InArray<int> & connect) {
+                 release_gil([&] {
+                     self.write_block(blk_id, elem_type, n_elems_in_block, as_span(connect));
+                 });
+             })
+        .def("write_block_info", &File::write_block_info, IoGuard())
+        .def("write_partial_connectivity",
+             [](File & self,
+                int64_t blk_id,
+                int64_t start_idx,
+                int64_t count,
+                const InArray<int> & connect) {
+                 release_gil([&] {
+                     self.write_partial_connectivity(blk_id, start_idx, count, as_span(connect));
+                 });
+             })
+        .def("write_nodal_var_names", &File::write_nodal_var_names, IoGuard())
+        .def("write_elem_var_names", &File::write_elem_var_names, IoGuard())
+        .def("write_global_var_names", &File::write_global_var_names, IoGuard())
+        .def("write_elem_var_truth_table", &File::write_elem_var_truth_table, IoGuard())
+        .def("write_nodal_var",
+             [](File & self, int step_num, int var_index, const InArray<double> & values) {
+                 release_gil([&] { self.write_nodal_var(step_num, var_index, as_span(values)); });
+             })
+        .def("write_elem_var",
+             [](File & self, int step_num, int var_index, const InArray<double> & values) {
+                 release_gil([&] { self.write_elem_var(step_num, var_index, as_span(values)); });
+             })
+        .def("write_elem_var",
+             [](File & self,
+                int step_num,
+                int var_index,
+                int64_t blk_id,
+                const InArray<double> & values) {
+                 release_gil(
+                     [&] { self.write_elem_var(step_num, var_index, blk_id, as_span(values)); });
+             })
+        .def("write_partial_nodal_var", &File::write_partial_nodal_var, IoGuard())
+        .def("write_partial_nodal_var_range",
+             [](File & self,
+                int step_num,
+                int var_index,
+                int64_t start_idx,
+                const InArray<double> & values) {
+                 release_gil([&] {
+                     self.write_partial_nodal_var_range(step_num,
+                                                        var_index,
+                                                        start_idx,
+                                                        as_span(values));
+                 });
+             })
+        .def("write_partial_elem_var", &File::write_partial_elem_var, IoGuard())
+        .def("write_partial_elem_var_range",
+             [](File & self,
+                int step_num,
+                int var_index,
+                int64_t blk_id,
+                int64_t start_idx,
+                const InArray<double> & values) {
+                 release_gil([&] {
+                     self.write_partial_elem_var_range(step_num,
+                                                       var_index,
+                                                       blk_id,
+                                                       start_idx,
+                                                       as_span(values));
+                 });
+             })
+        .def("write_partial_elem_var_range",
+             [](File & self,
+                int step_num,
+                int var_index,
+                int64_t start_idx,
+                const InArray<double> & values) {
+                 release_gil([&] {
+                     self.write_partial_elem_var_range(step_num,
+                                                       var_index,
+                                                       start_idx,
+                                                       as_span(values));
+                 });
+             })
+        .def("write_global_var", &File::write_global_var, IoGuard())
+        .def("write_global_vars",
+             [](File & self, int step_num, const InArray<double> & values) {
+                 release_gil([&] { self.write_global_vars(step_num, as_span(values)); });
+             })
+        .def("append_step",
+             [](File & self,
+                double time,
+                const std::vector<InArray<double>> & nodal,
+                const std::vector<InArray<double>> & elemental,
+                const InArray<double> & global) {
+                 std::vector<Span<const double>> nodal_spans, elem_spans;
+                 for (auto & values : nodal)
+                     nodal_spans.push_back(as_span(values));
+                 for (auto & values : elemental)
+                     elem_spans.push_back(as_span(values));
+                 return release_gil([&] {
+                     return self.append_step(time, nodal_spans, elem_spans, as_span(global));
+                 });
+             })
         //
-        .def("update", &File::update)
-        .def("close", &File::close);
+        .def("update", &File::update, IoGuard())
+        .def("close", &File::close, IoGuard());
+
+    m.def("copy_mesh", &copy_mesh, IoGuard());
+    m.def("copy_time_steps",
+          &copy_time_steps,
+          py::arg("src"),
+          py::arg("dest"),
+          py::arg("time_steps"),
+          py::arg("dropped_variables") = std::vector<std::string>(),
+          py::arg("max_buffered_values") = 0,
+          IoGuard());
+    m.def("join_time_steps",
+          &join_time_steps,
+          py::arg("file_paths"),
+          py::arg("dest"),
+          py::arg("dropped_variables") = std::vector<std::string>(),
+          py::arg("max_buffered_values") = 0,
+          IoGuard());
+    m.def("join_parts",
+          &join_parts,
+          py::arg("part_paths"),
+          py::arg("dest"),
+          py::arg("dropped_variables") = std::vector<std::string>(),
+          py::arg("n_threads") = 1,
+          IoGuard());
+
+    py::class_<exodusIIcpp::Decomposition>(m, "Decomposition")
+        .def(py::init<const File &, int>())
+        .def("get_num_parts", &Decomposition::get_num_parts)
+        .def("get_element_parts", array_getter(&Decomposition::get_element_parts))
+        .def("write",
+             &Decomposition::write,
+             py::arg("file"),
+             py::arg("file_path"),
+             py::arg("n_threads") = 1,
+             IoGuard())
+        .def_static("get_part_file_path", &Decomposition::get_part_file_path);
+
+    py::class_<PyStepWriter>(m, "StepWriter")
+        .def(py::init<File &>(), py::keep_alive<1, 2>())
+        .def("add_global_vars",
+             [](PyStepWriter & self, const InArray<double> & values) {
+                 self.add_global_vars(self.keep(values));
+             })
+        .def("add_nodal_var",
+             [](PyStepWriter & self, int var_index, const InArray<double> & values) {
+                 self.add_nodal_var(var_index, self.keep(values));
+             })
+        .def("add_elem_var",
+             [](PyStepWriter & self, int var_index, const InArray<double> & values) {
+                 self.add_elem_var(var_index, self.keep(values));
+             })
+        .def("add_elem_var",
+             [](PyStepWriter & self,
+                int var_index,
+                int64_t blk_id,
+                const InArray<double> & values) {
+                 self.add_elem_var(var_index, blk_id, self.keep(values));
+             })
+        .def("write", &PyStepWriter::write, IoGuard())
+        .def("clear",
+             [](PyStepWriter & self) {
+                 self.clear();
+                 self.arrays.clear();
+             });
+
+    py::class_<exodusIIcpp::PointLocation>(m, "PointLocation")
+        .def(py::init())
+        .def_readwrite("block_idx", &PointLocation::block_idx)
+        .def_readwrite("block_id", &PointLocation::block_id)
+        .def_readwrite("elem_idx", &PointLocation::elem_idx)
+        .def_readwrite("xi", &PointLocation::xi);
+
+    py::class_<exodusIIcpp::SpatialIndex>(m, "SpatialIndex")
+        .def(py::init<const File &, unsigned int>(),
+             py::arg("file"),
+             py::arg("n_threads") = 1,
+             IoGuard())
+        .def("get_dim", &SpatialIndex::get_dim)
+        .def("locate",
+             &SpatialIndex::locate,
+             py::arg("points"),
+             py::arg("n_threads") = 1,
+             IoGuard())
+        .def("find_nearest_nodes",
+             &SpatialIndex::find_nearest_nodes,
+             py::arg("points"),
+             py::arg("n_threads") = 1,
+             IoGuard());
+
+    py::class_<exodusIIcpp::Probe>(m, "Probe")
+        .def(py::init<const File &,
+                      const SpatialIndex &,
+                      const std::vector<std::array<double, 3>> &>(),
+             IoGuard())
+        .def("get_num_points", &Probe::get_num_points)
+        .def("get_locations", &Probe::get_locations)
+        .def("get_node_ranges", &Probe::get_node_ranges)
+        .def("interpolate", &Probe::interpolate, IoGuard());
+
+    py::class_<exodusIIcpp::Ensemble, std::unique_ptr<Ensemble, LockedDelete<Ensemble>>>(
+        m,
+        "Ensemble")
+        .def(py::init<const std::vector<fs::path> &, std::size_t, unsigned int>(),
+             py::arg("file_paths"),
+             py::arg("max_open_files") = 16,
+             py::arg("n_threads") = 1,
+             IoGuard())
+        .def("get_num_members", &Ensemble::get_num_members)
+        .def("get_file_path", &Ensemble::get_file_path)
+        .def("get_num_meshes", &Ensemble::get_num_meshes)
+        .def("get_mesh_index", &Ensemble::get_mesh_index)
+        .def("get_mesh", &Ensemble::get_mesh, py::return_value_policy::reference_internal)
+        .def("get_mesh_fingerprint", &Ensemble::get_mesh_fingerprint)
+        .def("get_num_open_files", &Ensemble::get_num_open_files)
+        .def("read_nodal_variable",
+             [](const Ensemble & self, int time_step, const std::string & var_name) {
+                 return to_array(
+                     release_gil([&] { return self.read_nodal_variable(time_step, var_name); }));
+             })
+        .def("read_elemental_variable",
+             [](const Ensemble & self, int time_step, const std::string & var_name) {
+                 return to_array(release_gil(
+                     [&] { return self.read_elemental_variable(time_step, var_name); }));
+             })
+        .def("read_global_variable",
+             [](const Ensemble & self, int time_step, const std::string & var_name) {
+                 return to_array(
+                     release_gil([&] { return self.read_global_variable(time_step, var_name); }));
+             });
 }
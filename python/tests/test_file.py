@@ -4,6 +4,7 @@
 import pathlib
 
 import exodusIIcpp
+import numpy as np
 import pytest
 
 
@@ -104,11 +105,11 @@ def test_create_tet4(tmp_dir):
     assert g.get_num_side_sets() == 1
 
     gx = g.get_x_coords()
-    assert gx == [0.0, 1.0, 0.0, 0.0]
+    assert gx.tolist() == [0.0, 1.0, 0.0, 0.0]
     gy = g.get_y_coords()
-    assert gy == [0.0, 0.0, 1.0, 0.0]
+    assert gy.tolist() == [0.0, 0.0, 1.0, 0.0]
     gz = g.get_z_coords()
-    assert gz == [0.0, 0.0, 1.0, 1.0]
+    assert gz.tolist() == [0.0, 0.0, 1.0, 1.0]
 
     blocks = g.get_element_blocks()
     assert len(blocks) == 1
@@ -418,3 +419,450 @@ def test_test(assets_dir):
         assert ss_nodes == [2, 3, 7, 8]
 
         f.close()
+
+
+def test_id_maps(tmp_dir):
+    """Test writing and reading node and element ID maps."""
+    file_path = str(tmp_dir / "id_maps.e")
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 2, 4, 2, 1, 0, 0)
+    f.write_coords([0, 1, 0, 1], [0, 0, 1, 1])
+    f.write_block(1, "TRI3", 2, [1, 2, 3, 2, 4, 3])
+    f.write_node_id_map([10, 20, 30, 40])
+    f.write_elem_id_map([7, 3])
+    f.close()
+
+    g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    g.read_node_id_map()
+    g.read_elem_id_map()
+
+    node_map = g.get_node_id_map()
+    assert node_map.get_ids().tolist() == [10, 20, 30, 40]
+    assert node_map.get_index(30) == 2
+    assert node_map.get_index(35) == -1
+
+    elem_map = g.get_elem_id_map()
+    assert elem_map.get_ids().tolist() == [7, 3]
+    assert elem_map.get_index(3) == 1
+    g.close()
+
+
+def test_spatial_index(tmp_dir):
+    """Test point location and nearest-node queries."""
+    file_path = str(tmp_dir / "spatial.e")
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 2, 6, 2, 1, 0, 0)
+    f.write_coords([0, 1, 2, 0, 1, 2], [0, 0, 0, 1, 1, 1])
+    f.write_block(1, "QUAD4", 2, [1, 2, 5, 4, 2, 3, 6, 5])
+    f.close()
+
+    g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    g.read_coords()
+    g.read_blocks()
+    idx = exodusIIcpp.SpatialIndex(g)
+
+    locs = idx.locate([[1.5, 0.5, 0.0], [5.0, 0.0, 0.0]])
+    assert locs[0].block_id == 1
+    assert locs[0].elem_idx == 1
+    assert locs[0].xi[0] == pytest.approx(0.0)
+    assert locs[1].block_id == -1
+
+    assert idx.find_nearest_nodes([[1.9, 0.9, 0.0]]) == [6]
+
+    threaded = exodusIIcpp.SpatialIndex(g, n_threads=2)
+    assert threaded.locate([[1.5, 0.5, 0.0]], n_threads=2)[0].elem_idx == 1
+    assert threaded.find_nearest_nodes([[1.9, 0.9, 0.0]], n_threads=2) == [6]
+    g.close()
+
+
+def test_probe(tmp_dir):
+    """Test interpolation of nodal variables at probe points."""
+    file_path = str(tmp_dir / "probe.e")
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 2, 4, 1, 1, 0, 0)
+    f.write_coords([0, 1, 1, 0], [0, 0, 1, 1])
+    f.write_block(1, "QUAD4", 1, [1, 2, 3, 4])
+    f.write_nodal_var_names(["u"])
+    f.write_time(1, 0.0)
+    f.write_nodal_var(1, 1, [0, 1, 2, 1])
+    f.close()
+
+    g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    g.read_coords()
+    g.read_blocks()
+    idx = exodusIIcpp.SpatialIndex(g)
+    probe = exodusIIcpp.Probe(g, idx, [[0.5, 0.5, 0.0], [0.25, 0.0, 0.0]])
+    assert probe.get_node_ranges() == [(0, 4)]
+    vals = probe.interpolate(g, 1, [1])
+    assert vals[0][0] == pytest.approx(1.0)
+    assert vals[0][1] == pytest.approx(0.25)
+    assert g.get_partial_nodal_variable_values(1, 1, 1, 2) == pytest.approx([1.0, 2.0])
+    g.close()
+
+
+def test_reordering(tmp_dir):
+    """Test writing a mesh with reordered nodes and elements."""
+    file_path = str(tmp_dir / "reorder.e")
+
+    x = [3.0, 2.0, 1.0, 0.0]
+    connect = [2, 1, 3, 2, 4, 3]
+    blk = exodusIIcpp.ElementBlock()
+    blk.set_connectivity("BAR2", 3, 2, connect)
+    r = exodusIIcpp.Reordering(exodusIIcpp.ReorderingMethod.MORTON, x, [], [], [blk])
+    assert r.get_node_order() == [3, 2, 1, 0]
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 1, 4, 3, 1, 0, 0)
+    f.set_reordering(r)
+    f.write_coords(x)
+    f.write_block(1, "BAR2", 3, connect)
+    f.close()
+
+    g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    g.read_coords()
+    g.read_node_id_map()
+    assert g.get_x_coords().tolist() == [0.0, 1.0, 2.0, 3.0]
+    assert g.get_node_id_map().get_ids().tolist() == [4, 3, 2, 1]
+    g.close()
+
+
+def test_numpy_arrays(tmp_dir):
+    """Test that bulk data is exchanged as NumPy arrays."""
+    file_path = str(tmp_dir / "numpy.e")
+
+    x = np.array([0.0, 1.0, 2.0, 0.0, 1.0, 2.0])
+    y = np.array([0.0, 0.0, 0.0, 1.0, 1.0, 1.0])
+    connect = np.array([1, 2, 5, 4, 2, 3, 6, 5], dtype=np.int64)
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 2, 6, 2, 1, 0, 0)
+    f.write_coords(x, y)
+    f.write_block(1, "QUAD4", 2, connect)
+    f.write_time(1, 0.5)
+    f.write_nodal_var_names(["u"])
+    f.write_nodal_var(1, 1, 2.0 * x)
+    f.close()
+
+    g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    g.read_coords()
+    g.read_blocks()
+    gx = g.get_x_coords()
+    assert isinstance(gx, np.ndarray)
+    assert not gx.flags.writeable
+    np.testing.assert_array_equal(gx, x)
+    conn = g.get_element_block(0).get_connectivity()
+    np.testing.assert_array_equal(conn, connect)
+    np.testing.assert_allclose(g.get_nodal_variable_values(1, 1), 2.0 * x)
+
+    # views keep the file alive
+    g.close()
+    del g
+    np.testing.assert_array_equal(gx, x)
+    np.testing.assert_array_equal(conn, connect)
+
+
+def test_views_block_changes(tmp_dir):
+    """Test that objects with live views refuse changes that would free the viewed data."""
+    ns = exodusIIcpp.NodeSet()
+    ns.set_nodes([1, 2, 3])
+    ids = ns.get_node_ids()
+    with pytest.raises(RuntimeError):
+        ns.set_nodes([4, 5])
+    np.testing.assert_array_equal(ids, [1, 2, 3])
+    del ids
+    ns.set_nodes([4, 5])
+    np.testing.assert_array_equal(ns.get_node_ids(), [4, 5])
+
+    file_path = str(tmp_dir / "views.e")
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 1, 3, 2, 1, 0, 0)
+    f.write_coords([0.0, 1.0, 2.0])
+    f.write_block(1, "BAR2", 2, [1, 2, 2, 3])
+    f.close()
+
+    g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    g.read()
+    gx = g.get_x_coords()[1:]
+    with pytest.raises(RuntimeError):
+        g.read_coords()
+    del gx
+    g.read_coords()
+
+    blk = g.get_element_block(0)
+    conn = blk.get_connectivity()
+    del blk
+    with pytest.raises(RuntimeError):
+        g.read_blocks()
+    np.testing.assert_array_equal(conn, [1, 2, 2, 3])
+    del conn
+    g.read_coords()
+
+
+def test_threads(tmp_dir):
+    """Test that files can be read from several threads at once."""
+    import threading
+
+    file_paths = []
+    for i in range(4):
+        file_path = str(tmp_dir / f"thread-{i}.e")
+        x = np.linspace(0.0, 1.0, 1000) + i
+        f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+        f.init("test", 1, 1000, 0, 0, 0, 0)
+        f.write_coords(x)
+        f.close()
+        file_paths.append(file_path)
+
+    results = [None] * len(file_paths)
+
+    def read(i):
+        g = exodusIIcpp.File(file_paths[i], exodusIIcpp.FileAccess.READ)
+        g.read_coords()
+        results[i] = g.get_x_coords()[0]
+
+    threads = [threading.Thread(target=read, args=(i,)) for i in range(len(file_paths))]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert results == [0.0, 1.0, 2.0, 3.0]
+
+
+def test_ensemble(tmp_dir):
+    """Test reading an ensemble of files sharing a mesh."""
+    file_paths = []
+    for i in range(3):
+        file_path = str(tmp_dir / f"ens-{i}.e")
+        f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+        f.init("test", 1, 3, 2, 1, 0, 0)
+        f.write_coords([0.0, 0.5, 1.0])
+        f.write_block(1, "BAR2", 2, [1, 2, 2, 3])
+        f.write_nodal_var_names(["u"])
+        f.write_global_var_names(["g"])
+        f.write_time(1, 0.0)
+        f.write_nodal_var(1, 1, [i, i, i])
+        f.write_global_var(1, 1, 10.0 * i)
+        f.close()
+        file_paths.append(file_path)
+
+    ens = exodusIIcpp.Ensemble(file_paths, max_open_files=2)
+    assert ens.get_num_members() == 3
+    assert ens.get_num_meshes() == 1
+    np.testing.assert_array_equal(ens.get_mesh(2).get_x_coords(), [0.0, 0.5, 1.0])
+    u = ens.read_nodal_variable(1, "u").reshape(3, -1)
+    np.testing.assert_array_equal(u, [[0, 0, 0], [1, 1, 1], [2, 2, 2]])
+    np.testing.assert_array_equal(ens.read_global_variable(1, "g"), [0.0, 10.0, 20.0])
+    assert ens.get_num_open_files() <= 2
+
+    threaded = exodusIIcpp.Ensemble(file_paths, max_open_files=2, n_threads=3)
+    assert threaded.get_num_meshes() == 1
+    assert threaded.get_mesh_fingerprint(2) == ens.get_mesh_fingerprint(2)
+
+
+def test_mesh_fingerprint(tmp_dir):
+    """Test mesh fingerprints."""
+    fingerprints = []
+    for i, y_top in enumerate([1.0, 1.0, 2.0]):
+        file_path = str(tmp_dir / f"fingerprint-{i}.e")
+        f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+        f.init("test", 2, 4, 1, 1, 0, 0)
+        f.write_coords([0, 1, 1, 0], [0, 0, y_top, y_top])
+        f.write_block(1, "QUAD4", 1, [1, 2, 3, 4])
+        f.write_info_with_fingerprint()
+        f.close()
+
+        g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+        assert g.mesh_fingerprint() == g.mesh_fingerprint(use_info_record=False)
+        assert g.mesh_fingerprint() == g.mesh_fingerprint(use_info_record=False, n_threads=4)
+        assert g.read_info()[0].startswith("mesh-fingerprint: ")
+        fingerprints.append(g.mesh_fingerprint())
+
+    assert fingerprints[0] == fingerprints[1]
+    assert fingerprints[0] != fingerprints[2]
+
+
+def test_copy_time_steps(tmp_dir):
+    """Test copying the mesh and a subset of time steps into another file."""
+    src_path = str(tmp_dir / "slice-src.e")
+    f = exodusIIcpp.File(src_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 1, 3, 2, 1, 0, 0)
+    f.write_coords([0.0, 0.5, 1.0])
+    f.write_block(1, "BAR2", 2, [1, 2, 2, 3])
+    f.write_nodal_var_names(["u", "v"])
+    f.write_global_var_names(["g1", "g2"])
+    for step in range(1, 5):
+        f.write_time(step, 0.1 * step)
+        f.write_nodal_var(step, 1, [step, step, step])
+        f.write_nodal_var(step, 2, [-step, -step, -step])
+        f.write_global_vars(step, [step, 2.0 * step])
+    f.close()
+
+    src = exodusIIcpp.File(src_path, exodusIIcpp.FileAccess.READ)
+    dest_path = str(tmp_dir / "slice.e")
+    dest = exodusIIcpp.File(dest_path, exodusIIcpp.FileAccess.WRITE)
+    exodusIIcpp.copy_mesh(src, dest)
+    exodusIIcpp.copy_time_steps(src, dest, [1, 3], dropped_variables=["v", "g1"])
+    dest.close()
+
+    g = exodusIIcpp.File(dest_path, exodusIIcpp.FileAccess.READ)
+    g.read_times()
+    np.testing.assert_allclose(g.get_times(), [0.1, 0.3])
+    assert g.get_nodal_variable_names() == ["u"]
+    assert g.get_global_variable_names() == ["g2"]
+    np.testing.assert_array_equal(g.get_nodal_variable_values(2, 1), [3, 3, 3])
+    np.testing.assert_array_equal(g.get_global_variable_values(2), [6.0])
+
+
+def test_join_time_steps(tmp_dir):
+    """Test joining results of restarted runs along time."""
+    file_paths = []
+    for i, times in enumerate([[0.0, 1.0, 2.0], [1.5, 2.5]]):
+        file_path = str(tmp_dir / f"restart-{i}.e")
+        f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+        f.init("test", 1, 3, 2, 1, 0, 0)
+        f.write_coords([0.0, 0.5, 1.0])
+        f.write_block(1, "BAR2", 2, [1, 2, 2, 3])
+        f.write_nodal_var_names(["u"])
+        for step, t in enumerate(times, start=1):
+            f.write_time(step, t)
+            f.write_nodal_var(step, 1, [t, t, t])
+        f.close()
+        file_paths.append(file_path)
+
+    dest_path = str(tmp_dir / "joined.e")
+    dest = exodusIIcpp.File(dest_path, exodusIIcpp.FileAccess.WRITE)
+    exodusIIcpp.join_time_steps(file_paths, dest)
+    dest.close()
+
+    g = exodusIIcpp.File(dest_path, exodusIIcpp.FileAccess.READ)
+    g.read_times()
+    np.testing.assert_array_equal(g.get_times(), [0.0, 1.0, 1.5, 2.5])
+    np.testing.assert_array_equal(g.get_nodal_variable_values(3, 1), [1.5, 1.5, 1.5])
+
+
+def test_decomposition(tmp_dir):
+    """Test decomposing a mesh into Nemesis files."""
+    file_path = str(tmp_dir / "strip.e")
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 2, 8, 3, 1, 0, 0)
+    x = [0.0, 1.0, 2.0, 3.0, 0.0, 1.0, 2.0, 3.0]
+    y = [0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0]
+    f.write_coords(x, y)
+    f.write_block(1, "QUAD4", 3, [1, 2, 6, 5, 2, 3, 7, 6, 3, 4, 8, 7])
+    f.close()
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    f.read()
+    dd = exodusIIcpp.Decomposition(f, 3)
+    np.testing.assert_array_equal(dd.get_element_parts(), [0, 1, 2])
+    dd.write(f, file_path, n_threads=2)
+
+    part_path = exodusIIcpp.Decomposition.get_part_file_path(file_path, 3, 1)
+    assert str(part_path) == file_path + ".3.1"
+    g = exodusIIcpp.File(part_path, exodusIIcpp.FileAccess.READ)
+    g.read_node_id_map()
+    g.read_elem_id_map()
+    np.testing.assert_array_equal(g.get_node_id_map().get_ids(), [2, 3, 6, 7])
+    np.testing.assert_array_equal(g.get_elem_id_map().get_ids(), [2])
+
+
+def test_join_parts(tmp_dir):
+    """Test joining the parts of a decomposed run."""
+    file_path = str(tmp_dir / "bar.e")
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 1, 5, 4, 1, 0, 0)
+    f.write_coords([0.0, 1.0, 2.0, 3.0, 4.0])
+    f.write_block(1, "BAR2", 4, [1, 2, 2, 3, 3, 4, 4, 5])
+    f.close()
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    f.read()
+    exodusIIcpp.Decomposition(f, 2).write(f, file_path)
+
+    part_paths = []
+    for part in range(2):
+        part_path = exodusIIcpp.Decomposition.get_part_file_path(file_path, 2, part)
+        p = exodusIIcpp.File(part_path, exodusIIcpp.FileAccess.APPEND)
+        p.read_node_id_map()
+        x = p.get_node_id_map().get_ids().astype(float)
+        p.write_nodal_var_names(["u"])
+        p.write_time(1, 0.5)
+        p.write_nodal_var(1, 1, x)
+        p.close()
+        part_paths.append(part_path)
+
+    dest_path = str(tmp_dir / "bar-joined.e")
+    dest = exodusIIcpp.File(dest_path, exodusIIcpp.FileAccess.WRITE)
+    exodusIIcpp.join_parts(part_paths, dest, n_threads=2)
+    dest.close()
+
+    g = exodusIIcpp.File(dest_path, exodusIIcpp.FileAccess.READ)
+    assert g.mesh_fingerprint() == f.mesh_fingerprint()
+    np.testing.assert_array_equal(g.get_nodal_variable_values(1, 1), [1, 2, 3, 4, 5])
+
+
+def test_append_step(tmp_dir):
+    """Test appending whole time steps to an existing file."""
+    file_path = str(tmp_dir / "append_step.e")
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 2, 3, 1, 1, 0, 0)
+    f.write_coords([0, 1, 0], [0, 0, 1])
+    f.write_block(1, "TRI3", 1, [1, 2, 3])
+    f.write_nodal_var_names(["u"])
+    f.write_elem_var_names(["e"])
+    f.write_global_var_names(["g"])
+    f.write_time(1, 0.0)
+    f.close()
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.APPEND)
+    assert f.get_num_times() == 1
+    assert f.get_nodal_variable_names() == ["u"]
+    u = np.array([1.0, 2.0, 3.0])
+    assert f.append_step(0.5, [u], [np.array([4.0])], np.array([5.0])) == 2
+    assert f.get_num_times() == 2
+    with pytest.raises(RuntimeError):
+        f.append_step(1.0, [], [np.array([4.0])], np.array([5.0]))
+    f.close()
+
+    g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    g.read_times()
+    np.testing.assert_array_equal(g.get_times(), [0.0, 0.5])
+    np.testing.assert_array_equal(g.get_nodal_variable_values(2, 1), u)
+    np.testing.assert_array_equal(g.get_elemental_variable_values(2, 1), [4.0])
+    np.testing.assert_array_equal(g.get_global_variable_values(2), [5.0])
+
+
+def test_step_writer(tmp_dir):
+    """Test writing whole time steps from views of NumPy arrays."""
+    file_path = str(tmp_dir / "step_writer.e")
+
+    f = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.WRITE)
+    f.init("test", 2, 3, 1, 1, 0, 0)
+    f.write_coords([0, 1, 0], [0, 0, 1])
+    f.write_block(1, "TRI3", 1, [1, 2, 3])
+    f.write_nodal_var_names(["u"])
+    f.write_elem_var_names(["e"])
+    f.write_global_var_names(["g1", "g2"])
+
+    u = np.zeros(3)
+    e = np.zeros(1)
+    glob = np.zeros(2)
+    writer = exodusIIcpp.StepWriter(f)
+    writer.add_global_vars(glob)
+    writer.add_nodal_var(1, u)
+    writer.add_elem_var(1, 1, e)
+    for step in (1, 2):
+        u[:] = step
+        e[:] = 10 * step
+        glob[:] = [20 * step, 30 * step]
+        writer.write(step, 0.5 * step)
+    f.close()
+
+    g = exodusIIcpp.File(file_path, exodusIIcpp.FileAccess.READ)
+    g.read_times()
+    np.testing.assert_array_equal(g.get_times(), [0.5, 1.0])
+    np.testing.assert_array_equal(g.get_nodal_variable_values(2, 1), [2, 2, 2])
+    np.testing.assert_array_equal(g.get_elemental_variable_values(2, 1), [20])
+    np.testing.assert_array_equal(g.get_global_variable_values(2), [40, 60])
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/connectivity.h"
+#include "exodusIIcpp/exception.h"
+#include <utility>
+
+namespace exodusIIcpp {
+
+Connectivity::Connectivity() : offsets(1, 0) {}
+
+int64_t
+Connectivity::get_num_elements() const
+{
+    return static_cast<int64_t>(this->offsets.size()) - 1;
+}
+
+Span<const int>
+Connectivity::get_element_nodes(int64_t elem_idx) const
+{
+    if (elem_idx >= 0 && elem_idx < get_num_elements()) {
+        auto begin = this->offsets[elem_idx];
+        auto end = this->offsets[elem_idx + 1];
+        return Span<const int>(this->node_ids.data() + begin, end - begin);
+    }
+    else
+        throw Exception("Index of out bounds.");
+}
+
+const std::string &
+Connectivity::get_element_type(int64_t elem_idx) const
+{
+    if (elem_idx >= 0 && elem_idx < get_num_elements())
+        return this->elem_types[this->type_tags[elem_idx]];
+    else
+        throw Exception("Index of out bounds.");
+}
+
+const std::vector<int64_t> &
+Connectivity::get_offsets() const
+{
+    return this->offsets;
+}
+
+const std::vector<int> &
+Connectivity::get_node_ids() const
+{
+    return this->node_ids;
+}
+
+const std::vector<int> &
+Connectivity::get_type_tags() const
+{
+    return this->type_tags;
+}
+
+const std::vector<std::string> &
+Connectivity::get_element_types() const
+{
+    return this->elem_types;
+}
+
+void
+Connectivity::set(std::vector<int64_t> offsets,
+                  std::vector<int> node_ids,
+                  std::vector<int> type_tags,
+                  std::vector<std::string> elem_types)
+{
+    if (offsets.empty() || type_tags.size() + 1 != offsets.size())
+        throw Exception("The number of offsets must be one more than the number of type tags.");
+    this->offsets = std::move(offsets);
+    this->node_ids = std::move(node_ids);
+    this->type_tags = std::move(type_tags);
+    this->elem_types = std::move(elem_types);
+}
+
+} // namespace exodusIIcpp
@@ -0,0 +1,820 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/copy.h"
+#include "exodusIIcpp/exception.h"
+#include "parallel.h"
+#include "fmt/printf.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace exodusIIcpp {
+
+/// Number of nodes or elements copied at once
+static const int64_t CHUNK_SIZE = 65536;
+
+/// Check if an ID map is the identity `1..n`
+static bool
+is_identity(const std::vector<int64_t> & ids)
+{
+    for (std::size_t i = 0; i < ids.size(); i++)
+        if (ids[i] != static_cast<int64_t>(i + 1))
+            return false;
+    return true;
+}
+
+/// Get names of entities ordered by their IDs, empty if none of the entities has a name
+static std::vector<std::string>
+ordered_names(const std::vector<int> & ids, const std::map<int, std::string> & name_map)
+{
+    std::vector<std::string> names;
+    bool have_names = false;
+    for (auto & id : ids) {
+        auto it = name_map.find(id);
+        names.push_back(it != name_map.end() ? it->second : std::string());
+        have_names |= !names.back().empty();
+    }
+    if (!have_names)
+        names.clear();
+    return names;
+}
+
+/// Variables copied from a source file
+///
+/// Indices (1-based) of the variables in the source file, ordered as the variables are stored in
+/// the destination file
+struct VariableSelection {
+    std::vector<int> nodal;
+    std::vector<int> elemental;
+    std::vector<int> global;
+};
+
+/// Get indices (1-based) of variables that are not dropped
+static std::vector<int>
+kept_variables(const std::vector<std::string> & names,
+               const std::vector<std::string> & dropped_variables)
+{
+    std::vector<int> idxs;
+    for (std::size_t i = 0; i < names.size(); i++)
+        if (std::find(dropped_variables.begin(), dropped_variables.end(), names[i]) ==
+            dropped_variables.end())
+            idxs.push_back(static_cast<int>(i + 1));
+    return idxs;
+}
+
+/// Get indices (1-based) of variables with given names
+static std::vector<int>
+find_variables(const std::vector<std::string> & names,
+               const std::vector<std::string> & var_names,
+               const std::string & file_name)
+{
+    std::vector<int> idxs;
+    for (auto & var_name : var_names) {
+        auto it = std::find(names.begin(), names.end(), var_name);
+        if (it == names.end())
+            throw Exception(fmt::sprintf("Variable '%s' not found in '%s'.", var_name, file_name));
+        idxs.push_back(static_cast<int>(it - names.begin()) + 1);
+    }
+    return idxs;
+}
+
+static std::vector<std::string>
+select_names(const std::vector<std::string> & names, const std::vector<int> & idxs)
+{
+    std::vector<std::string> selected;
+    for (auto & idx : idxs)
+        selected.push_back(names[idx - 1]);
+    return selected;
+}
+
+/// Select variables that are not dropped
+static VariableSelection
+select_variables(const File & src, const std::vector<std::string> & dropped_variables)
+{
+    auto nodal_names = src.get_nodal_variable_names();
+    auto elem_names = src.get_elemental_variable_names();
+    auto global_names = src.get_global_variable_names();
+    for (auto & name : dropped_variables)
+        if (std::find(nodal_names.begin(), nodal_names.end(), name) == nodal_names.end() &&
+            std::find(elem_names.begin(), elem_names.end(), name) == elem_names.end() &&
+            std::find(global_names.begin(), global_names.end(), name) == global_names.end())
+            throw Exception(fmt::sprintf("Variable '%s' not found.", name));
+
+    VariableSelection sel;
+    sel.nodal = kept_variables(nodal_names, dropped_variables);
+    sel.elemental = kept_variables(elem_names, dropped_variables);
+    sel.global = kept_variables(global_names, dropped_variables);
+    return sel;
+}
+
+/// Get the truth table of the selected elemental variables
+static std::vector<int>
+select_truth_table(const File & src, const std::vector<int> & elemental)
+{
+    auto n_blks = src.get_element_block_ids().size();
+    auto src_truth_tab = src.read_elem_var_truth_table();
+    auto n_src_vars = n_blks > 0 ? src_truth_tab.size() / n_blks : 0;
+    std::vector<int> truth_tab;
+    for (std::size_t i = 0; i < n_blks; i++)
+        for (auto & idx : elemental)
+            truth_tab.push_back(src_truth_tab[i * n_src_vars + idx - 1]);
+    return truth_tab;
+}
+
+/// Define the selected variables in the destination file
+///
+/// @return Truth table of the destination file
+static std::vector<int>
+define_variables(const File & src, File & dest, const VariableSelection & sel)
+{
+    if (!sel.nodal.empty())
+        dest.write_nodal_var_names(select_names(src.get_nodal_variable_names(), sel.nodal));
+    if (!sel.elemental.empty())
+        dest.write_elem_var_names(select_names(src.get_elemental_variable_names(), sel.elemental));
+    if (!sel.global.empty())
+        dest.write_global_var_names(select_names(src.get_global_variable_names(), sel.global));
+
+    auto truth_tab = select_truth_table(src, sel.elemental);
+    if (!truth_tab.empty())
+        dest.write_elem_var_truth_table(truth_tab);
+    return truth_tab;
+}
+
+/// Get the number of elements in each element block
+static std::vector<int64_t>
+block_sizes(const File & file)
+{
+    std::vector<int64_t> n_blk_elems;
+    for (auto & id : file.get_element_block_ids())
+        n_blk_elems.push_back(file.read_block_info(id).get_num_elements());
+    return n_blk_elems;
+}
+
+/// Get the number of time steps transferred at once
+///
+/// A transfer covers as many whole storage chunks as fit into `max_buffered_values` values. If not
+/// even one chunk fits, time steps are transferred one at a time.
+static int64_t
+steps_per_transfer(int steps_per_chunk, int64_t n_values, int64_t max_buffered_values)
+{
+    auto chunk_size = std::max<int64_t>(1, n_values) * steps_per_chunk;
+    if (chunk_size > max_buffered_values)
+        return 1;
+    return max_buffered_values / chunk_size * steps_per_chunk;
+}
+
+/// Copy the selected variables over consecutive time steps `first_step..last_step`
+///
+/// Nodal and elemental variables are read one time step at a time, or, if whole storage chunks of
+/// `src` fit into `max_buffered_values` values, in ranges of time steps that start and end at the
+/// chunk boundaries, so that every chunk is read and decompressed once. They are written one time
+/// step at a time. All global variables of a time step are copied at once. `buffer` is reused for
+/// all transfers.
+static void
+copy_steps(const File & src,
+           int first_step,
+           int last_step,
+           File & dest,
+           int first_dest_step,
+           const VariableSelection & sel,
+           const std::vector<int> & truth_tab,
+           const std::vector<int64_t> & n_blk_elems,
+           int64_t max_buffered_values,
+           std::vector<double> & buffer)
+{
+    auto dest_step = [&](int64_t step) {
+        return static_cast<int>(first_dest_step + step - first_step);
+    };
+
+    if (!sel.global.empty()) {
+        std::vector<double> selected(sel.global.size());
+        for (int step = first_step; step <= last_step; step++) {
+            auto vals = src.get_global_variable_values(step);
+            for (std::size_t j = 0; j < sel.global.size(); j++)
+                selected[j] = vals[sel.global[j] - 1];
+            dest.write_global_vars(dest_step(step), selected);
+        }
+    }
+
+    // `read(begin, end)` fills `buffer` with time steps `begin..end`, `write(step, values)` writes
+    // one of them
+    auto transfer = [&](int steps_per_chunk, int64_t n_values, auto && read, auto && write) {
+        auto n_steps = steps_per_transfer(steps_per_chunk, n_values, max_buffered_values);
+        for (int64_t begin = first_step; begin <= last_step;) {
+            auto end = std::min<int64_t>(last_step, ((begin - 1) / n_steps + 1) * n_steps);
+            read(static_cast<int>(begin), static_cast<int>(end));
+            for (auto step = begin; step <= end; step++)
+                write(dest_step(step),
+                      Span<const double>(buffer.data() + (step - begin) * n_values, n_values));
+            begin = end + 1;
+        }
+    };
+
+    auto n_nodes = src.get_num_nodes();
+    for (std::size_t j = 0; j < sel.nodal.size(); j++) {
+        auto var_idx = sel.nodal[j];
+        transfer(
+            src.get_nodal_variable_steps_per_chunk(var_idx),
+            n_nodes,
+            [&](int begin, int end) { src.get_nodal_variable_steps(var_idx, begin, end, buffer); },
+            [&](int step, Span<const double> values) {
+                dest.write_nodal_var(step, static_cast<int>(j + 1), values);
+            });
+    }
+
+    auto & blk_ids = src.get_element_block_ids();
+    for (std::size_t j = 0; j < sel.elemental.size(); j++)
+        for (std::size_t i = 0; i < blk_ids.size(); i++) {
+            if (n_blk_elems[i] == 0 || !truth_tab[i * sel.elemental.size() + j])
+                continue;
+            auto var_idx = sel.elemental[j];
+            auto blk_id = blk_ids[i];
+            transfer(
+                src.get_elemental_variable_steps_per_chunk(var_idx, blk_id),
+                n_blk_elems[i],
+                [&](int begin, int end) {
+                    src.get_elemental_variable_steps(var_idx, blk_id, begin, end, buffer);
+                },
+                [&](int step, Span<const double> values) {
+                    dest.write_elem_var(step, static_cast<int>(j + 1), blk_id, values);
+                });
+        }
+}
+
+/// Sort IDs and remove duplicates
+static void
+sort_unique(std::vector<int64_t> & ids)
+{
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+/// Get the position of an ID in a sorted list
+static int64_t
+find_index(const std::vector<int64_t> & sorted_ids, int64_t id)
+{
+    return std::lower_bound(sorted_ids.begin(), sorted_ids.end(), id) - sorted_ids.begin();
+}
+
+/// Mapping of a part of a decomposed mesh into the joined mesh
+struct PartMap {
+    /// Index (0-based) of each local node in the joined mesh
+    std::vector<int64_t> nodes;
+    /// Local (0-based) indices of nodes whose values are taken from this part. A node shared by
+    /// several parts is owned by the first one, so that each value is written by one thread only.
+    std::vector<int64_t> owned_nodes;
+    /// Index (0-based) of each local element within its element block of the joined mesh, per
+    /// element block
+    std::vector<std::vector<int64_t>> blk_elems;
+    /// Variables of the part matching the variables of the joined file
+    VariableSelection sel;
+    /// Truth table of the part for the variables of the joined file
+    std::vector<int> truth_tab;
+};
+
+/// Build the numbering of the joined mesh from the ID maps of the parts
+///
+/// Nodes are ordered by their IDs, elements by their element blocks and then by their IDs.
+///
+/// @return Block IDs
+static std::vector<int>
+build_part_maps(const std::vector<fs::path> & part_paths,
+                std::vector<PartMap> & maps,
+                std::vector<int64_t> & node_ids,
+                std::vector<std::vector<int64_t>> & blk_elem_ids)
+{
+    std::vector<int> blk_ids;
+    std::vector<std::vector<int64_t>> part_node_ids(part_paths.size());
+    std::vector<std::vector<std::vector<int64_t>>> part_elem_ids(part_paths.size());
+    for (std::size_t p = 0; p < part_paths.size(); p++) {
+        File part(part_paths[p], FileAccess::READ);
+        if (p == 0) {
+            blk_ids = part.get_element_block_ids();
+            blk_elem_ids.resize(blk_ids.size());
+        }
+        else if (part.get_element_block_ids() != blk_ids)
+            throw Exception(fmt::sprintf("Element blocks of '%s' differ from those of '%s'.",
+                                         part_paths[p].string(),
+                                         part_paths[0].string()));
+
+        part.read_node_id_map();
+        part_node_ids[p] = part.get_node_id_map().get_ids();
+        node_ids.insert(node_ids.end(), part_node_ids[p].begin(), part_node_ids[p].end());
+
+        part.read_elem_id_map();
+        auto & elem_ids = part.get_elem_id_map().get_ids();
+        auto it = elem_ids.begin();
+        for (std::size_t b = 0; b < blk_ids.size(); b++) {
+            auto n_blk_elems = part.read_block_info(blk_ids[b]).get_num_elements();
+            part_elem_ids[p].emplace_back(it, it + n_blk_elems);
+            blk_elem_ids[b].insert(blk_elem_ids[b].end(), it, it + n_blk_elems);
+            it += n_blk_elems;
+        }
+    }
+
+    sort_unique(node_ids);
+    for (auto & ids : blk_elem_ids)
+        sort_unique(ids);
+
+    std::vector<bool> owned(node_ids.size(), false);
+    for (std::size_t p = 0; p < part_paths.size(); p++) {
+        auto & map = maps[p];
+        for (std::size_t i = 0; i < part_node_ids[p].size(); i++) {
+            auto idx = find_index(node_ids, part_node_ids[p][i]);
+            map.nodes.push_back(idx);
+            if (!owned[idx]) {
+                owned[idx] = true;
+                map.owned_nodes.push_back(static_cast<int64_t>(i));
+            }
+        }
+        map.blk_elems.resize(blk_ids.size());
+        for (std::size_t b = 0; b < blk_ids.size(); b++)
+            for (auto & id : part_elem_ids[p][b])
+                map.blk_elems[b].push_back(find_index(blk_elem_ids[b], id));
+    }
+    return blk_ids;
+}
+
+/// Assemble the mesh of the joined file from the parts and write it
+static void
+join_meshes(const std::vector<fs::path> & part_paths,
+            const std::vector<PartMap> & maps,
+            const std::vector<int> & blk_ids,
+            const std::vector<int64_t> & node_ids,
+            const std::vector<std::vector<int64_t>> & blk_elem_ids,
+            File & dest)
+{
+    auto n_nodes = static_cast<int64_t>(node_ids.size());
+    std::vector<int64_t> blk_ofst(1, 0);
+    for (auto & ids : blk_elem_ids)
+        blk_ofst.push_back(blk_ofst.back() + static_cast<int64_t>(ids.size()));
+
+    File first(part_paths[0], FileAccess::READ);
+    int dim = first.get_dim();
+    std::vector<double> coords[3];
+    for (int d = 0; d < dim; d++)
+        coords[d].resize(n_nodes);
+    std::vector<ElementBlock> blocks(blk_ids.size());
+    std::vector<std::vector<int>> connect(blk_ids.size());
+    std::map<int, std::vector<int64_t>> node_sets;
+    std::map<int, std::vector<std::pair<int64_t, int>>> side_sets;
+    std::map<int, std::string> blk_names, ns_names, ss_names;
+    for (std::size_t p = 0; p < part_paths.size(); p++) {
+        File part(part_paths[p], FileAccess::READ);
+        auto & map = maps[p];
+        part.read_coords();
+        const std::vector<double> * part_coords[3] = { &part.get_x_coords(),
+                                                       &part.get_y_coords(),
+                                                       &part.get_z_coords() };
+        for (int d = 0; d < dim; d++)
+            for (auto & i : map.owned_nodes)
+                coords[d][map.nodes[i]] = (*part_coords[d])[i];
+
+        for (std::size_t b = 0; b < blk_ids.size(); b++) {
+            auto eb = part.read_block_info(blk_ids[b]);
+            int n_per_elem = eb.get_num_nodes_per_element();
+            if (p == 0) {
+                blocks[b] = eb;
+                connect[b].resize(blk_elem_ids[b].size() * n_per_elem);
+            }
+            std::vector<int> part_connect;
+            part.read_partial_connectivity(blk_ids[b], 0, eb.get_num_elements(), part_connect);
+            for (std::size_t e = 0; e < map.blk_elems[b].size(); e++)
+                for (int k = 0; k < n_per_elem; k++)
+                    connect[b][map.blk_elems[b][e] * n_per_elem + k] =
+                        static_cast<int>(map.nodes[part_connect[e * n_per_elem + k] - 1] + 1);
+        }
+
+        for (auto & id : part.read_node_set_ids()) {
+            auto ns = part.read_node_set(id);
+            auto & nodes = node_sets[id];
+            for (auto & node_id : ns.get_node_ids())
+                nodes.push_back(map.nodes[node_id - 1] + 1);
+        }
+        for (auto & id : part.read_side_set_ids()) {
+            auto ss = part.read_side_set(id);
+            auto & sides = side_sets[id];
+            auto & elem_list = ss.get_element_ids();
+            auto & side_list = ss.get_side_ids();
+            for (std::size_t i = 0; i < elem_list.size(); i++) {
+                auto [b, e] = part.get_local_element_index(elem_list[i] - 1);
+                sides.emplace_back(blk_ofst[b] + map.blk_elems[b][e] + 1, side_list[i]);
+            }
+        }
+        for (auto & [id, name] : part.read_block_names())
+            if (!name.empty())
+                blk_names[id] = name;
+        for (auto & [id, name] : part.read_node_set_names())
+            if (!name.empty())
+                ns_names[id] = name;
+        for (auto & [id, name] : part.read_side_set_names())
+            if (!name.empty())
+                ss_names[id] = name;
+    }
+
+    dest.init(first.get_title().c_str(),
+              dim,
+              static_cast<int>(n_nodes),
+              static_cast<int>(blk_ofst.back()),
+              static_cast<int>(blk_ids.size()),
+              static_cast<int>(node_sets.size()),
+              static_cast<int>(side_sets.size()));
+    auto info = first.read_info();
+    if (!info.empty())
+        dest.write_info(info);
+    first.read_coord_names();
+    dest.write_coord_names(first.get_coord_names());
+    for (std::size_t b = 0; b < blk_ids.size(); b++)
+        dest.write_block_info(blk_ids[b],
+                              blocks[b].get_element_type().c_str(),
+                              static_cast<int64_t>(blk_elem_ids[b].size()),
+                              blocks[b].get_num_nodes_per_element());
+    auto names = ordered_names(blk_ids, blk_names);
+    if (!names.empty())
+        dest.write_block_names(names);
+
+    if (!is_identity(node_ids))
+        dest.write_node_id_map(node_ids);
+    std::vector<int64_t> elem_ids;
+    for (auto & ids : blk_elem_ids)
+        elem_ids.insert(elem_ids.end(), ids.begin(), ids.end());
+    if (!is_identity(elem_ids))
+        dest.write_elem_id_map(elem_ids);
+
+    if (dim == 1)
+        dest.write_coords(coords[0]);
+    else if (dim == 2)
+        dest.write_coords(coords[0], coords[1]);
+    else
+        dest.write_coords(coords[0], coords[1], coords[2]);
+    for (std::size_t b = 0; b < blk_ids.size(); b++)
+        dest.write_partial_connectivity(blk_ids[b],
+                                        0,
+                                        static_cast<int64_t>(blk_elem_ids[b].size()),
+                                        connect[b]);
+
+    // shared nodes are listed by each part that has them
+    std::vector<int> set_ids;
+    for (auto & [id, nodes] : node_sets) {
+        sort_unique(nodes);
+        dest.write_node_set(id, std::vector<int>(nodes.begin(), nodes.end()));
+        set_ids.push_back(id);
+    }
+    names = ordered_names(set_ids, ns_names);
+    if (!names.empty())
+        dest.write_node_set_names(names);
+
+    set_ids.clear();
+    for (auto & [id, sides] : side_sets) {
+        std::sort(sides.begin(), sides.end());
+        std::vector<int> elem_list, side_list;
+        for (auto & [elem, side] : sides) {
+            elem_list.push_back(static_cast<int>(elem));
+            side_list.push_back(side);
+        }
+        dest.write_side_set(id, elem_list, side_list);
+        set_ids.push_back(id);
+    }
+    names = ordered_names(set_ids, ss_names);
+    if (!names.empty())
+        dest.write_side_set_names(names);
+}
+
+void
+copy_mesh(File & src, File & dest)
+{
+    int dim = src.get_dim();
+    int64_t n_nodes = src.get_num_nodes();
+    auto & blk_ids = src.get_element_block_ids();
+    auto ns_ids = src.read_node_set_ids();
+    auto ss_ids = src.read_side_set_ids();
+    dest.init(src.get_title().c_str(),
+              dim,
+              static_cast<int>(n_nodes),
+              src.get_num_elements(),
+              static_cast<int>(blk_ids.size()),
+              static_cast<int>(ns_ids.size()),
+              static_cast<int>(ss_ids.size()));
+
+    // Element blocks are defined before any bulk data is written, so that netCDF does not have to
+    // re-enter the define mode (and possibly move the data already in the file) for each block
+    auto info = src.read_info();
+    if (!info.empty())
+        dest.write_info(info);
+    src.read_coord_names();
+    dest.write_coord_names(src.get_coord_names());
+    std::vector<int64_t> n_blk_elems;
+    for (auto & id : blk_ids) {
+        auto eb = src.read_block_info(id);
+        n_blk_elems.push_back(eb.get_num_elements());
+        dest.write_block_info(id,
+                              eb.get_element_type().c_str(),
+                              eb.get_num_elements(),
+                              eb.get_num_nodes_per_element());
+    }
+    auto blk_names = ordered_names(blk_ids, src.read_block_names());
+    if (!blk_names.empty())
+        dest.write_block_names(blk_names);
+
+    src.read_node_id_map();
+    if (!is_identity(src.get_node_id_map().get_ids()))
+        dest.write_node_id_map(src.get_node_id_map().get_ids());
+    src.read_elem_id_map();
+    if (!is_identity(src.get_elem_id_map().get_ids()))
+        dest.write_elem_id_map(src.get_elem_id_map().get_ids());
+
+    std::vector<double> x, y, z;
+    for (int64_t start = 0; start < n_nodes; start += CHUNK_SIZE) {
+        auto count = std::min(CHUNK_SIZE, n_nodes - start);
+        src.read_partial_coords(start, count, x, y, z);
+        dest.write_partial_coords(start, x, y, z);
+    }
+
+    std::vector<int> connect;
+    for (std::size_t i = 0; i < blk_ids.size(); i++) {
+        for (int64_t start = 0; start < n_blk_elems[i]; start += CHUNK_SIZE) {
+            auto count = std::min(CHUNK_SIZE, n_blk_elems[i] - start);
+            src.read_partial_connectivity(blk_ids[i], start, count, connect);
+            if (!connect.empty())
+                dest.write_partial_connectivity(blk_ids[i], start, count, connect);
+        }
+    }
+
+    for (auto & id : ns_ids)
+        dest.write_node_set(id, src.read_node_set(id).get_node_ids());
+    auto ns_names = ordered_names(ns_ids, src.read_node_set_names());
+    if (!ns_names.empty())
+        dest.write_node_set_names(ns_names);
+
+    for (auto & id : ss_ids) {
+        auto ss = src.read_side_set(id);
+        dest.write_side_set(id, ss.get_element_ids(), ss.get_side_ids());
+    }
+    auto ss_names = ordered_names(ss_ids, src.read_side_set_names());
+    if (!ss_names.empty())
+        dest.write_side_set_names(ss_names);
+}
+
+void
+copy_time_steps(File & src,
+                File & dest,
+                const std::vector<int> & time_steps,
+                const std::vector<std::string> & dropped_variables,
+                int64_t max_buffered_values)
+{
+    int n_times = src.get_num_times();
+    for (auto & step : time_steps)
+        if (step < 1 || step > n_times)
+            throw Exception(fmt::sprintf("Time step %d is out of range [1, %d].", step, n_times));
+
+    auto sel = select_variables(src, dropped_variables);
+    auto truth_tab = define_variables(src, dest, sel);
+    auto n_blk_elems = block_sizes(src);
+
+    src.read_times();
+    auto & times = src.get_times();
+    for (std::size_t k = 0; k < time_steps.size(); k++)
+        dest.write_time(static_cast<int>(k + 1), times[time_steps[k] - 1]);
+
+    // runs of consecutive time steps are copied together
+    std::vector<double> buffer;
+    for (std::size_t k = 0; k < time_steps.size();) {
+        auto n = 1;
+        while (k + n < time_steps.size() && time_steps[k + n] == time_steps[k + n - 1] + 1)
+            n++;
+        copy_steps(src,
+                   time_steps[k],
+                   time_steps[k + n - 1],
+                   dest,
+                   static_cast<int>(k + 1),
+                   sel,
+                   truth_tab,
+                   n_blk_elems,
+                   max_buffered_values,
+                   buffer);
+        k += n;
+    }
+}
+
+void
+join_time_steps(const std::vector<fs::path> & file_paths,
+                File & dest,
+                const std::vector<std::string> & dropped_variables,
+                int64_t max_buffered_values)
+{
+    if (file_paths.empty())
+        throw Exception("No files to join.");
+
+    // the first pass checks the meshes and reads the time values
+    uint64_t fingerprint = 0;
+    std::vector<std::vector<double>> times(file_paths.size());
+    for (std::size_t i = 0; i < file_paths.size(); i++) {
+        File src(file_paths[i], FileAccess::READ);
+        if (i == 0)
+            fingerprint = src.mesh_fingerprint();
+        else if (src.mesh_fingerprint() != fingerprint)
+            throw Exception(fmt::sprintf("Mesh of '%s' differs from the mesh of '%s'.",
+                                         file_paths[i].string(),
+                                         file_paths[0].string()));
+        src.read_times();
+        times[i] = src.get_times();
+    }
+
+    // a later file takes over from its first time on, so that steps recomputed after a restart
+    // replace the ones from the run that was restarted
+    std::vector<double> cutoff(file_paths.size(), std::numeric_limits<double>::infinity());
+    for (std::size_t i = file_paths.size() - 1; i > 0; i--)
+        cutoff[i - 1] = times[i].empty() ? cutoff[i] : std::min(cutoff[i], times[i].front());
+
+    std::vector<std::string> nodal_names, elem_names, global_names;
+    std::vector<int> blk_ids;
+    std::vector<int> truth_tab;
+    std::vector<int64_t> n_blk_elems;
+    std::vector<double> buffer;
+    int dest_step = 0;
+    for (std::size_t i = 0; i < file_paths.size(); i++) {
+        File src(file_paths[i], FileAccess::READ);
+        VariableSelection sel;
+        if (i == 0) {
+            copy_mesh(src, dest);
+            sel = select_variables(src, dropped_variables);
+            truth_tab = define_variables(src, dest, sel);
+            blk_ids = src.get_element_block_ids();
+            n_blk_elems = block_sizes(src);
+            nodal_names = select_names(src.get_nodal_variable_names(), sel.nodal);
+            elem_names = select_names(src.get_elemental_variable_names(), sel.elemental);
+            global_names = select_names(src.get_global_variable_names(), sel.global);
+        }
+        else {
+            auto file_name = file_paths[i].string();
+            if (src.get_element_block_ids() != blk_ids || block_sizes(src) != n_blk_elems)
+                throw Exception(fmt::sprintf("Element blocks of '%s' differ from the element "
+                                             "blocks of '%s'.",
+                                             file_name,
+                                             file_paths[0].string()));
+            sel.nodal = find_variables(src.get_nodal_variable_names(), nodal_names, file_name);
+            sel.elemental =
+                find_variables(src.get_elemental_variable_names(), elem_names, file_name);
+            sel.global = find_variables(src.get_global_variable_names(), global_names, file_name);
+            if (select_truth_table(src, sel.elemental) != truth_tab)
+                throw Exception(fmt::sprintf("Elemental variables of '%s' are defined on other "
+                                             "element blocks than in '%s'.",
+                                             file_name,
+                                             file_paths[0].string()));
+        }
+
+        int n_steps = 0;
+        while (n_steps < static_cast<int>(times[i].size()) && times[i][n_steps] < cutoff[i])
+            n_steps++;
+        for (int k = 0; k < n_steps; k++)
+            dest.write_time(dest_step + k + 1, times[i][k]);
+        if (n_steps > 0)
+            copy_steps(src,
+                       1,
+                       n_steps,
+                       dest,
+                       dest_step + 1,
+                       sel,
+                       truth_tab,
+                       n_blk_elems,
+                       max_buffered_values,
+                       buffer);
+        dest_step += n_steps;
+    }
+}
+
+void
+join_parts(const std::vector<fs::path> & part_paths,
+           File & dest,
+           const std::vector<std::string> & dropped_variables,
+           unsigned int n_threads)
+{
+    if (part_paths.empty())
+        throw Exception("No files to join.");
+
+    auto n_parts = part_paths.size();
+    std::vector<PartMap> maps(n_parts);
+    std::vector<int64_t> node_ids;
+    std::vector<std::vector<int64_t>> blk_elem_ids;
+    auto blk_ids = build_part_maps(part_paths, maps, node_ids, blk_elem_ids);
+    join_meshes(part_paths, maps, blk_ids, node_ids, blk_elem_ids, dest);
+
+    // parts stay open while time steps are streamed, each time step is read from all of them
+    std::vector<std::unique_ptr<File>> parts;
+    for (auto & path : part_paths)
+        parts.push_back(std::make_unique<File>(path, FileAccess::READ));
+
+    auto & first = *parts[0];
+    auto sel = select_variables(first, dropped_variables);
+    auto nodal_names = select_names(first.get_nodal_variable_names(), sel.nodal);
+    auto elem_names = select_names(first.get_elemental_variable_names(), sel.elemental);
+    auto global_names = select_names(first.get_global_variable_names(), sel.global);
+    if (!nodal_names.empty())
+        dest.write_nodal_var_names(nodal_names);
+    if (!elem_names.empty())
+        dest.write_elem_var_names(elem_names);
+    if (!global_names.empty())
+        dest.write_global_var_names(global_names);
+
+    // an elemental variable is defined on a block of the joined mesh if any part defines it
+    auto n_blks = blk_ids.size();
+    auto n_elem_vars = elem_names.size();
+    int n_times = first.get_num_times();
+    std::vector<int> truth_tab(n_blks * n_elem_vars, 0);
+    for (std::size_t p = 0; p < n_parts; p++) {
+        auto & part = *parts[p];
+        auto & map = maps[p];
+        auto file_name = part_paths[p].string();
+        if (part.get_num_times() != n_times)
+            throw Exception(fmt::sprintf("'%s' has %d time steps, '%s' has %d.",
+                                         file_name,
+                                         part.get_num_times(),
+                                         part_paths[0].string(),
+                                         n_times));
+        map.sel.nodal = find_variables(part.get_nodal_variable_names(), nodal_names, file_name);
+        map.sel.elemental =
+            find_variables(part.get_elemental_variable_names(), elem_names, file_name);
+        auto part_truth_tab = part.read_elem_var_truth_table();
+        auto n_part_vars = part.get_elemental_variable_names().size();
+        map.truth_tab.resize(n_blks * n_elem_vars);
+        for (std::size_t b = 0; b < n_blks; b++)
+            for (std::size_t j = 0; j < n_elem_vars; j++) {
+                auto k = b * n_elem_vars + j;
+                map.truth_tab[k] = !map.blk_elems[b].empty() &&
+                                   part_truth_tab[b * n_part_vars + map.sel.elemental[j] - 1];
+                truth_tab[k] |= map.truth_tab[k];
+            }
+    }
+    if (!truth_tab.empty())
+        dest.write_elem_var_truth_table(truth_tab);
+
+    // the ExodusII library is not thread-safe, so the threads take turns reading, and scatter the
+    // values into the joined variables while other threads read
+    std::mutex io_mutex;
+    std::vector<std::vector<double>> nodal(nodal_names.size());
+    for (auto & vals : nodal)
+        vals.resize(node_ids.size());
+    // elements of parts that do not define a variable on a block keep NaN
+    std::vector<std::vector<double>> elemental(n_blks * n_elem_vars);
+    for (std::size_t b = 0; b < n_blks; b++)
+        for (std::size_t j = 0; j < n_elem_vars; j++)
+            elemental[b * n_elem_vars + j].resize(blk_elem_ids[b].size(),
+                                                  std::numeric_limits<double>::quiet_NaN());
+    first.read_times();
+    std::vector<double> buffer;
+    std::vector<std::vector<double>> part_buffers(n_parts);
+    for (int step = 1; step <= n_times; step++) {
+        dest.write_time(step, first.get_times()[step - 1]);
+        if (!sel.global.empty()) {
+            auto vals = first.get_global_variable_values(step);
+            buffer.resize(sel.global.size());
+            for (std::size_t j = 0; j < sel.global.size(); j++)
+                buffer[j] = vals[sel.global[j] - 1];
+            dest.write_global_vars(step, buffer);
+        }
+
+        internal::parallel_for(n_parts, n_threads, [&](std::size_t p) {
+            auto & part = *parts[p];
+            auto & part_buffer = part_buffers[p];
+            auto & map = maps[p];
+            for (std::size_t j = 0; j < nodal.size(); j++) {
+                {
+                    std::lock_guard<std::mutex> lock(io_mutex);
+                    part.get_nodal_variable_values(step, map.sel.nodal[j], part_buffer);
+                }
+                for (auto & i : map.owned_nodes)
+                    nodal[j][map.nodes[i]] = part_buffer[i];
+            }
+            for (std::size_t b = 0; b < n_blks; b++)
+                for (std::size_t j = 0; j < n_elem_vars; j++) {
+                    if (!map.truth_tab[b * n_elem_vars + j])
+                        continue;
+                    {
+                        std::lock_guard<std::mutex> lock(io_mutex);
+                        part.get_elemental_variable_values(step,
+                                                           map.sel.elemental[j],
+                                                           blk_ids[b],
+                                                           part_buffer);
+                    }
+                    auto & vals = elemental[b * n_elem_vars + j];
+                    for (std::size_t e = 0; e < map.blk_elems[b].size(); e++)
+                        vals[map.blk_elems[b][e]] = part_buffer[e];
+                }
+        });
+
+        for (std::size_t j = 0; j < nodal.size(); j++)
+            dest.write_nodal_var(step, static_cast<int>(j + 1), nodal[j]);
+        for (std::size_t b = 0; b < n_blks; b++)
+            for (std::size_t j = 0; j < n_elem_vars; j++)
+                if (truth_tab[b * n_elem_vars + j] && !blk_elem_ids[b].empty())
+                    dest.write_elem_var(step,
+                                        static_cast<int>(j + 1),
+                                        blk_ids[b],
+                                        elemental[b * n_elem_vars + j]);
+    }
+}
+
+} // namespace exodusIIcpp
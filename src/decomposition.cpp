@@ -0,0 +1,525 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/decomposition.h"
+#include "exodusIIcpp/exception.h"
+#include "parallel.h"
+#include "topology.h"
+#include "fmt/format.h"
+#include "fmt/printf.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+namespace exodusIIcpp {
+
+using internal::SideKey;
+using internal::SideKeyHash;
+
+namespace {
+
+/// Element side shared with another part
+struct SharedSide {
+    /// Global (0-based) element index
+    int64_t elem;
+    /// Side index (0-based)
+    int side;
+    /// Part on the other side
+    int proc;
+};
+
+/// Data shared by all parts, lists are stored in compressed sparse row format
+struct Layout {
+    /// Global element index of the first element in each block, plus the total number of elements
+    std::vector<int64_t> blk_ofst;
+    /// Global element indices of each part
+    std::vector<int64_t> part_elem_ofst;
+    std::vector<int64_t> part_elems;
+    /// Parts using each node, in increasing order
+    std::vector<int64_t> node_part_ofst;
+    std::vector<int> node_parts;
+    /// Global node indices of each part, in increasing order
+    std::vector<int64_t> part_node_ofst;
+    std::vector<int64_t> part_nodes;
+    /// Element sides of each part shared with other parts
+    std::vector<int64_t> part_side_ofst;
+    std::vector<SharedSide> part_sides;
+};
+
+/// Find the block of an element
+///
+/// @param blk_ofst Global element index of the first element in each block
+/// @param elem Global (0-based) element index
+/// @return Block index
+std::size_t
+block_index(const std::vector<int64_t> & blk_ofst, int64_t elem)
+{
+    return std::upper_bound(blk_ofst.begin(), blk_ofst.end(), elem) - blk_ofst.begin() - 1;
+}
+
+/// Get the nodes of an element
+///
+/// @param blocks Element blocks
+/// @param blk_ofst Global element index of the first element in each block
+/// @param elem Global (0-based) element index
+/// @return Node IDs (1-based) of the element
+Span<const int>
+element_nodes(const std::vector<ElementBlock> & blocks,
+              const std::vector<int64_t> & blk_ofst,
+              int64_t elem)
+{
+    auto b = block_index(blk_ofst, elem);
+    return blocks[b].get_element_nodes(elem - blk_ofst[b]);
+}
+
+/// Turn counts into offsets of a compressed sparse row list
+void
+counts_to_offsets(std::vector<int64_t> & ofst)
+{
+    std::partial_sum(ofst.begin(), ofst.end(), ofst.begin());
+}
+
+/// Find element sides shared by elements of different parts
+///
+/// Sides of element types without a known topology are not matched.
+///
+/// @return Each shared side twice, once from either part
+std::vector<SharedSide>
+find_shared_sides(const std::vector<ElementBlock> & blocks,
+                  const std::vector<int64_t> & blk_ofst,
+                  const std::vector<int> & elem_parts)
+{
+    struct SideRef {
+        int64_t elem;
+        int side;
+    };
+
+    std::unordered_map<SideKey, SideRef, SideKeyHash> open_sides;
+    std::vector<SharedSide> shared;
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        auto & blk = blocks[b];
+        auto topo = internal::find_topology(blk.get_element_type());
+        int n_nodes_per_elem = blk.get_num_nodes_per_element();
+        if (topo == nullptr || n_nodes_per_elem < topo->n_corners)
+            continue;
+
+        const int * connect = blk.get_connectivity().data();
+        for (int64_t e = 0; e < blk_ofst[b + 1] - blk_ofst[b]; e++) {
+            const int * elem_nodes = connect + e * n_nodes_per_elem;
+            int64_t elem = blk_ofst[b] + e;
+            for (int s = 0; s < topo->n_sides; s++) {
+                auto key = internal::make_key(elem_nodes, topo->sides[s]);
+                auto res = open_sides.try_emplace(key, SideRef { elem, s });
+                if (res.second)
+                    continue;
+                auto other = res.first->second;
+                open_sides.erase(res.first);
+                if (elem_parts[elem] != elem_parts[other.elem]) {
+                    shared.push_back({ elem, s, elem_parts[other.elem] });
+                    shared.push_back({ other.elem, other.side, elem_parts[elem] });
+                }
+            }
+        }
+    }
+    return shared;
+}
+
+/// Build the data shared by all parts
+Layout
+build_layout(const File & file, const std::vector<int> & elem_parts, int n_parts)
+{
+    auto & blocks = file.get_element_blocks();
+    Layout lo;
+    lo.blk_ofst.assign(blocks.size() + 1, 0);
+    for (std::size_t b = 0; b < blocks.size(); b++)
+        lo.blk_ofst[b + 1] = lo.blk_ofst[b] + std::max(blocks[b].get_num_elements(), 0);
+    int64_t n_elems = lo.blk_ofst.back();
+
+    // counting sort keeps elements of a part in the global order
+    lo.part_elem_ofst.assign(n_parts + 1, 0);
+    for (auto p : elem_parts)
+        lo.part_elem_ofst[p + 1]++;
+    counts_to_offsets(lo.part_elem_ofst);
+    lo.part_elems.resize(n_elems);
+    auto pos = lo.part_elem_ofst;
+    for (int64_t e = 0; e < n_elems; e++)
+        lo.part_elems[pos[elem_parts[e]]++] = e;
+
+    // parts are visited in increasing order, so remembering the last part that used a node is
+    // enough to list each part once
+    int64_t n_nodes = file.get_num_nodes();
+    auto for_each_part_node = [&](auto && fn) {
+        std::vector<int> last_part(n_nodes, -1);
+        for (int p = 0; p < n_parts; p++)
+            for (auto k = lo.part_elem_ofst[p]; k < lo.part_elem_ofst[p + 1]; k++)
+                for (auto node_id : element_nodes(blocks, lo.blk_ofst, lo.part_elems[k])) {
+                    if (last_part[node_id - 1] != p) {
+                        last_part[node_id - 1] = p;
+                        fn(p, node_id - 1);
+                    }
+                }
+    };
+    lo.node_part_ofst.assign(n_nodes + 1, 0);
+    for_each_part_node([&](int, int64_t n) { lo.node_part_ofst[n + 1]++; });
+    counts_to_offsets(lo.node_part_ofst);
+    lo.node_parts.resize(lo.node_part_ofst.back());
+    pos = lo.node_part_ofst;
+    for_each_part_node([&](int p, int64_t n) { lo.node_parts[pos[n]++] = p; });
+
+    lo.part_node_ofst.assign(n_parts + 1, 0);
+    for (auto p : lo.node_parts)
+        lo.part_node_ofst[p + 1]++;
+    counts_to_offsets(lo.part_node_ofst);
+    lo.part_nodes.resize(lo.part_node_ofst.back());
+    pos = lo.part_node_ofst;
+    for (int64_t n = 0; n < n_nodes; n++)
+        for (auto k = lo.node_part_ofst[n]; k < lo.node_part_ofst[n + 1]; k++)
+            lo.part_nodes[pos[lo.node_parts[k]]++] = n;
+
+    auto shared = find_shared_sides(blocks, lo.blk_ofst, elem_parts);
+    std::sort(shared.begin(), shared.end(), [&](const SharedSide & a, const SharedSide & b) {
+        return std::make_tuple(elem_parts[a.elem], a.elem, a.side) <
+               std::make_tuple(elem_parts[b.elem], b.elem, b.side);
+    });
+    lo.part_side_ofst.assign(n_parts + 1, 0);
+    for (auto & s : shared)
+        lo.part_side_ofst[elem_parts[s.elem] + 1]++;
+    counts_to_offsets(lo.part_side_ofst);
+    lo.part_sides = std::move(shared);
+    return lo;
+}
+
+/// Find the local (1-based) ID of a global index
+///
+/// @param first Sorted global indices of a part
+/// @param last End of the global indices
+/// @param idx Global (0-based) index
+/// @return Local (1-based) ID, 0 if the part does not have `idx`
+int
+local_id(const int64_t * first, const int64_t * last, int64_t idx)
+{
+    auto it = std::lower_bound(first, last, idx);
+    if (it == last || *it != idx)
+        return 0;
+    return static_cast<int>(it - first + 1);
+}
+
+/// Collect communication maps into a list ordered by neighboring part
+std::vector<CommMap>
+to_list(std::map<int, CommMap> & cmaps)
+{
+    std::vector<CommMap> list;
+    for (auto & it : cmaps)
+        list.push_back(std::move(it.second));
+    return list;
+}
+
+/// Build a part and write it into a file
+///
+/// @param io_mutex Mutex serializing the ExodusII calls
+void
+write_part(const File & file,
+           const Layout & lo,
+           int n_parts,
+           int part,
+           const fs::path & part_path,
+           std::mutex & io_mutex)
+{
+    auto & blocks = file.get_element_blocks();
+    const int64_t * elems = lo.part_elems.data() + lo.part_elem_ofst[part];
+    const int64_t * elems_end = lo.part_elems.data() + lo.part_elem_ofst[part + 1];
+    const int64_t * nodes = lo.part_nodes.data() + lo.part_node_ofst[part];
+    const int64_t * nodes_end = lo.part_nodes.data() + lo.part_node_ofst[part + 1];
+    int64_t n_elems = elems_end - elems;
+    int64_t n_nodes = nodes_end - nodes;
+    auto is_border = [&](int64_t n) { return lo.node_part_ofst[n + 1] - lo.node_part_ofst[n] > 1; };
+
+    LoadBalance lb;
+    lb.n_parts = n_parts;
+    lb.part = part;
+    lb.n_global_nodes = file.get_num_nodes();
+    lb.n_global_elems = lo.blk_ofst.back();
+    for (auto & blk : blocks) {
+        lb.global_blk_ids.push_back(blk.get_id());
+        lb.global_blk_counts.push_back(std::max(blk.get_num_elements(), 0));
+    }
+    for (auto & ns : file.get_node_sets()) {
+        lb.global_ns_ids.push_back(ns.get_id());
+        lb.global_ns_counts.push_back(ns.get_size());
+    }
+    for (auto & ss : file.get_side_sets()) {
+        lb.global_ss_ids.push_back(ss.get_id());
+        lb.global_ss_counts.push_back(ss.get_size());
+    }
+
+    // IDs of the original mesh, taken from its ID maps if they were read
+    auto & node_map = file.get_node_id_map();
+    auto & elem_map = file.get_elem_id_map();
+    bool has_node_map = node_map.get_size() == static_cast<std::size_t>(file.get_num_nodes());
+    bool has_elem_map = elem_map.get_size() == static_cast<std::size_t>(lo.blk_ofst.back());
+
+    std::map<int, CommMap> node_cmaps;
+    std::vector<int64_t> node_ids(n_nodes);
+    for (int64_t i = 0; i < n_nodes; i++) {
+        auto n = nodes[i];
+        int id = static_cast<int>(i + 1);
+        node_ids[i] = has_node_map ? node_map.get_id(n) : n + 1;
+        if (!is_border(n)) {
+            lb.internal_nodes.push_back(id);
+            continue;
+        }
+        lb.border_nodes.push_back(id);
+        for (auto k = lo.node_part_ofst[n]; k < lo.node_part_ofst[n + 1]; k++) {
+            auto proc = lo.node_parts[k];
+            if (proc == part)
+                continue;
+            auto & cmap = node_cmaps[proc];
+            cmap.id = proc;
+            cmap.ids.push_back(id);
+            cmap.procs.push_back(proc);
+        }
+    }
+    lb.node_cmaps = to_list(node_cmaps);
+
+    std::vector<std::vector<int>> connect(blocks.size());
+    std::vector<int64_t> blk_counts(blocks.size(), 0);
+    std::vector<int64_t> elem_ids(n_elems);
+    for (int64_t k = 0; k < n_elems; k++) {
+        auto e = elems[k];
+        auto b = block_index(lo.blk_ofst, e);
+        bool border = false;
+        for (auto node_id : blocks[b].get_element_nodes(e - lo.blk_ofst[b])) {
+            connect[b].push_back(local_id(nodes, nodes_end, node_id - 1));
+            border |= is_border(node_id - 1);
+        }
+        blk_counts[b]++;
+        elem_ids[k] = has_elem_map ? elem_map.get_id(e) : e + 1;
+        (border ? lb.border_elems : lb.internal_elems).push_back(static_cast<int>(k + 1));
+    }
+
+    std::map<int, CommMap> elem_cmaps;
+    for (auto k = lo.part_side_ofst[part]; k < lo.part_side_ofst[part + 1]; k++) {
+        auto & s = lo.part_sides[k];
+        auto & cmap = elem_cmaps[s.proc];
+        cmap.id = s.proc;
+        cmap.ids.push_back(local_id(elems, elems_end, s.elem));
+        cmap.sides.push_back(s.side + 1);
+        cmap.procs.push_back(s.proc);
+    }
+    lb.elem_cmaps = to_list(elem_cmaps);
+
+    std::vector<double> coords[3];
+    const std::vector<double> * all_coords[3] = { &file.get_x_coords(),
+                                                   &file.get_y_coords(),
+                                                   &file.get_z_coords() };
+    int dim = file.get_dim();
+    for (int d = 0; d < dim; d++) {
+        coords[d].resize(n_nodes);
+        for (int64_t i = 0; i < n_nodes; i++)
+            coords[d][i] = (*all_coords[d])[nodes[i]];
+    }
+
+    // ExodusII does not accept data for empty sets, so sets without entries in this part are
+    // left out of the part file; they are still listed in the global set parameters
+    std::vector<std::pair<int, std::vector<int>>> node_sets;
+    std::vector<std::string> node_set_names;
+    for (auto & ns : file.get_node_sets()) {
+        std::vector<int> ids;
+        for (auto node_id : ns.get_node_ids())
+            if (auto id = local_id(nodes, nodes_end, node_id - 1))
+                ids.push_back(id);
+        if (!ids.empty()) {
+            node_sets.emplace_back(ns.get_id(), std::move(ids));
+            node_set_names.push_back(ns.get_name());
+        }
+    }
+    std::vector<std::tuple<int, std::vector<int>, std::vector<int>>> side_sets;
+    std::vector<std::string> side_set_names;
+    for (auto & ss : file.get_side_sets()) {
+        auto & elem_list = ss.get_element_ids();
+        auto & side_list = ss.get_side_ids();
+        std::vector<int> ids, sides;
+        for (std::size_t i = 0; i < elem_list.size(); i++)
+            if (auto id = local_id(elems, elems_end, elem_list[i] - 1)) {
+                ids.push_back(id);
+                sides.push_back(side_list[i]);
+            }
+        if (!ids.empty()) {
+            side_sets.emplace_back(ss.get_id(), std::move(ids), std::move(sides));
+            side_set_names.push_back(ss.get_name());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(io_mutex);
+    File f(part_path, FileAccess::WRITE);
+    f.init(file.get_title().c_str(),
+           dim,
+           n_nodes,
+           n_elems,
+           blocks.size(),
+           node_sets.size(),
+           side_sets.size());
+    if (file.get_coord_names().empty())
+        f.write_coord_names();
+    else
+        f.write_coord_names(file.get_coord_names());
+    f.write_load_balance(lb);
+
+    std::vector<std::string> blk_names;
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        auto & blk = blocks[b];
+        f.write_block_info(blk.get_id(),
+                           blk.get_element_type().c_str(),
+                           blk_counts[b],
+                           blk.get_num_nodes_per_element());
+        blk_names.push_back(blk.get_name());
+    }
+    f.write_block_names(blk_names);
+    f.write_node_id_map(node_ids);
+    f.write_elem_id_map(elem_ids);
+    if (dim == 1)
+        f.write_coords(coords[0]);
+    else if (dim == 2)
+        f.write_coords(coords[0], coords[1]);
+    else
+        f.write_coords(coords[0], coords[1], coords[2]);
+    // blocks without nodes have no connectivity to write
+    for (std::size_t b = 0; b < blocks.size(); b++)
+        if (blocks[b].get_num_nodes_per_element() > 0)
+            f.write_partial_connectivity(blocks[b].get_id(), 0, blk_counts[b], connect[b]);
+
+    for (auto & [id, ids] : node_sets)
+        f.write_node_set(id, ids);
+    if (!node_sets.empty())
+        f.write_node_set_names(node_set_names);
+    for (auto & [id, ids, sides] : side_sets)
+        f.write_side_set(id, ids, sides);
+    if (!side_sets.empty())
+        f.write_side_set_names(side_set_names);
+    f.close();
+}
+
+} // namespace
+
+Decomposition::Decomposition(const File & file, int n_parts) : n_parts(n_parts)
+{
+    if (n_parts < 1)
+        throw Exception(fmt::sprintf("Number of parts must be positive, got %d.", n_parts));
+
+    int64_t n_elems = file.get_num_elements();
+    if (n_elems < n_parts)
+        throw Exception(
+            fmt::sprintf("Cannot split %d elements into %d parts.", (int) n_elems, n_parts));
+
+    // centroids are indexed by global element index; elements of blocks without nodes have none
+    auto summary = file.compute_geometry_summary();
+    auto & blocks = file.get_element_blocks();
+    std::vector<double> centroids((std::size_t) 3 * n_elems, 0.);
+    std::vector<int64_t> elems, elems_wo_centroid;
+    int64_t ofst = 0;
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        int64_t n_blk_elems = std::max(blocks[b].get_num_elements(), 0);
+        auto & blk_centroids = summary.blocks[b].centroids;
+        auto & list = blk_centroids.empty() ? elems_wo_centroid : elems;
+        for (int64_t e = 0; e < n_blk_elems; e++)
+            list.push_back(ofst + e);
+        std::copy(blk_centroids.begin(), blk_centroids.end(), centroids.begin() + 3 * ofst);
+        ofst += n_blk_elems;
+    }
+    if (ofst != n_elems)
+        throw Exception("Element blocks must be read before decomposing the mesh.");
+
+    this->elem_parts.resize(n_elems);
+    bisect(elems.data(), elems.data() + elems.size(), 0, n_parts, centroids);
+
+    // elements without a centroid go into the smallest parts, which keeps the parts balanced
+    std::vector<int64_t> sizes(n_parts, 0);
+    for (auto & e : elems)
+        sizes[this->elem_parts[e]]++;
+    for (auto & e : elems_wo_centroid) {
+        auto part = std::min_element(sizes.begin(), sizes.end()) - sizes.begin();
+        this->elem_parts[e] = static_cast<int>(part);
+        sizes[part]++;
+    }
+}
+
+void
+Decomposition::bisect(int64_t * first,
+                      int64_t * last,
+                      int part,
+                      int n,
+                      const std::vector<double> & centroids)
+{
+    if (n == 1) {
+        for (auto it = first; it != last; ++it)
+            this->elem_parts[*it] = part;
+        return;
+    }
+
+    double lo[3], hi[3];
+    for (int d = 0; d < 3; d++) {
+        lo[d] = std::numeric_limits<double>::max();
+        hi[d] = std::numeric_limits<double>::lowest();
+    }
+    for (auto it = first; it != last; ++it)
+        for (int d = 0; d < 3; d++) {
+            lo[d] = std::min(lo[d], centroids[3 * *it + d]);
+            hi[d] = std::max(hi[d], centroids[3 * *it + d]);
+        }
+    int axis = 0;
+    for (int d = 1; d < 3; d++)
+        if (hi[d] - lo[d] > hi[axis] - lo[axis])
+            axis = d;
+
+    // ties are broken by element index, so the result does not depend on the standard library
+    int n_left = n / 2;
+    auto mid = first + (last - first) * n_left / n;
+    std::nth_element(first, mid, last, [&](int64_t a, int64_t b) {
+        auto ca = centroids[3 * a + axis];
+        auto cb = centroids[3 * b + axis];
+        return ca < cb || (ca == cb && a < b);
+    });
+    bisect(first, mid, part, n_left, centroids);
+    bisect(mid, last, part + n_left, n - n_left, centroids);
+}
+
+int
+Decomposition::get_num_parts() const
+{
+    return this->n_parts;
+}
+
+const std::vector<int> &
+Decomposition::get_element_parts() const
+{
+    return this->elem_parts;
+}
+
+void
+Decomposition::write(const File & file, const fs::path & file_path, unsigned int n_threads) const
+{
+    if (static_cast<std::size_t>(file.get_num_elements()) != this->elem_parts.size())
+        throw Exception("The file does not match the decomposed mesh.");
+
+    auto lo = build_layout(file, this->elem_parts, this->n_parts);
+
+    std::mutex io_mutex;
+    internal::parallel_for(this->n_parts, n_threads, [&](std::size_t part) {
+        auto part_path = get_part_file_path(file_path, this->n_parts, static_cast<int>(part));
+        write_part(file, lo, this->n_parts, static_cast<int>(part), part_path, io_mutex);
+    });
+}
+
+fs::path
+Decomposition::get_part_file_path(const fs::path & file_path, int n_parts, int part)
+{
+    auto width = std::to_string(n_parts).size();
+    return file_path.string() + fmt::format(".{}.{:0{}}", n_parts, part, width);
+}
+
+} // namespace exodusIIcpp
@@ -3,6 +3,7 @@
 
 #include "exodusIIcpp/element_block.h"
 #include "exodusIIcpp/exception.h"
+#include "fmt/printf.h"
 
 namespace exodusIIcpp {
 
@@ -58,6 +59,18 @@ ElementBlock::get_element_connectivity(std::size_t element_idx) const
         throw Exception("Index of of range");
 }
 
+Span<const int>
+ElementBlock::get_element_nodes(std::size_t element_idx) const
+{
+    if (this->n_elems < 0 || element_idx >= static_cast<std::size_t>(this->n_elems))
+        throw Exception("Index of of range");
+    if (this->connect.size() < static_cast<std::size_t>(this->n_elems) * this->n_nodes_per_elem)
+        throw Exception(
+            fmt::sprintf("Connectivity of element block %d is not loaded.", this->id));
+    return Span<const int>(this->connect.data() + element_idx * this->n_nodes_per_elem,
+                           this->n_nodes_per_elem);
+}
+
 int
 ElementBlock::get_num_elements() const
 {
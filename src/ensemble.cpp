@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/ensemble.h"
+#include "exodusIIcpp/exception.h"
+#include "parallel.h"
+#include "fmt/printf.h"
+#include <algorithm>
+#include <mutex>
+
+namespace exodusIIcpp {
+
+/// Find the index (1-based) of a variable
+static int
+find_variable(const std::vector<std::string> & names,
+              const std::string & var_name,
+              const fs::path & file_path)
+{
+    auto it = std::find(names.begin(), names.end(), var_name);
+    if (it == names.end())
+        throw Exception(
+            fmt::sprintf("Variable '%s' not found in '%s'.", var_name, file_path.string()));
+    return static_cast<int>(it - names.begin()) + 1;
+}
+
+Ensemble::Ensemble(const std::vector<fs::path> & file_paths,
+                   std::size_t max_open_files,
+                   unsigned int n_threads) :
+    max_open_files(std::max<std::size_t>(max_open_files, 1))
+{
+    // members are opened and fingerprinted on `n_threads` threads, every ExodusII call is made
+    // under `io_mutex`
+    std::mutex io_mutex;
+    this->members.resize(file_paths.size());
+    std::vector<uint64_t> fingerprints(file_paths.size());
+    internal::parallel_for(file_paths.size(), n_threads, [&](std::size_t i) {
+        auto & mbr = this->members[i];
+        mbr.file_path = file_paths[i];
+        std::unique_ptr<File> file;
+        {
+            std::lock_guard<std::mutex> lock(io_mutex);
+            file = std::make_unique<File>(file_paths[i], FileAccess::READ);
+            mbr.nodal_var_names = file->get_nodal_variable_names();
+            mbr.elem_var_names = file->get_elemental_variable_names();
+            mbr.global_var_names = file->get_global_variable_names();
+        }
+        try {
+            fingerprints[i] = file->mesh_fingerprint(true, 1, &io_mutex);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(io_mutex);
+            file.reset();
+            throw;
+        }
+        std::lock_guard<std::mutex> lock(io_mutex);
+        file.reset();
+    });
+
+    // meshes are numbered in the order they first appear and read from their first member
+    for (std::size_t i = 0; i < file_paths.size(); i++) {
+        auto it = std::find(this->mesh_fingerprints.begin(),
+                            this->mesh_fingerprints.end(),
+                            fingerprints[i]);
+        this->members[i].mesh_idx = it - this->mesh_fingerprints.begin();
+        if (it == this->mesh_fingerprints.end()) {
+            auto file = std::make_unique<File>(file_paths[i], FileAccess::READ);
+            file->read_coords();
+            file->read_coord_names();
+            file->read_blocks();
+            file->read_node_sets();
+            file->read_side_sets();
+            file->close();
+            this->meshes.push_back(std::move(file));
+            this->mesh_fingerprints.push_back(fingerprints[i]);
+        }
+    }
+}
+
+std::size_t
+Ensemble::get_num_members() const
+{
+    return this->members.size();
+}
+
+const fs::path &
+Ensemble::get_file_path(std::size_t member) const
+{
+    return this->members.at(member).file_path;
+}
+
+std::size_t
+Ensemble::get_num_meshes() const
+{
+    return this->meshes.size();
+}
+
+std::size_t
+Ensemble::get_mesh_index(std::size_t member) const
+{
+    return this->members.at(member).mesh_idx;
+}
+
+const File &
+Ensemble::get_mesh(std::size_t member) const
+{
+    return *this->meshes[get_mesh_index(member)];
+}
+
+uint64_t
+Ensemble::get_mesh_fingerprint(std::size_t member) const
+{
+    return this->mesh_fingerprints[get_mesh_index(member)];
+}
+
+std::size_t
+Ensemble::get_num_open_files() const
+{
+    return this->open_files.size();
+}
+
+const File &
+Ensemble::open_member(std::size_t member) const
+{
+    auto it = std::find_if(this->open_files.begin(),
+                           this->open_files.end(),
+                           [member](const auto & entry) { return entry.first == member; });
+    if (it != this->open_files.end()) {
+        this->open_files.splice(this->open_files.end(), this->open_files, it);
+        return *this->open_files.back().second;
+    }
+
+    if (this->open_files.size() >= this->max_open_files)
+        this->open_files.pop_front();
+    this->open_files.emplace_back(
+        member,
+        std::make_unique<File>(this->members[member].file_path, FileAccess::READ));
+    return *this->open_files.back().second;
+}
+
+void
+Ensemble::check_single_mesh() const
+{
+    if (this->meshes.size() > 1)
+        throw Exception("Members of the ensemble do not share one mesh.");
+}
+
+std::vector<double>
+Ensemble::read_nodal_variable(int time_step, const std::string & var_name) const
+{
+    check_single_mesh();
+    std::size_t n_nodes = this->meshes.empty() ? 0 : std::max(this->meshes[0]->get_num_nodes(), 0);
+    std::vector<double> values(this->members.size() * n_nodes);
+    for (std::size_t i = 0; i < this->members.size(); i++) {
+        auto & mbr = this->members[i];
+        int var_idx = find_variable(mbr.nodal_var_names, var_name, mbr.file_path);
+        auto vals = open_member(i).get_nodal_variable_values(time_step, var_idx);
+        std::copy(vals.begin(), vals.end(), values.begin() + i * n_nodes);
+    }
+    return values;
+}
+
+std::vector<double>
+Ensemble::read_elemental_variable(int time_step, const std::string & var_name) const
+{
+    check_single_mesh();
+    std::size_t n_elems =
+        this->meshes.empty() ? 0 : std::max(this->meshes[0]->get_num_elements(), 0);
+    std::vector<double> values(this->members.size() * n_elems);
+    for (std::size_t i = 0; i < this->members.size(); i++) {
+        auto & mbr = this->members[i];
+        int var_idx = find_variable(mbr.elem_var_names, var_name, mbr.file_path);
+        auto vals = open_member(i).get_elemental_variable_values(time_step, var_idx);
+        std::copy(vals.begin(), vals.end(), values.begin() + i * n_elems);
+    }
+    return values;
+}
+
+std::vector<double>
+Ensemble::read_global_variable(int time_step, const std::string & var_name) const
+{
+    std::vector<double> values(this->members.size());
+    for (std::size_t i = 0; i < this->members.size(); i++) {
+        auto & mbr = this->members[i];
+        int var_idx = find_variable(mbr.global_var_names, var_name, mbr.file_path);
+        values[i] = open_member(i).get_global_variable_values(var_idx, time_step, time_step)[0];
+    }
+    return values;
+}
+
+} // namespace exodusIIcpp
@@ -2,13 +2,245 @@
 // SPDX-License-Identifier: MIT
 
 #include "exodusIIcpp/file.h"
+#include "exodusIIcpp/step_writer.h"
+#include "parallel.h"
 #include "exodusII.h"
+#include "xxhash.h"
 #include "fmt/printf.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
 #include <numeric>
+#include "netcdf.h"
+#ifdef EXODUSIICPP_WITH_MPI
+    #include "netcdf_par.h"
+#endif
 
 namespace exodusIIcpp {
 
+/// Throw if an elemental variable index (1-based) is not among `n_elem_vars` variables
+static void
+check_elem_var_index(int var_idx, std::size_t n_elem_vars)
+{
+    if (var_idx < 1 || static_cast<std::size_t>(var_idx) > n_elem_vars)
+        throw Exception(fmt::sprintf("Elemental variable index %d is out of range.", var_idx));
+}
+
+/// View a braced list of values, which lives until the end of the calling full expression
+template <typename T>
+static Span<const T>
+list_span(std::initializer_list<T> list)
+{
+    return Span<const T>(list.begin(), list.size());
+}
+
+/// Get the number of time steps per storage chunk of a netCDF variable
+///
+/// Variables that are not chunked, e.g. in netCDF-3 files, or are not found count as one time step
+/// per chunk.
+static int
+steps_per_chunk(int exoid, const std::string & nc_name)
+{
+    int varid;
+    if (nc_inq_varid(exoid, nc_name.c_str(), &varid) != NC_NOERR)
+        return 1;
+    int storage;
+    std::size_t chunk_sizes[NC_MAX_VAR_DIMS];
+    if (nc_inq_var_chunking(exoid, varid, &storage, chunk_sizes) != NC_NOERR ||
+        storage != NC_CHUNKED)
+        return 1;
+    return static_cast<int>(std::max<std::size_t>(1, chunk_sizes[0]));
+}
+
+/// Number of elements summarized at once by `compute_geometry_summary`
+static const int GEOMETRY_CHUNK_SIZE = 16384;
+
+/// Check if a file stores an elemental variable truth table
+///
+/// Without a stored table, ExodusII defines an elemental variable on a block when its values are
+/// first written there, and reports only the variables written so far as the truth table.
+static bool
+has_stored_truth_table(int exoid)
+{
+    int varid;
+    return nc_inq_varid(exoid, "elem_var_tab", &varid) == NC_NOERR;
+}
+
+/// Prefix of the information record holding the mesh fingerprint
+static const std::string FINGERPRINT_RECORD = "mesh-fingerprint: ";
+
+/// Number of nodes, elements or set entries hashed at once
+static const int64_t FINGERPRINT_CHUNK_SIZE = 65536;
+
+/// Number of chunks per thread collected before they are hashed
+static const std::size_t FINGERPRINT_CHUNKS_PER_THREAD = 4;
+
+/// Hash of the mesh data
+///
+/// Chunks are read from the file straight into buffers of the hash and hashed on worker threads,
+/// each into a digest of its own. Values and chunk digests are combined in the order they were
+/// added, so the result does not depend on the number of threads.
+class FingerprintHash {
+public:
+    explicit FingerprintHash(unsigned int n_threads) :
+        n_threads(std::max(1u, n_threads)),
+        n_chunks(0)
+    {
+    }
+
+    /// Add bytes to the combined hash
+    void
+    add_bytes(const void * data, std::size_t size)
+    {
+        auto p = static_cast<const unsigned char *>(data);
+        this->items.push_back({ false, std::vector<unsigned char>(p, p + size), 0 });
+    }
+
+    /// Add a value to the combined hash
+    void
+    add_value(int64_t value)
+    {
+        add_bytes(&value, sizeof(value));
+    }
+
+    /// Get a buffer for a chunk of values that is hashed on its own
+    ///
+    /// Chunks are read straight into their buffers, so they are not copied before they are hashed.
+    /// Call `chunks_filled` once the buffers are filled.
+    ///
+    /// @param n Number of values
+    /// @return The buffer, `nullptr` if `n` is zero
+    template <typename T>
+    T *
+    chunk_buffer(std::size_t n)
+    {
+        if (n == 0)
+            return nullptr;
+        std::vector<unsigned char> data;
+        if (!this->spare.empty()) {
+            data = std::move(this->spare.back());
+            this->spare.pop_back();
+        }
+        data.resize(n * sizeof(T));
+        this->items.push_back({ true, std::move(data), 0 });
+        this->n_chunks++;
+        return reinterpret_cast<T *>(this->items.back().data.data());
+    }
+
+    /// Hash the chunks once there are enough of them to keep the threads busy
+    ///
+    /// Buffers returned by `chunk_buffer` must not be used after this call.
+    void
+    chunks_filled()
+    {
+        if (this->n_chunks >= FINGERPRINT_CHUNKS_PER_THREAD * this->n_threads)
+            flush();
+    }
+
+    /// Get the digest of everything added so far
+    uint64_t
+    digest()
+    {
+        flush();
+        return this->hash.digest();
+    }
+
+protected:
+    struct Item {
+        /// `true` if the bytes are hashed on their own
+        bool is_chunk;
+        /// Bytes
+        std::vector<unsigned char> data;
+        /// Digest of a chunk
+        uint64_t digest;
+    };
+
+    /// Hash the collected chunks and combine everything collected
+    void
+    flush()
+    {
+        std::vector<Item *> chunks;
+        for (auto & item : this->items)
+            if (item.is_chunk)
+                chunks.push_back(&item);
+        internal::parallel_for(chunks.size(), this->n_threads, [&](std::size_t i) {
+            internal::XXH64 chunk_hash;
+            chunk_hash.update(chunks[i]->data.data(), chunks[i]->data.size());
+            chunks[i]->digest = chunk_hash.digest();
+        });
+        for (auto & item : this->items) {
+            if (item.is_chunk) {
+                this->hash.update(&item.digest, sizeof(item.digest));
+                this->spare.push_back(std::move(item.data));
+            }
+            else
+                this->hash.update(item.data.data(), item.data.size());
+        }
+        this->items.clear();
+        this->n_chunks = 0;
+    }
+
+    /// Number of threads hashing the chunks
+    unsigned int n_threads;
+    /// Values and chunks not combined yet
+    std::vector<Item> items;
+    /// Number of chunks in `items`
+    std::size_t n_chunks;
+    /// Buffers of hashed chunks, reused for the next ones
+    std::vector<std::vector<unsigned char>> spare;
+    /// Combined hash
+    internal::XXH64 hash;
+};
+
+/// Lock a mutex serializing ExodusII calls, if there is one
+static std::unique_lock<std::mutex>
+lock_io(std::mutex * io_mutex)
+{
+    return io_mutex ? std::unique_lock<std::mutex>(*io_mutex) : std::unique_lock<std::mutex>();
+}
+
+/// Hash the IDs and the entries of all sets of a type
+static void
+hash_sets(FingerprintHash & hash,
+          int exoid,
+          ex_entity_type set_type,
+          int n_sets,
+          std::mutex * io_mutex)
+{
+    if (n_sets <= 0)
+        return;
+
+    std::vector<int> ids(n_sets);
+    {
+        auto lock = lock_io(io_mutex);
+        EXODUSIICPP_CHECK_ERROR(ex_get_ids(exoid, set_type, ids.data()));
+    }
+    for (auto & id : ids) {
+        int n_entries;
+        int n_dfs;
+        {
+            auto lock = lock_io(io_mutex);
+            EXODUSIICPP_CHECK_ERROR(ex_get_set_param(exoid, set_type, id, &n_entries, &n_dfs));
+        }
+        hash.add_value(id);
+        hash.add_value(n_entries);
+        for (int64_t start = 0; start < n_entries; start += FINGERPRINT_CHUNK_SIZE) {
+            auto count = std::min<int64_t>(FINGERPRINT_CHUNK_SIZE, n_entries - start);
+            auto entries = hash.chunk_buffer<int>(count);
+            auto extra = hash.chunk_buffer<int>(set_type == EX_SIDE_SET ? count : 0);
+            {
+                auto lock = lock_io(io_mutex);
+                EXODUSIICPP_CHECK_ERROR(
+                    ex_get_partial_set(exoid, set_type, id, start + 1, count, entries, extra));
+            }
+            hash.chunks_filled();
+        }
+    }
+}
+
 static void
 write_variable_names(int exoid, ex_entity_type obj_type, const std::vector<std::string> & var_names)
 {
@@ -74,17 +306,94 @@ read_variable_names(int exoid, ex_entity_type obj_type)
     return var_names;
 }
 
+static std::vector<int64_t>
+read_id_map(int exoid, ex_entity_type map_type, int64_t n)
+{
+    std::vector<int64_t> ids(n);
+    if (n > 0) {
+        // maps are always transferred as 64-bit integers, regardless of how they are stored
+        int api = ex_int64_status(exoid) & EX_ALL_INT64_API;
+        ex_set_int64_status(exoid, api | EX_MAPS_INT64_API);
+        int err = ex_get_id_map(exoid, map_type, ids.data());
+        ex_set_int64_status(exoid, api);
+        EXODUSIICPP_CHECK_ERROR(err);
+    }
+    return ids;
+}
+
+static void
+write_id_map(int exoid, ex_entity_type map_type, const std::vector<int64_t> & ids)
+{
+    int api = ex_int64_status(exoid) & EX_ALL_INT64_API;
+    ex_set_int64_status(exoid, api | EX_MAPS_INT64_API);
+    int err = ex_put_id_map(exoid, map_type, ids.data());
+    ex_set_int64_status(exoid, api);
+    EXODUSIICPP_CHECK_ERROR(err);
+}
+
+/// Map 1-based indices into the new numbering
+static std::vector<int>
+renumber(const std::vector<int64_t> & index, const std::vector<int> & ids)
+{
+    std::vector<int> result(ids.size());
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        if (ids[i] < 1 || static_cast<std::size_t>(ids[i]) > index.size())
+            throw Exception(fmt::sprintf("Index %d is out of range.", ids[i]));
+        result[i] = static_cast<int>(index[ids[i] - 1] + 1);
+    }
+    return result;
+}
+
+/// Check that the size of nodal data matches the reordering
+static void
+check_nodal_size(const Reordering & reordering, std::size_t n)
+{
+    if (n != static_cast<std::size_t>(reordering.get_num_nodes()))
+        throw Exception(
+            fmt::sprintf("Expected %d nodal values, got %d.", reordering.get_num_nodes(), n));
+}
+
+/// Bounding box that contains nothing
+static BoundingBox
+empty_bounding_box(int n_dim)
+{
+    BoundingBox bbox;
+    for (int d = 0; d < 3; d++) {
+        bbox.min[d] = d < n_dim ? std::numeric_limits<double>::max() : 0.;
+        bbox.max[d] = d < n_dim ? std::numeric_limits<double>::lowest() : 0.;
+    }
+    return bbox;
+}
+
+static void
+coord_range(const double * c, std::size_t n, double & lo, double & hi)
+{
+    // plain loop so that the compiler can vectorize the reductions
+    double mn = lo;
+    double mx = hi;
+    for (std::size_t i = 0; i < n; i++) {
+        mn = c[i] < mn ? c[i] : mn;
+        mx = c[i] > mx ? c[i] : mx;
+    }
+    lo = mn;
+    hi = mx;
+}
+
 File::File() :
     cpu_word_size(sizeof(double)),
     io_word_size(8),
     version(0),
     exoid(-1),
+    parallel(false),
     n_dim(-1),
     n_nodes(-1),
     n_elems(-1),
     n_elem_blks(-1),
     n_node_sets(-1),
-    n_side_sets(-1)
+    n_side_sets(-1),
+    blk_elem_ofst(1, 0),
+    append_cache(false),
+    n_times(0)
 {
 }
 
@@ -94,12 +403,16 @@ File::File(fs::path file_path, FileAccess file_access) :
     io_word_size(8),
     version(0),
     exoid(-1),
+    parallel(false),
     n_dim(-1),
     n_nodes(-1),
     n_elems(-1),
     n_elem_blks(-1),
     n_node_sets(-1),
-    n_side_sets(-1)
+    n_side_sets(-1),
+    blk_elem_ofst(1, 0),
+    append_cache(false),
+    n_times(0)
 {
     if (file_access == FileAccess::READ) {
         open(file_path);
@@ -129,6 +442,7 @@ File::open(const fs::path & file_path)
                           &this->version);
     if (this->exoid < 0)
         throw Exception(fmt::sprintf("Unable to open file '%s'.", file_path.string()));
+    this->parallel = false;
 }
 
 void
@@ -139,6 +453,7 @@ File::create(const fs::path & file_path)
         ex_create(file_path.c_str(), EX_CLOBBER, &this->cpu_word_size, &this->io_word_size);
     if (this->exoid < 0)
         throw Exception(fmt::sprintf("Unable to open file '%s'.", file_path.string()));
+    this->parallel = false;
 }
 
 void
@@ -152,6 +467,85 @@ File::append(const fs::path & file_path)
                           &this->version);
     if (this->exoid < 0)
         throw Exception(fmt::sprintf("Unable to open file '%s'.", file_path.string()));
+    this->parallel = false;
+}
+
+#ifdef EXODUSIICPP_WITH_MPI
+File::File(fs::path file_path, FileAccess file_access, MPI_Comm comm) : File()
+{
+    if (file_access == FileAccess::READ) {
+        open_par(file_path, comm);
+        init();
+    }
+    else if (file_access == FileAccess::APPEND) {
+        append_par(file_path, comm);
+        init();
+    }
+    else
+        create_par(file_path, comm);
+}
+
+void
+File::open_par(const fs::path & file_path, MPI_Comm comm, MPI_Info info)
+{
+    this->file_access = FileAccess::READ;
+    this->exoid = ex_open_par(file_path.c_str(),
+                              EX_READ,
+                              &this->cpu_word_size,
+                              &this->io_word_size,
+                              &this->version,
+                              comm,
+                              info);
+    if (this->exoid < 0)
+        throw Exception(fmt::sprintf("Unable to open file '%s'.", file_path.string()));
+    this->parallel = true;
+}
+
+void
+File::create_par(const fs::path & file_path, MPI_Comm comm, MPI_Info info)
+{
+    this->file_access = FileAccess::WRITE;
+    this->exoid = ex_create_par(file_path.c_str(),
+                                EX_CLOBBER | EX_NETCDF4,
+                                &this->cpu_word_size,
+                                &this->io_word_size,
+                                comm,
+                                info);
+    if (this->exoid < 0)
+        throw Exception(fmt::sprintf("Unable to open file '%s'.", file_path.string()));
+    this->parallel = true;
+}
+
+void
+File::append_par(const fs::path & file_path, MPI_Comm comm, MPI_Info info)
+{
+    this->file_access = FileAccess::APPEND;
+    this->exoid = ex_open_par(file_path.c_str(),
+                              EX_WRITE,
+                              &this->cpu_word_size,
+                              &this->io_word_size,
+                              &this->version,
+                              comm,
+                              info);
+    if (this->exoid < 0)
+        throw Exception(fmt::sprintf("Unable to open file '%s'.", file_path.string()));
+    this->parallel = true;
+}
+#endif
+
+void
+File::set_collective_access() const
+{
+#ifdef EXODUSIICPP_WITH_MPI
+    if (this->parallel)
+        EXODUSIICPP_CHECK_ERROR(nc_var_par_access(this->exoid, NC_GLOBAL, NC_COLLECTIVE));
+#endif
+}
+
+bool
+File::is_parallel() const
+{
+    return this->parallel;
 }
 
 bool
@@ -176,6 +570,40 @@ File::init()
                                             &this->n_side_sets));
         this->title = title;
         this->coord_names.resize(this->n_dim);
+
+        this->blk_ids.resize(std::max(this->n_elem_blks, 0));
+        this->blk_elem_ofst.assign(this->blk_ids.size() + 1, 0);
+        if (this->n_elem_blks > 0) {
+            EXODUSIICPP_CHECK_ERROR(ex_get_ids(this->exoid, EX_ELEM_BLOCK, this->blk_ids.data()));
+            for (std::size_t i = 0; i < this->blk_ids.size(); i++) {
+                int n_elems_in_block;
+                EXODUSIICPP_CHECK_ERROR(ex_get_block(this->exoid,
+                                                     EX_ELEM_BLOCK,
+                                                     this->blk_ids[i],
+                                                     nullptr,
+                                                     &n_elems_in_block,
+                                                     nullptr,
+                                                     nullptr,
+                                                     nullptr,
+                                                     nullptr));
+                this->blk_elem_ofst[i + 1] = this->blk_elem_ofst[i] + n_elems_in_block;
+            }
+        }
+
+        this->elem_var_names = read_variable_names(this->exoid, EX_ELEM_BLOCK);
+        // a file opened for reading does not change, so the table reported without a stored one
+        // can be kept as well
+        if (this->file_access == FileAccess::READ || has_stored_truth_table(this->exoid))
+            this->elem_var_tab = read_elem_var_truth_table();
+        else
+            this->elem_var_tab.clear();
+
+        if (this->file_access == FileAccess::APPEND) {
+            this->n_times = ex_inquire_int(this->exoid, EX_INQ_TIME);
+            this->nodal_var_names = read_variable_names(this->exoid, EX_NODAL);
+            this->global_var_names = read_variable_names(this->exoid, EX_GLOBAL);
+            this->append_cache = true;
+        }
     }
     else
         throw Exception("Calling init with non-read file access.");
@@ -200,6 +628,10 @@ File::init(const char * title,
                                             n_node_sets,
                                             n_side_sets));
         this->coord_names.resize(n_dims);
+        this->blk_ids.clear();
+        this->blk_elem_ofst.assign(1, 0);
+        this->elem_var_names.clear();
+        this->elem_var_tab.clear();
     }
     else
         throw Exception("Calling init with non-write access.");
@@ -271,12 +703,30 @@ File::get_coord_names() const
     return this->coord_names;
 }
 
+const IdMap &
+File::get_node_id_map() const
+{
+    return this->node_id_map;
+}
+
+const IdMap &
+File::get_elem_id_map() const
+{
+    return this->elem_id_map;
+}
+
 const std::vector<ElementBlock> &
 File::get_element_blocks() const
 {
     return this->element_blocks;
 }
 
+const std::vector<int> &
+File::get_element_block_ids() const
+{
+    return this->blk_ids;
+}
+
 const ElementBlock &
 File::get_element_block(std::size_t idx) const
 {
@@ -286,6 +736,46 @@ File::get_element_block(std::size_t idx) const
         throw Exception(fmt::sprintf("Index out of range '%d'", idx));
 }
 
+const Connectivity &
+File::get_connectivity() const
+{
+    return this->connectivity;
+}
+
+std::size_t
+File::get_element_block_index(int block_id) const
+{
+    auto it = std::find(this->blk_ids.begin(), this->blk_ids.end(), block_id);
+    if (it != this->blk_ids.end())
+        return it - this->blk_ids.begin();
+    else
+        throw Exception(fmt::sprintf("Element block with ID %d does not exist.", block_id));
+}
+
+int64_t
+File::get_global_element_index(std::size_t block_idx, int64_t local_idx) const
+{
+    if (block_idx < this->blk_ids.size() && local_idx >= 0 &&
+        local_idx < this->blk_elem_ofst[block_idx + 1] - this->blk_elem_ofst[block_idx])
+        return this->blk_elem_ofst[block_idx] + local_idx;
+    else
+        throw Exception(
+            fmt::sprintf("Element index (%d, %d) out of range.", block_idx, local_idx));
+}
+
+std::pair<std::size_t, int64_t>
+File::get_local_element_index(int64_t global_idx) const
+{
+    if (global_idx >= 0 && !this->blk_ids.empty() && global_idx < this->blk_elem_ofst.back()) {
+        auto it =
+            std::upper_bound(this->blk_elem_ofst.begin(), this->blk_elem_ofst.end(), global_idx);
+        std::size_t block_idx = (it - this->blk_elem_ofst.begin()) - 1;
+        return { block_idx, global_idx - this->blk_elem_ofst[block_idx] };
+    }
+    else
+        throw Exception(fmt::sprintf("Global element index %d out of range.", global_idx));
+}
+
 const std::vector<SideSet> &
 File::get_side_sets() const
 {
@@ -321,6 +811,8 @@ File::get_node_sets() const
 int
 File::get_num_times() const
 {
+    if (this->append_cache)
+        return this->n_times;
     return ex_inquire_int(this->exoid, EX_INQ_TIME);
 }
 
@@ -333,18 +825,24 @@ File::get_times() const
 std::vector<std::string>
 File::get_nodal_variable_names() const
 {
+    if (this->append_cache)
+        return this->nodal_var_names;
     return read_variable_names(this->exoid, EX_NODAL);
 }
 
 std::vector<std::string>
 File::get_elemental_variable_names() const
 {
+    if (this->append_cache)
+        return this->elem_var_names;
     return read_variable_names(this->exoid, EX_ELEM_BLOCK);
 }
 
 std::vector<std::string>
 File::get_global_variable_names() const
 {
+    if (this->append_cache)
+        return this->global_var_names;
     return read_variable_names(this->exoid, EX_GLOBAL);
 }
 
@@ -352,9 +850,112 @@ std::vector<double>
 File::get_nodal_variable_values(int time_step, int var_idx) const
 {
     std::vector<double> values;
+    get_nodal_variable_values(time_step, var_idx, values);
+    return values;
+}
+
+void
+File::get_nodal_variable_values(int time_step, int var_idx, std::vector<double> & values) const
+{
     values.resize(this->n_nodes);
     EXODUSIICPP_CHECK_ERROR(
         ex_get_var(this->exoid, time_step, EX_NODAL, var_idx, 1, this->n_nodes, values.data()));
+}
+
+std::vector<double>
+File::get_partial_nodal_variable_values(int time_step,
+                                        int var_idx,
+                                        int64_t start_idx,
+                                        int64_t count) const
+{
+    if (start_idx < 0 || count < 0 || start_idx + count > this->n_nodes)
+        throw Exception(
+            fmt::sprintf("Node range [%d, %d) is out of bounds.", start_idx, start_idx + count));
+    std::vector<double> values(count);
+    set_collective_access();
+    if (count > 0 || this->parallel)
+        EXODUSIICPP_CHECK_ERROR(ex_get_partial_var(this->exoid,
+                                                   time_step,
+                                                   EX_NODAL,
+                                                   var_idx,
+                                                   1,
+                                                   start_idx + 1,
+                                                   count,
+                                                   values.data()));
+    return values;
+}
+
+std::vector<double>
+File::get_partial_elemental_variable_values(int time_step,
+                                            int var_idx,
+                                            int block_id,
+                                            int64_t start_idx,
+                                            int64_t count) const
+{
+    int n_blk_elems;
+    EXODUSIICPP_CHECK_ERROR(ex_get_block(this->exoid,
+                                         EX_ELEM_BLOCK,
+                                         block_id,
+                                         nullptr,
+                                         &n_blk_elems,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr));
+    if (start_idx < 0 || count < 0 || start_idx + count > n_blk_elems)
+        throw Exception(fmt::sprintf("Element range [%d, %d) is out of bounds of block %d.",
+                                     start_idx,
+                                     start_idx + count,
+                                     block_id));
+    std::vector<double> values(count);
+    set_collective_access();
+    if (count > 0 || this->parallel)
+        EXODUSIICPP_CHECK_ERROR(ex_get_partial_var(this->exoid,
+                                                   time_step,
+                                                   EX_ELEM_BLOCK,
+                                                   var_idx,
+                                                   block_id,
+                                                   start_idx + 1,
+                                                   count,
+                                                   values.data()));
+    return values;
+}
+
+std::vector<double>
+File::get_partial_elemental_variable_values(int time_step,
+                                            int var_idx,
+                                            int64_t start_idx,
+                                            int64_t count) const
+{
+    if (start_idx < 0 || count < 0 || start_idx + count > this->blk_elem_ofst.back())
+        throw Exception(
+            fmt::sprintf("Element range [%d, %d) is out of bounds.", start_idx, start_idx + count));
+    std::vector<double> values(count, std::numeric_limits<double>::quiet_NaN());
+    std::size_t n_blks = this->blk_ids.size();
+    if (n_blks == 0)
+        return values;
+
+    auto truth_tab = elem_var_truth_table();
+    auto n_elem_vars = truth_tab.size() / n_blks;
+    check_elem_var_index(var_idx, n_elem_vars);
+
+    set_collective_access();
+    for (std::size_t i = 0; i < n_blks; i++) {
+        if (!truth_tab[i * n_elem_vars + var_idx - 1])
+            continue;
+        // part of the range that falls into the block, empty if they do not overlap
+        auto lo = std::max(start_idx, this->blk_elem_ofst[i]);
+        auto n = std::max<int64_t>(std::min(start_idx + count, this->blk_elem_ofst[i + 1]) - lo, 0);
+        if (n > 0 || this->parallel)
+            EXODUSIICPP_CHECK_ERROR(ex_get_partial_var(this->exoid,
+                                                       time_step,
+                                                       EX_ELEM_BLOCK,
+                                                       var_idx,
+                                                       this->blk_ids[i],
+                                                       lo - this->blk_elem_ofst[i] + 1,
+                                                       n,
+                                                       values.data() + lo - start_idx));
+    }
     return values;
 }
 
@@ -362,6 +963,16 @@ std::vector<double>
 File::get_elemental_variable_values(int time_step, int var_idx, int block_id) const
 {
     std::vector<double> values;
+    get_elemental_variable_values(time_step, var_idx, block_id, values);
+    return values;
+}
+
+void
+File::get_elemental_variable_values(int time_step,
+                                    int var_idx,
+                                    int block_id,
+                                    std::vector<double> & values) const
+{
     int n_blk_elems;
     EXODUSIICPP_CHECK_ERROR(ex_get_block(this->exoid,
                                          EX_ELEM_BLOCK,
@@ -380,9 +991,193 @@ File::get_elemental_variable_values(int time_step, int var_idx, int block_id) co
                                        block_id,
                                        n_blk_elems,
                                        values.data()));
+}
+
+void
+File::get_nodal_variable_steps(int var_idx,
+                               int begin_step,
+                               int end_step,
+                               std::vector<double> & values) const
+{
+    values.resize(static_cast<std::size_t>(end_step - begin_step + 1) * this->n_nodes);
+    EXODUSIICPP_CHECK_ERROR(ex_get_var_multi_time(this->exoid,
+                                                  EX_NODAL,
+                                                  var_idx,
+                                                  1,
+                                                  this->n_nodes,
+                                                  begin_step,
+                                                  end_step,
+                                                  values.data()));
+}
+
+void
+File::get_elemental_variable_steps(int var_idx,
+                                   int block_id,
+                                   int begin_step,
+                                   int end_step,
+                                   std::vector<double> & values) const
+{
+    int n_blk_elems;
+    EXODUSIICPP_CHECK_ERROR(ex_get_block(this->exoid,
+                                         EX_ELEM_BLOCK,
+                                         block_id,
+                                         nullptr,
+                                         &n_blk_elems,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr));
+    values.resize(static_cast<std::size_t>(end_step - begin_step + 1) * n_blk_elems);
+    EXODUSIICPP_CHECK_ERROR(ex_get_var_multi_time(this->exoid,
+                                                  EX_ELEM_BLOCK,
+                                                  var_idx,
+                                                  block_id,
+                                                  n_blk_elems,
+                                                  begin_step,
+                                                  end_step,
+                                                  values.data()));
+}
+
+int
+File::get_nodal_variable_steps_per_chunk(int var_idx) const
+{
+    return steps_per_chunk(this->exoid, fmt::sprintf("vals_nod_var%d", var_idx));
+}
+
+int
+File::get_elemental_variable_steps_per_chunk(int var_idx, int block_id) const
+{
+    auto blk_idx = get_element_block_index(block_id);
+    return steps_per_chunk(this->exoid, fmt::sprintf("vals_elem_var%deb%d", var_idx, blk_idx + 1));
+}
+
+std::vector<double>
+File::get_elemental_variable_values(int time_step, int var_idx) const
+{
+    int n_blks = this->blk_ids.size();
+    std::vector<double> values;
+    if (n_blks == 0)
+        return values;
+
+    auto truth_tab = elem_var_truth_table();
+    auto n_elem_vars = truth_tab.size() / n_blks;
+    check_elem_var_index(var_idx, n_elem_vars);
+
+    values.resize(this->blk_elem_ofst.back(), std::numeric_limits<double>::quiet_NaN());
+    for (int i = 0; i < n_blks; i++) {
+        auto n_blk_elems = this->blk_elem_ofst[i + 1] - this->blk_elem_ofst[i];
+        if (n_blk_elems > 0 && truth_tab[i * n_elem_vars + var_idx - 1])
+            EXODUSIICPP_CHECK_ERROR(ex_get_var(this->exoid,
+                                               time_step,
+                                               EX_ELEM_BLOCK,
+                                               var_idx,
+                                               this->blk_ids[i],
+                                               n_blk_elems,
+                                               values.data() + this->blk_elem_ofst[i]));
+    }
     return values;
 }
 
+uint64_t
+File::mesh_fingerprint(bool use_info_record, unsigned int n_threads, std::mutex * io_mutex) const
+{
+    if (use_info_record) {
+        std::vector<std::string> info;
+        {
+            auto lock = lock_io(io_mutex);
+            info = read_info();
+        }
+        for (auto & rec : info)
+            if (rec.compare(0, FINGERPRINT_RECORD.size(), FINGERPRINT_RECORD) == 0)
+                return std::strtoull(rec.c_str() + FINGERPRINT_RECORD.size(), nullptr, 16);
+    }
+
+    // counts are queried from the file, so that this works on files being written, too
+    char title[MAX_LINE_LENGTH + 1];
+    int dim, n_nodes, n_elems, n_blks, n_node_sets, n_side_sets;
+    {
+        auto lock = lock_io(io_mutex);
+        EXODUSIICPP_CHECK_ERROR(ex_get_init(this->exoid,
+                                            title,
+                                            &dim,
+                                            &n_nodes,
+                                            &n_elems,
+                                            &n_blks,
+                                            &n_node_sets,
+                                            &n_side_sets));
+    }
+
+    // chunks are hashed outside of the lock
+    FingerprintHash hash(n_threads);
+    for (int64_t n : { dim, n_nodes, n_elems, n_blks, n_node_sets, n_side_sets })
+        hash.add_value(n);
+
+    for (int64_t start = 0; start < n_nodes; start += FINGERPRINT_CHUNK_SIZE) {
+        auto count = std::min<int64_t>(FINGERPRINT_CHUNK_SIZE, n_nodes - start);
+        double * xyz[3];
+        for (int d = 0; d < 3; d++)
+            xyz[d] = hash.chunk_buffer<double>(d < dim ? count : 0);
+        {
+            auto lock = lock_io(io_mutex);
+            EXODUSIICPP_CHECK_ERROR(
+                ex_get_partial_coord(this->exoid, start + 1, count, xyz[0], xyz[1], xyz[2]));
+        }
+        hash.chunks_filled();
+    }
+
+    if (n_blks > 0) {
+        std::vector<int> blk_ids(n_blks);
+        {
+            auto lock = lock_io(io_mutex);
+            EXODUSIICPP_CHECK_ERROR(ex_get_ids(this->exoid, EX_ELEM_BLOCK, blk_ids.data()));
+        }
+        for (auto & id : blk_ids) {
+            char elem_type[MAX_STR_LENGTH + 1];
+            memset(elem_type, 0, sizeof(elem_type));
+            int n_elems_in_block;
+            int n_nodes_per_elem;
+            {
+                auto lock = lock_io(io_mutex);
+                EXODUSIICPP_CHECK_ERROR(ex_get_block(this->exoid,
+                                                     EX_ELEM_BLOCK,
+                                                     id,
+                                                     elem_type,
+                                                     &n_elems_in_block,
+                                                     &n_nodes_per_elem,
+                                                     nullptr,
+                                                     nullptr,
+                                                     nullptr));
+            }
+            hash.add_value(id);
+            hash.add_bytes(elem_type, strlen(elem_type));
+            hash.add_value(n_elems_in_block);
+            hash.add_value(n_nodes_per_elem);
+            if (n_nodes_per_elem <= 0)
+                continue;
+            for (int64_t start = 0; start < n_elems_in_block; start += FINGERPRINT_CHUNK_SIZE) {
+                auto count = std::min<int64_t>(FINGERPRINT_CHUNK_SIZE, n_elems_in_block - start);
+                auto connect = hash.chunk_buffer<int>((std::size_t) count * n_nodes_per_elem);
+                {
+                    auto lock = lock_io(io_mutex);
+                    EXODUSIICPP_CHECK_ERROR(ex_get_partial_conn(this->exoid,
+                                                                EX_ELEM_BLOCK,
+                                                                id,
+                                                                start + 1,
+                                                                count,
+                                                                connect,
+                                                                nullptr,
+                                                                nullptr));
+                }
+                hash.chunks_filled();
+            }
+        }
+    }
+
+    hash_sets(hash, this->exoid, EX_NODE_SET, n_node_sets, io_mutex);
+    hash_sets(hash, this->exoid, EX_SIDE_SET, n_side_sets, io_mutex);
+    return hash.digest();
+}
+
 std::vector<double>
 File::get_global_variable_values(int time_step) const
 {
@@ -406,6 +1201,102 @@ File::get_global_variable_values(int var_idx, int begin_idx, int end_idx) const
     return values;
 }
 
+GeometrySummary
+File::compute_geometry_summary(unsigned int n_threads) const
+{
+    if (this->n_nodes > 0 && this->x.size() != static_cast<std::size_t>(this->n_nodes))
+        throw Exception("Coordinates must be read before computing the geometry summary.");
+
+    int dim = std::min(std::max(this->n_dim, 0), 3);
+    const double * coords[3] = { this->x.data(), this->y.data(), this->z.data() };
+
+    GeometrySummary summary;
+    summary.bbox = empty_bounding_box(dim);
+    for (int d = 0; d < dim; d++)
+        coord_range(coords[d], this->n_nodes, summary.bbox.min[d], summary.bbox.max[d]);
+
+    // split the blocks into chunks of elements that are summarized independently and combined
+    // afterwards
+    struct Chunk {
+        std::size_t blk_idx;
+        int begin;
+        int end;
+        BoundingBox bbox;
+        double min_char_length;
+        double max_char_length;
+    };
+    std::vector<Chunk> chunks;
+    summary.blocks.resize(this->element_blocks.size());
+    for (std::size_t ib = 0; ib < this->element_blocks.size(); ib++) {
+        auto & blk = this->element_blocks[ib];
+        auto & geom = summary.blocks[ib];
+        geom.block_id = blk.get_id();
+        geom.bbox = empty_bounding_box(dim);
+        geom.min_char_length = std::numeric_limits<double>::max();
+        geom.max_char_length = 0.;
+
+        // blocks without nodes (e.g. NULL element blocks) have no geometry
+        int n_nodes_per_elem = blk.get_num_nodes_per_element();
+        int n_blk_elems = n_nodes_per_elem > 0 ? std::max(blk.get_num_elements(), 0) : 0;
+        geom.centroids.assign((std::size_t) 3 * n_blk_elems, 0.);
+        geom.char_lengths.resize(n_blk_elems);
+        for (int begin = 0; begin < n_blk_elems; begin += GEOMETRY_CHUNK_SIZE)
+            chunks.push_back(
+                { ib, begin, std::min(begin + GEOMETRY_CHUNK_SIZE, n_blk_elems), {}, 0., 0. });
+    }
+
+    internal::parallel_for(chunks.size(), n_threads, [&](std::size_t i) {
+        auto & chunk = chunks[i];
+        auto & blk = this->element_blocks[chunk.blk_idx];
+        auto & geom = summary.blocks[chunk.blk_idx];
+        chunk.bbox = empty_bounding_box(dim);
+        chunk.min_char_length = std::numeric_limits<double>::max();
+        chunk.max_char_length = 0.;
+
+        int n_nodes_per_elem = blk.get_num_nodes_per_element();
+        const int * connect = blk.get_connectivity().data();
+        for (int e = chunk.begin; e < chunk.end; e++) {
+            const int * elem_nodes = connect + (std::size_t) e * n_nodes_per_elem;
+            double h2 = 0.;
+            for (int d = 0; d < dim; d++) {
+                const double * c = coords[d];
+                double lo = c[elem_nodes[0] - 1];
+                double hi = lo;
+                double sum = 0.;
+                for (int i = 0; i < n_nodes_per_elem; i++) {
+                    double v = c[elem_nodes[i] - 1];
+                    lo = v < lo ? v : lo;
+                    hi = v > hi ? v : hi;
+                    sum += v;
+                }
+                geom.centroids[3 * e + d] = sum / n_nodes_per_elem;
+                chunk.bbox.min[d] = std::min(chunk.bbox.min[d], lo);
+                chunk.bbox.max[d] = std::max(chunk.bbox.max[d], hi);
+                h2 += (hi - lo) * (hi - lo);
+            }
+            double h = std::sqrt(h2);
+            geom.char_lengths[e] = h;
+            chunk.min_char_length = std::min(chunk.min_char_length, h);
+            chunk.max_char_length = std::max(chunk.max_char_length, h);
+        }
+    });
+
+    for (auto & chunk : chunks) {
+        auto & geom = summary.blocks[chunk.blk_idx];
+        for (int d = 0; d < dim; d++) {
+            geom.bbox.min[d] = std::min(geom.bbox.min[d], chunk.bbox.min[d]);
+            geom.bbox.max[d] = std::max(geom.bbox.max[d], chunk.bbox.max[d]);
+        }
+        geom.min_char_length = std::min(geom.min_char_length, chunk.min_char_length);
+        geom.max_char_length = std::max(geom.max_char_length, chunk.max_char_length);
+    }
+    for (auto & geom : summary.blocks)
+        if (geom.char_lengths.empty())
+            geom.min_char_length = 0.;
+
+    return summary;
+}
+
 // Read API
 
 void
@@ -464,6 +1355,18 @@ File::read_elem_map()
     EXODUSIICPP_CHECK_ERROR(ex_get_map(this->exoid, this->elem_map.data()));
 }
 
+void
+File::read_node_id_map()
+{
+    this->node_id_map.set_ids(read_id_map(this->exoid, EX_NODE_MAP, this->n_nodes));
+}
+
+void
+File::read_elem_id_map()
+{
+    this->elem_id_map.set_ids(read_id_map(this->exoid, EX_ELEM_MAP, this->n_elems));
+}
+
 void
 File::read_blocks()
 {
@@ -474,35 +1377,160 @@ File::read_blocks()
     EXODUSIICPP_CHECK_ERROR(ex_get_ids(this->exoid, EX_ELEM_BLOCK, block_ids.data()));
 
     for (auto & id : block_ids) {
-        char name[MAX_STR_LENGTH + 1];
-        EXODUSIICPP_CHECK_ERROR(ex_get_name(this->exoid, EX_ELEM_BLOCK, id, name));
+        ElementBlock eb = read_block_info(id);
+        if (eb.get_num_elements() > 0 && eb.get_num_nodes_per_element() > 0) {
+            std::vector<int> connect((std::size_t) eb.get_num_elements() *
+                                     eb.get_num_nodes_per_element());
+            EXODUSIICPP_CHECK_ERROR(
+                ex_get_conn(this->exoid, EX_ELEM_BLOCK, id, connect.data(), 0, 0));
+            eb.set_connectivity(eb.get_element_type().c_str(),
+                                eb.get_num_elements(),
+                                eb.get_num_nodes_per_element(),
+                                connect);
+        }
+
+        this->element_blocks.push_back(eb);
+    }
+}
+
+ElementBlock
+File::read_block_info(int block_id) const
+{
+    char name[MAX_STR_LENGTH + 1];
+    EXODUSIICPP_CHECK_ERROR(ex_get_name(this->exoid, EX_ELEM_BLOCK, block_id, name));
+
+    char elem_type[MAX_STR_LENGTH + 1];
+    int n_elems_in_block;
+    int n_nodes_per_elem;
+    int n_attrs;
+    EXODUSIICPP_CHECK_ERROR(ex_get_block(this->exoid,
+                                         EX_ELEM_BLOCK,
+                                         block_id,
+                                         elem_type,
+                                         &n_elems_in_block,
+                                         &n_nodes_per_elem,
+                                         nullptr,
+                                         nullptr,
+                                         &n_attrs));
+
+    ElementBlock eb;
+    eb.set_id(block_id);
+    eb.set_name(name);
+    eb.set_connectivity(elem_type, n_elems_in_block, n_nodes_per_elem, {});
+    return eb;
+}
+
+void
+File::read_partial_connectivity(int block_id,
+                                int64_t start_idx,
+                                int64_t count,
+                                std::vector<int> & connect) const
+{
+    int n_elems_in_block;
+    int n_nodes_per_elem;
+    EXODUSIICPP_CHECK_ERROR(ex_get_block(this->exoid,
+                                         EX_ELEM_BLOCK,
+                                         block_id,
+                                         nullptr,
+                                         &n_elems_in_block,
+                                         &n_nodes_per_elem,
+                                         nullptr,
+                                         nullptr,
+                                         nullptr));
+    if (start_idx < 0 || count < 0 || start_idx + count > n_elems_in_block)
+        throw Exception(fmt::sprintf("Element range [%d, %d) is out of bounds of block %d.",
+                                     start_idx,
+                                     start_idx + count,
+                                     block_id));
+
+    connect.resize((std::size_t) count * n_nodes_per_elem);
+    set_collective_access();
+    if (count > 0 || this->parallel)
+        EXODUSIICPP_CHECK_ERROR(ex_get_partial_conn(this->exoid,
+                                                    EX_ELEM_BLOCK,
+                                                    block_id,
+                                                    start_idx + 1,
+                                                    count,
+                                                    connect.data(),
+                                                    nullptr,
+                                                    nullptr));
+}
+
+void
+File::read_partial_coords(int64_t start_idx,
+                          int64_t count,
+                          std::vector<double> & x,
+                          std::vector<double> & y,
+                          std::vector<double> & z) const
+{
+    if (start_idx < 0 || count < 0 || start_idx + count > this->n_nodes)
+        throw Exception(
+            fmt::sprintf("Node range [%d, %d) is out of bounds.", start_idx, start_idx + count));
+
+    x.resize(count);
+    y.resize(this->n_dim >= 2 ? count : 0);
+    z.resize(this->n_dim >= 3 ? count : 0);
+    set_collective_access();
+    if (count > 0 || this->parallel)
+        EXODUSIICPP_CHECK_ERROR(ex_get_partial_coord(this->exoid,
+                                                     start_idx + 1,
+                                                     count,
+                                                     x.data(),
+                                                     this->n_dim >= 2 ? y.data() : nullptr,
+                                                     this->n_dim >= 3 ? z.data() : nullptr));
+}
 
+void
+File::read_connectivity()
+{
+    auto n_blks = this->blk_ids.size();
+    std::vector<std::string> elem_types;
+    std::vector<int> blk_type_tags(n_blks);
+    std::vector<int> blk_n_nodes_per_elem(n_blks);
+    for (std::size_t i = 0; i < n_blks; i++) {
         char elem_type[MAX_STR_LENGTH + 1];
         int n_elems_in_block;
-        int n_nodes_per_elem;
-        int n_attrs;
         EXODUSIICPP_CHECK_ERROR(ex_get_block(this->exoid,
                                              EX_ELEM_BLOCK,
-                                             id,
+                                             this->blk_ids[i],
                                              elem_type,
                                              &n_elems_in_block,
-                                             &n_nodes_per_elem,
+                                             &blk_n_nodes_per_elem[i],
                                              nullptr,
                                              nullptr,
-                                             &n_attrs));
+                                             nullptr));
+        auto it = std::find(elem_types.begin(), elem_types.end(), elem_type);
+        blk_type_tags[i] = it - elem_types.begin();
+        if (it == elem_types.end())
+            elem_types.emplace_back(elem_type);
+    }
 
-        ElementBlock eb;
-        eb.set_id(id);
-        eb.set_name(name);
-        if (n_elems_in_block > 0) {
-            std::vector<int> connect((std::size_t) n_elems_in_block * n_nodes_per_elem);
-            EXODUSIICPP_CHECK_ERROR(
-                ex_get_conn(this->exoid, EX_ELEM_BLOCK, id, connect.data(), 0, 0));
-            eb.set_connectivity(elem_type, n_elems_in_block, n_nodes_per_elem, connect);
+    auto n_all_elems = this->blk_elem_ofst.back();
+    std::vector<int64_t> offsets(n_all_elems + 1);
+    std::vector<int> type_tags(n_all_elems);
+    offsets[0] = 0;
+    for (std::size_t i = 0; i < n_blks; i++) {
+        for (auto e = this->blk_elem_ofst[i]; e < this->blk_elem_ofst[i + 1]; e++) {
+            offsets[e + 1] = offsets[e] + blk_n_nodes_per_elem[i];
+            type_tags[e] = blk_type_tags[i];
         }
+    }
 
-        this->element_blocks.push_back(eb);
+    std::vector<int> node_ids(offsets.back());
+    for (std::size_t i = 0; i < n_blks; i++) {
+        if (this->blk_elem_ofst[i + 1] > this->blk_elem_ofst[i])
+            EXODUSIICPP_CHECK_ERROR(ex_get_conn(this->exoid,
+                                                EX_ELEM_BLOCK,
+                                                this->blk_ids[i],
+                                                node_ids.data() + offsets[this->blk_elem_ofst[i]],
+                                                nullptr,
+                                                nullptr));
     }
+
+    this->connectivity.set(std::move(offsets),
+                           std::move(node_ids),
+                           std::move(type_tags),
+                           std::move(elem_types));
 }
 
 std::map<int, std::string>
@@ -517,27 +1545,37 @@ File::read_node_sets()
     if (this->n_node_sets <= 0)
         return;
 
-    std::vector<int> node_set_ids(this->n_node_sets);
-    EXODUSIICPP_CHECK_ERROR(ex_get_ids(this->exoid, EX_NODE_SET, node_set_ids.data()));
+    for (auto & id : read_node_set_ids())
+        this->node_sets.push_back(read_node_set(id));
+}
 
-    for (auto & id : node_set_ids) {
-        char name[MAX_STR_LENGTH + 1];
-        EXODUSIICPP_CHECK_ERROR(ex_get_name(this->exoid, EX_NODE_SET, id, name));
+std::vector<int>
+File::read_node_set_ids() const
+{
+    std::vector<int> ids(std::max(this->n_node_sets, 0));
+    if (!ids.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_get_ids(this->exoid, EX_NODE_SET, ids.data()));
+    return ids;
+}
 
-        int n_nodes;
-        int n_dfs;
-        EXODUSIICPP_CHECK_ERROR(ex_get_set_param(this->exoid, EX_NODE_SET, id, &n_nodes, &n_dfs));
+NodeSet
+File::read_node_set(int set_id) const
+{
+    char name[MAX_STR_LENGTH + 1];
+    EXODUSIICPP_CHECK_ERROR(ex_get_name(this->exoid, EX_NODE_SET, set_id, name));
 
-        std::vector<int> node_list(n_nodes);
-        EXODUSIICPP_CHECK_ERROR(ex_get_set(this->exoid, EX_NODE_SET, id, node_list.data(), 0));
+    int n_nodes;
+    int n_dfs;
+    EXODUSIICPP_CHECK_ERROR(ex_get_set_param(this->exoid, EX_NODE_SET, set_id, &n_nodes, &n_dfs));
 
-        NodeSet ns;
-        ns.set_id(id);
-        ns.set_name(name);
-        ns.set_nodes(node_list);
+    std::vector<int> node_list(n_nodes);
+    EXODUSIICPP_CHECK_ERROR(ex_get_set(this->exoid, EX_NODE_SET, set_id, node_list.data(), 0));
 
-        this->node_sets.push_back(ns);
-    }
+    NodeSet ns;
+    ns.set_id(set_id);
+    ns.set_name(name);
+    ns.set_nodes(node_list);
+    return ns;
 }
 
 std::map<int, std::string>
@@ -552,29 +1590,81 @@ File::read_side_sets()
     if (this->n_side_sets <= 0)
         return;
 
-    std::vector<int> side_set_ids(this->n_side_sets);
-    EXODUSIICPP_CHECK_ERROR(ex_get_ids(this->exoid, EX_SIDE_SET, side_set_ids.data()));
+    for (auto & id : read_side_set_ids())
+        this->side_sets.push_back(read_side_set(id));
+}
 
-    for (auto & id : side_set_ids) {
-        char name[MAX_STR_LENGTH + 1];
-        EXODUSIICPP_CHECK_ERROR(ex_get_name(this->exoid, EX_SIDE_SET, id, name));
+std::vector<std::string>
+File::read_info() const
+{
+    std::vector<std::string> info;
+    int n_info = ex_inquire_int(this->exoid, EX_INQ_INFO);
+    if (n_info <= 0)
+        return info;
 
-        int n_sides;
-        int n_dfs;
-        EXODUSIICPP_CHECK_ERROR(ex_get_set_param(this->exoid, EX_SIDE_SET, id, &n_sides, &n_dfs));
+    std::vector<char> buffer((std::size_t) n_info * (MAX_LINE_LENGTH + 1), 0);
+    std::vector<char *> records(n_info);
+    for (int i = 0; i < n_info; i++)
+        records[i] = buffer.data() + (std::size_t) i * (MAX_LINE_LENGTH + 1);
+    EXODUSIICPP_CHECK_ERROR(ex_get_info(this->exoid, records.data()));
+    for (auto & rec : records)
+        info.emplace_back(rec);
+    return info;
+}
 
-        std::vector<int> elem_list(n_sides);
-        std::vector<int> side_list(n_sides);
-        EXODUSIICPP_CHECK_ERROR(
-            ex_get_set(this->exoid, EX_SIDE_SET, id, elem_list.data(), side_list.data()));
+std::vector<int>
+File::read_elem_var_truth_table() const
+{
+    int n_blks = this->blk_ids.size();
+    int n_elem_vars;
+    EXODUSIICPP_CHECK_ERROR(ex_get_variable_param(this->exoid, EX_ELEM_BLOCK, &n_elem_vars));
+    std::vector<int> truth_tab((std::size_t) n_blks * n_elem_vars);
+    if (!truth_tab.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_get_truth_table(this->exoid,
+                                                   EX_ELEM_BLOCK,
+                                                   n_blks,
+                                                   n_elem_vars,
+                                                   truth_tab.data()));
+    return truth_tab;
+}
 
-        SideSet ss;
-        ss.set_id(id);
-        ss.set_name(name);
-        ss.set_sides(elem_list, side_list);
+std::vector<int>
+File::elem_var_truth_table() const
+{
+    if (!this->elem_var_tab.empty())
+        return this->elem_var_tab;
+    return read_elem_var_truth_table();
+}
 
-        this->side_sets.push_back(ss);
-    }
+std::vector<int>
+File::read_side_set_ids() const
+{
+    std::vector<int> ids(std::max(this->n_side_sets, 0));
+    if (!ids.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_get_ids(this->exoid, EX_SIDE_SET, ids.data()));
+    return ids;
+}
+
+SideSet
+File::read_side_set(int set_id) const
+{
+    char name[MAX_STR_LENGTH + 1];
+    EXODUSIICPP_CHECK_ERROR(ex_get_name(this->exoid, EX_SIDE_SET, set_id, name));
+
+    int n_sides;
+    int n_dfs;
+    EXODUSIICPP_CHECK_ERROR(ex_get_set_param(this->exoid, EX_SIDE_SET, set_id, &n_sides, &n_dfs));
+
+    std::vector<int> elem_list(n_sides);
+    std::vector<int> side_list(n_sides);
+    EXODUSIICPP_CHECK_ERROR(
+        ex_get_set(this->exoid, EX_SIDE_SET, set_id, elem_list.data(), side_list.data()));
+
+    SideSet ss;
+    ss.set_id(set_id);
+    ss.set_name(name);
+    ss.set_sides(elem_list, side_list);
+    return ss;
 }
 
 std::map<int, std::string>
@@ -593,23 +1683,144 @@ File::read_times()
 // Write API
 
 void
-File::write_coords(const std::vector<double> & x)
+File::set_reordering(const Reordering & reordering)
+{
+    if (this->file_access != FileAccess::WRITE)
+        throw Exception("Reordering can only be set on files opened for writing.");
+
+    if (!reordering.empty()) {
+        // counts are queried from the file, `init` does not keep them
+        char title[MAX_LINE_LENGTH + 1];
+        int dim, n_nodes, n_elems, n_blks, n_node_sets, n_side_sets;
+        EXODUSIICPP_CHECK_ERROR(ex_get_init(this->exoid,
+                                            title,
+                                            &dim,
+                                            &n_nodes,
+                                            &n_elems,
+                                            &n_blks,
+                                            &n_node_sets,
+                                            &n_side_sets));
+        if (reordering.get_num_nodes() != n_nodes || reordering.get_num_elements() != n_elems)
+            throw Exception(fmt::sprintf("Reordering of %d nodes and %d elements does not match "
+                                         "the file with %d nodes and %d elements.",
+                                         reordering.get_num_nodes(),
+                                         reordering.get_num_elements(),
+                                         n_nodes,
+                                         n_elems));
+    }
+
+    this->reordering = reordering;
+    if (!reordering.empty()) {
+        std::vector<int64_t> node_ids(reordering.get_num_nodes());
+        for (std::size_t i = 0; i < node_ids.size(); i++)
+            node_ids[i] = reordering.get_node_order()[i] + 1;
+        write_id_map(this->exoid, EX_NODE_MAP, node_ids);
+        this->node_id_map.set_ids(node_ids);
+
+        std::vector<int64_t> elem_ids(reordering.get_num_elements());
+        for (std::size_t i = 0; i < elem_ids.size(); i++)
+            elem_ids[i] = reordering.get_elem_order()[i] + 1;
+        write_id_map(this->exoid, EX_ELEM_MAP, elem_ids);
+        this->elem_id_map.set_ids(elem_ids);
+    }
+}
+
+const Reordering &
+File::get_reordering() const
+{
+    return this->reordering;
+}
+
+void
+File::write_coords(Span<const double> x)
+{
+    if (this->reordering.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, x.data(), nullptr, nullptr));
+    else {
+        check_nodal_size(this->reordering, x.size());
+        auto rx = this->reordering.permute_nodal(x);
+        EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, rx.data(), nullptr, nullptr));
+    }
+}
+
+void
+File::write_coords(std::initializer_list<double> x)
+{
+    write_coords(list_span(x));
+}
+
+void
+File::write_coords(Span<const double> x, Span<const double> y)
+{
+    if (this->reordering.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, x.data(), y.data(), nullptr));
+    else {
+        check_nodal_size(this->reordering, x.size());
+        check_nodal_size(this->reordering, y.size());
+        auto rx = this->reordering.permute_nodal(x);
+        auto ry = this->reordering.permute_nodal(y);
+        EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, rx.data(), ry.data(), nullptr));
+    }
+}
+
+void
+File::write_coords(std::initializer_list<double> x, std::initializer_list<double> y)
 {
-    EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, x.data(), nullptr, nullptr));
+    write_coords(list_span(x), list_span(y));
 }
 
 void
-File::write_coords(const std::vector<double> & x, const std::vector<double> & y)
+File::write_coords(Span<const double> x, Span<const double> y, Span<const double> z)
+{
+    if (this->reordering.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, x.data(), y.data(), z.data()));
+    else {
+        check_nodal_size(this->reordering, x.size());
+        check_nodal_size(this->reordering, y.size());
+        check_nodal_size(this->reordering, z.size());
+        auto rx = this->reordering.permute_nodal(x);
+        auto ry = this->reordering.permute_nodal(y);
+        auto rz = this->reordering.permute_nodal(z);
+        EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, rx.data(), ry.data(), rz.data()));
+    }
+}
+
+void
+File::write_coords(std::initializer_list<double> x,
+                   std::initializer_list<double> y,
+                   std::initializer_list<double> z)
 {
-    EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, x.data(), y.data(), nullptr));
+    write_coords(list_span(x), list_span(y), list_span(z));
 }
 
 void
-File::write_coords(const std::vector<double> & x,
-                   const std::vector<double> & y,
-                   const std::vector<double> & z)
+File::write_partial_coords(int64_t start_idx,
+                           Span<const double> x,
+                           Span<const double> y,
+                           Span<const double> z)
+{
+    if (!this->reordering.empty())
+        throw Exception("Partial writes are not supported with reordering.");
+    if ((!y.empty() && y.size() != x.size()) || (!z.empty() && z.size() != x.size()))
+        throw Exception("Coordinate arrays must have the same size.");
+    if (x.empty() && !this->parallel)
+        return;
+    set_collective_access();
+    EXODUSIICPP_CHECK_ERROR(ex_put_partial_coord(this->exoid,
+                                                 start_idx + 1,
+                                                 x.size(),
+                                                 x.data(),
+                                                 y.empty() ? nullptr : y.data(),
+                                                 z.empty() ? nullptr : z.data()));
+}
+
+void
+File::write_partial_coords(int64_t start_idx,
+                           std::initializer_list<double> x,
+                           std::initializer_list<double> y,
+                           std::initializer_list<double> z)
 {
-    EXODUSIICPP_CHECK_ERROR(ex_put_coord(this->exoid, x.data(), y.data(), z.data()));
+    write_partial_coords(start_idx, list_span(x), list_span(y), list_span(z));
 }
 
 void
@@ -640,10 +1851,122 @@ File::write_info(std::vector<std::string> info)
     EXODUSIICPP_CHECK_ERROR(ex_put_info(this->exoid, (int) info.size(), (char **) arr.data()));
 }
 
+void
+File::write_info_with_fingerprint(std::vector<std::string> info)
+{
+    info.push_back(fmt::sprintf("%s%016x", FINGERPRINT_RECORD, mesh_fingerprint(false)));
+    write_info(std::move(info));
+}
+
+void
+File::write_node_id_map(const std::vector<int64_t> & ids)
+{
+    if (this->reordering.empty()) {
+        write_id_map(this->exoid, EX_NODE_MAP, ids);
+        this->node_id_map.set_ids(ids);
+    }
+    else {
+        check_nodal_size(this->reordering, ids.size());
+        auto rids = this->reordering.permute_nodal(ids);
+        write_id_map(this->exoid, EX_NODE_MAP, rids);
+        this->node_id_map.set_ids(rids);
+    }
+}
+
+void
+File::write_elem_id_map(const std::vector<int64_t> & ids)
+{
+    if (this->reordering.empty()) {
+        write_id_map(this->exoid, EX_ELEM_MAP, ids);
+        this->elem_id_map.set_ids(ids);
+    }
+    else {
+        if (ids.size() != static_cast<std::size_t>(this->reordering.get_num_elements()))
+            throw Exception("The number of IDs must be equal to the number of elements.");
+        auto rids = this->reordering.permute_elemental(ids);
+        write_id_map(this->exoid, EX_ELEM_MAP, rids);
+        this->elem_id_map.set_ids(rids);
+    }
+}
+
+void
+File::write_load_balance(const LoadBalance & lb)
+{
+    EXODUSIICPP_CHECK_ERROR(ex_put_init_info(this->exoid, lb.n_parts, 1, (char *) "p"));
+    EXODUSIICPP_CHECK_ERROR(ex_put_init_global(this->exoid,
+                                               lb.n_global_nodes,
+                                               lb.n_global_elems,
+                                               lb.global_blk_ids.size(),
+                                               lb.global_ns_ids.size(),
+                                               lb.global_ss_ids.size()));
+    if (!lb.global_blk_ids.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_eb_info_global(this->exoid,
+                                                      lb.global_blk_ids.data(),
+                                                      lb.global_blk_counts.data()));
+    if (!lb.global_ns_ids.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_ns_param_global(this->exoid,
+                                                       lb.global_ns_ids.data(),
+                                                       lb.global_ns_counts.data(),
+                                                       nullptr));
+    if (!lb.global_ss_ids.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_ss_param_global(this->exoid,
+                                                       lb.global_ss_ids.data(),
+                                                       lb.global_ss_counts.data(),
+                                                       nullptr));
+    EXODUSIICPP_CHECK_ERROR(ex_put_loadbal_param(this->exoid,
+                                                 lb.internal_nodes.size(),
+                                                 lb.border_nodes.size(),
+                                                 0,
+                                                 lb.internal_elems.size(),
+                                                 lb.border_elems.size(),
+                                                 lb.node_cmaps.size(),
+                                                 lb.elem_cmaps.size(),
+                                                 lb.part));
+
+    std::vector<int> node_cmap_ids, node_cmap_cnts, elem_cmap_ids, elem_cmap_cnts;
+    for (auto & cmap : lb.node_cmaps) {
+        node_cmap_ids.push_back(cmap.id);
+        node_cmap_cnts.push_back(cmap.ids.size());
+    }
+    for (auto & cmap : lb.elem_cmaps) {
+        elem_cmap_ids.push_back(cmap.id);
+        elem_cmap_cnts.push_back(cmap.ids.size());
+    }
+    if (!node_cmap_ids.empty() || !elem_cmap_ids.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_cmap_params(this->exoid,
+                                                   node_cmap_ids.data(),
+                                                   node_cmap_cnts.data(),
+                                                   elem_cmap_ids.data(),
+                                                   elem_cmap_cnts.data(),
+                                                   lb.part));
+
+    EXODUSIICPP_CHECK_ERROR(ex_put_processor_node_maps(this->exoid,
+                                                       lb.internal_nodes.data(),
+                                                       lb.border_nodes.data(),
+                                                       nullptr,
+                                                       lb.part));
+    EXODUSIICPP_CHECK_ERROR(ex_put_processor_elem_maps(this->exoid,
+                                                       lb.internal_elems.data(),
+                                                       lb.border_elems.data(),
+                                                       lb.part));
+    for (auto & cmap : lb.node_cmaps)
+        EXODUSIICPP_CHECK_ERROR(
+            ex_put_node_cmap(this->exoid, cmap.id, cmap.ids.data(), cmap.procs.data(), lb.part));
+    for (auto & cmap : lb.elem_cmaps)
+        EXODUSIICPP_CHECK_ERROR(ex_put_elem_cmap(this->exoid,
+                                                 cmap.id,
+                                                 cmap.ids.data(),
+                                                 cmap.sides.data(),
+                                                 cmap.procs.data(),
+                                                 lb.part));
+}
+
 void
 File::write_time(int time_step, double time)
 {
     EXODUSIICPP_CHECK_ERROR(ex_put_time(this->exoid, time_step, &time));
+    if (this->append_cache)
+        this->n_times = std::max(this->n_times, time_step);
 }
 
 void
@@ -657,7 +1980,14 @@ File::write_node_set(int64_t set_id, const std::vector<int> & node_set)
 {
     EXODUSIICPP_CHECK_ERROR(
         ex_put_set_param(this->exoid, EX_NODE_SET, set_id, (int64_t) node_set.size(), 0));
-    EXODUSIICPP_CHECK_ERROR(ex_put_set(this->exoid, EX_NODE_SET, set_id, node_set.data(), nullptr));
+    if (this->reordering.empty())
+        EXODUSIICPP_CHECK_ERROR(
+            ex_put_set(this->exoid, EX_NODE_SET, set_id, node_set.data(), nullptr));
+    else {
+        auto nodes = renumber(this->reordering.get_node_index(), node_set);
+        EXODUSIICPP_CHECK_ERROR(
+            ex_put_set(this->exoid, EX_NODE_SET, set_id, nodes.data(), nullptr));
+    }
 }
 
 void
@@ -674,8 +2004,14 @@ File::write_side_set(int64_t set_id,
     if (elem_list.size() == side_list.size()) {
         EXODUSIICPP_CHECK_ERROR(
             ex_put_set_param(this->exoid, EX_SIDE_SET, set_id, (int64_t) elem_list.size(), 0));
-        EXODUSIICPP_CHECK_ERROR(
-            ex_put_set(this->exoid, EX_SIDE_SET, set_id, elem_list.data(), side_list.data()));
+        if (this->reordering.empty())
+            EXODUSIICPP_CHECK_ERROR(
+                ex_put_set(this->exoid, EX_SIDE_SET, set_id, elem_list.data(), side_list.data()));
+        else {
+            auto elems = renumber(this->reordering.get_elem_index(), elem_list);
+            EXODUSIICPP_CHECK_ERROR(
+                ex_put_set(this->exoid, EX_SIDE_SET, set_id, elems.data(), side_list.data()));
+        }
     }
     else
         throw Exception("The length of elem_list must be equal to the length of side_list.");
@@ -691,44 +2027,238 @@ void
 File::write_block(int64_t blk_id,
                   const char * elem_type,
                   int64_t n_elems_in_block,
-                  const std::vector<int> & connect)
+                  Span<const int> connect)
+{
+    if (n_elems_in_block < 0 || (n_elems_in_block == 0 && !connect.empty()) ||
+        (n_elems_in_block > 0 && connect.size() % n_elems_in_block != 0))
+        throw Exception(
+            fmt::sprintf("Connectivity of element block %d does not match its %d elements.",
+                         blk_id,
+                         n_elems_in_block));
+    auto n_per_elem = n_elems_in_block > 0 ? connect.size() / n_elems_in_block : 0;
+
+    if (this->reordering.empty()) {
+        write_block_info(blk_id, elem_type, n_elems_in_block, n_per_elem);
+        if (!connect.empty())
+            EXODUSIICPP_CHECK_ERROR(
+                ex_put_conn(this->exoid, EX_ELEM_BLOCK, blk_id, connect.data(), nullptr, nullptr));
+        return;
+    }
+
+    // the block is checked and renumbered before anything is written, `write_block_info` appends
+    // it to `blk_ids`
+    auto blk_idx = this->blk_ids.size();
+    auto & rblk_ofst = this->reordering.get_block_offsets();
+    if (blk_idx + 1 >= rblk_ofst.size() ||
+        rblk_ofst[blk_idx + 1] - rblk_ofst[blk_idx] != n_elems_in_block)
+        throw Exception(fmt::sprintf(
+            "Element block %d does not match the blocks the reordering was computed for.",
+            blk_id));
+
+    // element `e` of the block in the new order is element `elem_order[ofst + e] - ofst` of the
+    // block in the original order
+    auto ofst = rblk_ofst[blk_idx];
+    auto & node_index = this->reordering.get_node_index();
+    auto & elem_order = this->reordering.get_elem_order();
+    std::vector<int> rconnect(connect.size());
+    for (int64_t e = 0; e < n_elems_in_block; e++) {
+        auto src = (elem_order[ofst + e] - ofst) * n_per_elem;
+        for (std::size_t k = 0; k < n_per_elem; k++) {
+            auto n = connect[src + k];
+            if (n < 1 || static_cast<std::size_t>(n) > node_index.size())
+                throw Exception(
+                    fmt::sprintf("Element block %d references node %d which does not exist.",
+                                 blk_id,
+                                 n));
+            rconnect[e * n_per_elem + k] = static_cast<int>(node_index[n - 1] + 1);
+        }
+    }
+    write_block_info(blk_id, elem_type, n_elems_in_block, n_per_elem);
+    if (!rconnect.empty())
+        EXODUSIICPP_CHECK_ERROR(
+            ex_put_conn(this->exoid, EX_ELEM_BLOCK, blk_id, rconnect.data(), nullptr, nullptr));
+}
+
+void
+File::write_block(int64_t blk_id,
+                  const char * elem_type,
+                  int64_t n_elems_in_block,
+                  std::initializer_list<int> connect)
+{
+    write_block(blk_id, elem_type, n_elems_in_block, list_span(connect));
+}
+
+void
+File::write_block_info(int64_t blk_id,
+                       const char * elem_type,
+                       int64_t n_elems_in_block,
+                       int64_t n_nodes_per_elem)
 {
     EXODUSIICPP_CHECK_ERROR(ex_put_block(this->exoid,
                                          EX_ELEM_BLOCK,
                                          blk_id,
                                          elem_type,
                                          n_elems_in_block,
-                                         connect.size() / n_elems_in_block,
+                                         n_nodes_per_elem,
                                          0,
                                          0,
                                          0));
-    EXODUSIICPP_CHECK_ERROR(
-        ex_put_conn(this->exoid, EX_ELEM_BLOCK, blk_id, connect.data(), nullptr, nullptr));
+    this->blk_ids.push_back(blk_id);
+    this->blk_elem_ofst.push_back(this->blk_elem_ofst.back() + n_elems_in_block);
+}
+
+void
+File::write_partial_connectivity(int64_t blk_id,
+                                 int64_t start_idx,
+                                 int64_t count,
+                                 Span<const int> connect)
+{
+    if (!this->reordering.empty())
+        throw Exception("Partial writes are not supported with reordering.");
+    if (count <= 0 && !this->parallel)
+        return;
+    set_collective_access();
+    EXODUSIICPP_CHECK_ERROR(ex_put_partial_conn(this->exoid,
+                                                EX_ELEM_BLOCK,
+                                                blk_id,
+                                                start_idx + 1,
+                                                count,
+                                                connect.data(),
+                                                nullptr,
+                                                nullptr));
+}
+
+void
+File::write_partial_connectivity(int64_t blk_id,
+                                 int64_t start_idx,
+                                 int64_t count,
+                                 std::initializer_list<int> connect)
+{
+    write_partial_connectivity(blk_id, start_idx, count, list_span(connect));
 }
 
 void
 File::write_nodal_var_names(const std::vector<std::string> & var_names)
 {
     write_variable_names(this->exoid, EX_NODAL, var_names);
+    if (this->append_cache) {
+        this->nodal_var_names = var_names;
+    }
 }
 
 void
 File::write_elem_var_names(const std::vector<std::string> & var_names)
 {
     write_variable_names(this->exoid, EX_ELEM_BLOCK, var_names);
+    this->elem_var_names = var_names;
+    // no truth table is stored yet, the variables are defined on the blocks they are written on
+    this->elem_var_tab.clear();
 }
 
 void
 File::write_global_var_names(const std::vector<std::string> & var_names)
 {
     write_variable_names(this->exoid, EX_GLOBAL, var_names);
+    if (this->append_cache) {
+        this->global_var_names = var_names;
+    }
+}
+
+void
+File::write_elem_var_truth_table(const std::vector<int> & table)
+{
+    int n_blks = this->blk_ids.size();
+    int n_elem_vars;
+    EXODUSIICPP_CHECK_ERROR(ex_get_variable_param(this->exoid, EX_ELEM_BLOCK, &n_elem_vars));
+    if (table.size() != (std::size_t) n_blks * n_elem_vars)
+        throw Exception("The size of the truth table must be equal to the number of element "
+                        "blocks times the number of elemental variables.");
+    if (!table.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_truth_table(this->exoid,
+                                                   EX_ELEM_BLOCK,
+                                                   n_blks,
+                                                   n_elem_vars,
+                                                   const_cast<int *>(table.data())));
+    this->elem_var_tab = table;
+}
+
+void
+File::write_nodal_var(int step_num, int var_index, Span<const double> values)
+{
+    if (this->reordering.empty())
+        EXODUSIICPP_CHECK_ERROR(ex_put_var(
+            this->exoid, step_num, EX_NODAL, var_index, 0, values.size(), values.data()));
+    else {
+        check_nodal_size(this->reordering, values.size());
+        auto rvalues = this->reordering.permute_nodal(values);
+        EXODUSIICPP_CHECK_ERROR(ex_put_var(
+            this->exoid, step_num, EX_NODAL, var_index, 0, rvalues.size(), rvalues.data()));
+    }
 }
 
 void
-File::write_nodal_var(int step_num, int var_index, const std::vector<double> & values)
+File::write_nodal_var(int step_num, int var_index, std::initializer_list<double> values)
 {
-    EXODUSIICPP_CHECK_ERROR(
-        ex_put_var(this->exoid, step_num, EX_NODAL, var_index, 0, values.size(), values.data()));
+    write_nodal_var(step_num, var_index, list_span(values));
+}
+
+void
+File::write_elem_var(int step_num, int var_index, Span<const double> values)
+{
+    if (values.size() != static_cast<std::size_t>(this->blk_elem_ofst.back()))
+        throw Exception("The number of values must be equal to the number of elements.");
+
+    std::vector<double> rvalues;
+    if (!this->reordering.empty())
+        rvalues = this->reordering.permute_elemental(values);
+    const double * vals = this->reordering.empty() ? values.data() : rvalues.data();
+    // skip blocks the variable is not defined on, if the file stores a truth table
+    auto n_elem_vars = this->blk_ids.empty() ? 0 : this->elem_var_tab.size() / this->blk_ids.size();
+    bool use_tab = var_index >= 1 && (std::size_t) var_index <= n_elem_vars;
+    for (std::size_t i = 0; i < this->blk_ids.size(); i++) {
+        auto n_blk_elems = this->blk_elem_ofst[i + 1] - this->blk_elem_ofst[i];
+        if (use_tab && !this->elem_var_tab[i * n_elem_vars + var_index - 1])
+            continue;
+        if (n_blk_elems > 0)
+            EXODUSIICPP_CHECK_ERROR(ex_put_var(this->exoid,
+                                               step_num,
+                                               EX_ELEM_BLOCK,
+                                               var_index,
+                                               this->blk_ids[i],
+                                               n_blk_elems,
+                                               vals + this->blk_elem_ofst[i]));
+    }
+}
+
+void
+File::write_elem_var(int step_num, int var_index, std::initializer_list<double> values)
+{
+    write_elem_var(step_num, var_index, list_span(values));
+}
+
+void
+File::write_elem_var(int step_num, int var_index, int64_t blk_id, Span<const double> values)
+{
+    if (!this->reordering.empty())
+        throw Exception("Writing values of a single block is not supported with reordering.");
+    if (values.empty())
+        return;
+    EXODUSIICPP_CHECK_ERROR(ex_put_var(this->exoid,
+                                       step_num,
+                                       EX_ELEM_BLOCK,
+                                       var_index,
+                                       blk_id,
+                                       values.size(),
+                                       values.data()));
+}
+
+void
+File::write_elem_var(int step_num,
+                     int var_index,
+                     int64_t blk_id,
+                     std::initializer_list<double> values)
+{
+    write_elem_var(step_num, var_index, blk_id, list_span(values));
 }
 
 void
@@ -738,6 +2268,12 @@ File::write_partial_nodal_var(int step_num,
                               int64_t start_index,
                               double var_value)
 {
+    if (!this->reordering.empty()) {
+        auto & node_index = this->reordering.get_node_index();
+        if (start_index < 1 || static_cast<std::size_t>(start_index) > node_index.size())
+            throw Exception(fmt::sprintf("Node index %d is out of range.", start_index));
+        start_index = node_index[start_index - 1] + 1;
+    }
     EXODUSIICPP_CHECK_ERROR(ex_put_partial_var(this->exoid,
                                                step_num,
                                                EX_NODAL,
@@ -755,6 +2291,16 @@ File::write_partial_elem_var(int step_num,
                              int64_t start_index,
                              double var_value)
 {
+    if (!this->reordering.empty()) {
+        auto blk_idx = get_element_block_index(obj_id);
+        auto ofst = this->blk_elem_ofst[blk_idx];
+        auto & elem_index = this->reordering.get_elem_index();
+        if (start_index < 1 || start_index > this->blk_elem_ofst[blk_idx + 1] - ofst ||
+            static_cast<std::size_t>(ofst + start_index) > elem_index.size())
+            throw Exception(
+                fmt::sprintf("Element index %d is out of range in block %d.", start_index, obj_id));
+        start_index = elem_index[ofst + start_index - 1] - ofst + 1;
+    }
     EXODUSIICPP_CHECK_ERROR(ex_put_partial_var(this->exoid,
                                                step_num,
                                                EX_ELEM_BLOCK,
@@ -765,12 +2311,163 @@ File::write_partial_elem_var(int step_num,
                                                &var_value));
 }
 
+void
+File::write_partial_nodal_var_range(int step_num,
+                                    int var_index,
+                                    int64_t start_idx,
+                                    Span<const double> values)
+{
+    if (!this->reordering.empty())
+        throw Exception("Partial writes are not supported with reordering.");
+    if (values.empty() && !this->parallel)
+        return;
+    set_collective_access();
+    EXODUSIICPP_CHECK_ERROR(ex_put_partial_var(this->exoid,
+                                               step_num,
+                                               EX_NODAL,
+                                               var_index,
+                                               1,
+                                               start_idx + 1,
+                                               values.size(),
+                                               values.data()));
+}
+
+void
+File::write_partial_nodal_var_range(int step_num,
+                                    int var_index,
+                                    int64_t start_idx,
+                                    std::initializer_list<double> values)
+{
+    write_partial_nodal_var_range(step_num, var_index, start_idx, list_span(values));
+}
+
+void
+File::write_partial_elem_var_range(int step_num,
+                                   int var_index,
+                                   int64_t blk_id,
+                                   int64_t start_idx,
+                                   Span<const double> values)
+{
+    if (!this->reordering.empty())
+        throw Exception("Partial writes are not supported with reordering.");
+    if (values.empty() && !this->parallel)
+        return;
+    set_collective_access();
+    EXODUSIICPP_CHECK_ERROR(ex_put_partial_var(this->exoid,
+                                               step_num,
+                                               EX_ELEM_BLOCK,
+                                               var_index,
+                                               blk_id,
+                                               start_idx + 1,
+                                               values.size(),
+                                               values.data()));
+}
+
+void
+File::write_partial_elem_var_range(int step_num,
+                                   int var_index,
+                                   int64_t blk_id,
+                                   int64_t start_idx,
+                                   std::initializer_list<double> values)
+{
+    write_partial_elem_var_range(step_num, var_index, blk_id, start_idx, list_span(values));
+}
+
+void
+File::write_partial_elem_var_range(int step_num,
+                                   int var_index,
+                                   int64_t start_idx,
+                                   Span<const double> values)
+{
+    if (!this->reordering.empty())
+        throw Exception("Partial writes are not supported with reordering.");
+    auto end_idx = start_idx + static_cast<int64_t>(values.size());
+    if (start_idx < 0 || end_idx > this->blk_elem_ofst.back())
+        throw Exception(
+            fmt::sprintf("Element range [%d, %d) is out of bounds.", start_idx, end_idx));
+    if (values.empty() && !this->parallel)
+        return;
+    set_collective_access();
+    for (std::size_t i = 0; i < this->blk_ids.size(); i++) {
+        auto lo = std::max(start_idx, this->blk_elem_ofst[i]);
+        auto n = std::max<int64_t>(std::min(end_idx, this->blk_elem_ofst[i + 1]) - lo, 0);
+        if (n > 0 || this->parallel)
+            EXODUSIICPP_CHECK_ERROR(ex_put_partial_var(this->exoid,
+                                                       step_num,
+                                                       EX_ELEM_BLOCK,
+                                                       var_index,
+                                                       this->blk_ids[i],
+                                                       lo - this->blk_elem_ofst[i] + 1,
+                                                       n,
+                                                       values.data() + lo - start_idx));
+    }
+}
+
+void
+File::write_partial_elem_var_range(int step_num,
+                                   int var_index,
+                                   int64_t start_idx,
+                                   std::initializer_list<double> values)
+{
+    write_partial_elem_var_range(step_num, var_index, start_idx, list_span(values));
+}
+
 void
 File::write_global_var(int step_num, int var_index, double value)
 {
     EXODUSIICPP_CHECK_ERROR(ex_put_var(this->exoid, step_num, EX_GLOBAL, var_index, 0, 1, &value));
 }
 
+void
+File::write_global_vars(int step_num, Span<const double> values)
+{
+    if (values.empty())
+        return;
+    EXODUSIICPP_CHECK_ERROR(
+        ex_put_var(this->exoid, step_num, EX_GLOBAL, 1, 0, values.size(), values.data()));
+}
+
+void
+File::write_global_vars(int step_num, std::initializer_list<double> values)
+{
+    write_global_vars(step_num, list_span(values));
+}
+
+int
+File::append_step(double time,
+                  const std::vector<Span<const double>> & nodal,
+                  const std::vector<Span<const double>> & elemental,
+                  Span<const double> global)
+{
+    if (!this->append_cache)
+        throw Exception("Appending a time step requires a file opened in append mode.");
+    if (nodal.size() != this->nodal_var_names.size())
+        throw Exception("The number of nodal value arrays must be equal to the number of nodal "
+                        "variables.");
+    if (elemental.size() != this->elem_var_names.size())
+        throw Exception("The number of elemental value arrays must be equal to the number of "
+                        "elemental variables.");
+    if (global.size() != this->global_var_names.size())
+        throw Exception("The number of global values must be equal to the number of global "
+                        "variables.");
+    for (auto & values : nodal)
+        if (values.size() != static_cast<std::size_t>(this->n_nodes))
+            throw Exception("The number of values must be equal to the number of nodes.");
+    for (auto & values : elemental)
+        if (values.size() != static_cast<std::size_t>(this->blk_elem_ofst.back()))
+            throw Exception("The number of values must be equal to the number of elements.");
+
+    StepWriter writer(*this);
+    writer.add_global_vars(global);
+    for (std::size_t i = 0; i < nodal.size(); i++)
+        writer.add_nodal_var(i + 1, nodal[i]);
+    for (std::size_t i = 0; i < elemental.size(); i++)
+        writer.add_elem_var(i + 1, elemental[i]);
+    int step_num = this->n_times + 1;
+    writer.write(step_num, time);
+    return step_num;
+}
+
 void
 File::update()
 {
@@ -783,6 +2480,9 @@ File::close()
     if (is_opened()) {
         EXODUSIICPP_CHECK_ERROR(ex_close(this->exoid));
         this->exoid = -1;
+        this->parallel = false;
+        this->append_cache = false;
+        this->elem_var_tab.clear();
     }
 }
 
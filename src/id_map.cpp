@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/id_map.h"
+#include "exodusIIcpp/exception.h"
+#include "fmt/printf.h"
+#include <algorithm>
+
+namespace exodusIIcpp {
+
+static inline std::size_t
+hash_id(int64_t id)
+{
+    auto h = static_cast<uint64_t>(id);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
+/// Offset of `id` from `min_id`, computed unsigned so that extreme IDs do not overflow
+static inline uint64_t
+offset(int64_t id, int64_t min_id)
+{
+    return static_cast<uint64_t>(id) - static_cast<uint64_t>(min_id);
+}
+
+IdMap::IdMap() : min_id(0) {}
+
+std::size_t
+IdMap::get_size() const
+{
+    return this->ids.size();
+}
+
+int64_t
+IdMap::get_id(std::size_t idx) const
+{
+    if (idx < this->ids.size())
+        return this->ids[idx];
+    else
+        throw Exception("Index of out bounds.");
+}
+
+int64_t
+IdMap::get_index(int64_t id) const
+{
+    if (!this->dense.empty()) {
+        auto ofst = offset(id, this->min_id);
+        return ofst < this->dense.size() ? this->dense[ofst] : -1;
+    }
+    else if (!this->hash_values.empty()) {
+        std::size_t mask = this->hash_keys.size() - 1;
+        for (std::size_t slot = hash_id(id) & mask;; slot = (slot + 1) & mask) {
+            if (this->hash_values[slot] == -1)
+                return -1;
+            if (this->hash_keys[slot] == id)
+                return this->hash_values[slot];
+        }
+    }
+    else
+        return -1;
+}
+
+const std::vector<int64_t> &
+IdMap::get_ids() const
+{
+    return this->ids;
+}
+
+void
+IdMap::set_ids(const std::vector<int64_t> & ids)
+{
+    auto prev_ids = std::move(this->ids);
+    this->ids = ids;
+    try {
+        build_reverse_lookup();
+    }
+    catch (...) {
+        // the lookup was left untouched, restore the IDs it was built for
+        this->ids = std::move(prev_ids);
+        throw;
+    }
+}
+
+void
+IdMap::build_reverse_lookup()
+{
+    // build into locals, so that a duplicate ID leaves the map as it was
+    int64_t min_id = 0;
+    std::vector<int64_t> dense, hash_keys, hash_values;
+    if (!this->ids.empty()) {
+        auto mm = std::minmax_element(this->ids.begin(), this->ids.end());
+        auto n = static_cast<int64_t>(this->ids.size());
+        auto range = offset(*mm.second, *mm.first);
+        // IDs are compact enough when a dense table takes at most twice the space of the map
+        if (range < 2 * static_cast<uint64_t>(n)) {
+            min_id = *mm.first;
+            dense.assign(range + 1, -1);
+            for (int64_t i = 0; i < n; i++) {
+                auto & idx = dense[offset(this->ids[i], min_id)];
+                if (idx != -1)
+                    throw Exception(fmt::sprintf("Duplicate ID %d in the ID map.", this->ids[i]));
+                idx = i;
+            }
+        }
+        else {
+            // keep the load factor at or below 0.5
+            std::size_t capacity = 1;
+            while (capacity < 2 * this->ids.size())
+                capacity <<= 1;
+            hash_keys.assign(capacity, 0);
+            hash_values.assign(capacity, -1);
+            std::size_t mask = capacity - 1;
+            for (int64_t i = 0; i < n; i++) {
+                auto id = this->ids[i];
+                std::size_t slot = hash_id(id) & mask;
+                while (hash_values[slot] != -1) {
+                    if (hash_keys[slot] == id)
+                        throw Exception(fmt::sprintf("Duplicate ID %d in the ID map.", id));
+                    slot = (slot + 1) & mask;
+                }
+                hash_keys[slot] = id;
+                hash_values[slot] = i;
+            }
+        }
+    }
+
+    this->min_id = min_id;
+    this->dense = std::move(dense);
+    this->hash_keys = std::move(hash_keys);
+    this->hash_values = std::move(hash_values);
+}
+
+} // namespace exodusIIcpp
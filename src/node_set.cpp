@@ -3,10 +3,73 @@
 
 #include "exodusIIcpp/node_set.h"
 #include "exodusIIcpp/exception.h"
+#include <algorithm>
+#include <iterator>
+#if __cplusplus >= 202002L
+    #include <bit>
+#endif
 
 namespace exodusIIcpp {
 
-NodeSet::NodeSet() : id(-1) {}
+/// Index of the bitset word that holds `node_id`
+static inline int64_t
+word_index(int node_id)
+{
+    return static_cast<int64_t>(node_id) >> 6;
+}
+
+/// Mask of the bit that represents `node_id` within its bitset word
+static inline uint64_t
+bit_mask(int node_id)
+{
+    return uint64_t(1) << (node_id & 63);
+}
+
+/// Position of the lowest set bit of a nonzero word
+static inline int
+count_trailing_zeros(uint64_t word)
+{
+#if __cplusplus >= 202002L
+    return std::countr_zero(word);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int n = 0;
+    for (; (word & 1) == 0; word >>= 1)
+        n++;
+    return n;
+#endif
+}
+
+/// Copy bitset words into the word range `[lo, hi)`, words outside of `bits` are zero
+static std::vector<uint64_t>
+align_bits(const std::vector<uint64_t> & bits, int64_t first_word, int64_t lo, int64_t hi)
+{
+    std::vector<uint64_t> aligned(std::max<int64_t>(hi - lo, 0), 0);
+    int64_t begin = std::max(lo, first_word);
+    int64_t end = std::min(hi, first_word + static_cast<int64_t>(bits.size()));
+    for (int64_t w = begin; w < end; w++)
+        aligned[w - lo] = bits[w - first_word];
+    return aligned;
+}
+
+/// Convert bitset words starting at word `lo` into a sorted list of node IDs
+static std::vector<int>
+bits_to_ids(const std::vector<uint64_t> & bits, int64_t lo)
+{
+    std::vector<int> ids;
+    for (std::size_t w = 0; w < bits.size(); w++) {
+        uint64_t word = bits[w];
+        while (word != 0) {
+            int b = count_trailing_zeros(word);
+            ids.push_back(static_cast<int>(64 * (lo + static_cast<int64_t>(w)) + b));
+            word &= word - 1;
+        }
+    }
+    return ids;
+}
+
+NodeSet::NodeSet() : id(-1), indexed(false), first_word(0) {}
 
 int
 NodeSet::get_id() const
@@ -57,6 +120,141 @@ void
 NodeSet::set_nodes(const std::vector<int> & nodes)
 {
     this->node_ids = nodes;
+    this->indexed = false;
+    this->sorted_ids.clear();
+    this->bits.clear();
+    this->first_word = 0;
+}
+
+void
+NodeSet::build_index() const
+{
+    this->sorted_ids = this->node_ids;
+    std::sort(this->sorted_ids.begin(), this->sorted_ids.end());
+    this->sorted_ids.erase(std::unique(this->sorted_ids.begin(), this->sorted_ids.end()),
+                           this->sorted_ids.end());
+
+    this->bits.clear();
+    this->first_word = 0;
+    if (!this->sorted_ids.empty()) {
+        int64_t lo = word_index(this->sorted_ids.front());
+        int64_t hi = word_index(this->sorted_ids.back()) + 1;
+        // use the bitset only if it does not take more memory than the sorted array
+        auto bitset_size = static_cast<std::size_t>(hi - lo) * sizeof(uint64_t);
+        if (bitset_size <= this->sorted_ids.size() * sizeof(int)) {
+            this->first_word = lo;
+            this->bits.assign(hi - lo, 0);
+            for (auto n : this->sorted_ids)
+                this->bits[word_index(n) - lo] |= bit_mask(n);
+        }
+    }
+    this->indexed = true;
+}
+
+bool
+NodeSet::contains(int node_id) const
+{
+    if (!this->indexed)
+        build_index();
+
+    if (!this->bits.empty()) {
+        int64_t w = word_index(node_id) - this->first_word;
+        if (w < 0 || w >= static_cast<int64_t>(this->bits.size()))
+            return false;
+        return (this->bits[w] & bit_mask(node_id)) != 0;
+    }
+    else
+        return std::binary_search(this->sorted_ids.begin(), this->sorted_ids.end(), node_id);
+}
+
+NodeSet
+NodeSet::union_with(const NodeSet & other) const
+{
+    return combine(other, Operation::UNION);
+}
+
+NodeSet
+NodeSet::intersection_with(const NodeSet & other) const
+{
+    return combine(other, Operation::INTERSECTION);
+}
+
+NodeSet
+NodeSet::difference_with(const NodeSet & other) const
+{
+    return combine(other, Operation::DIFFERENCE);
+}
+
+NodeSet
+NodeSet::combine(const NodeSet & other, Operation op) const
+{
+    if (!this->indexed)
+        build_index();
+    if (!other.indexed)
+        other.build_index();
+
+    std::vector<int> ids;
+    if (!this->bits.empty() && !other.bits.empty()) {
+        // both sets are dense: combine the bitsets word by word
+        int64_t a_lo = this->first_word;
+        int64_t a_hi = a_lo + static_cast<int64_t>(this->bits.size());
+        int64_t b_lo = other.first_word;
+        int64_t b_hi = b_lo + static_cast<int64_t>(other.bits.size());
+        int64_t lo, hi;
+        if (op == Operation::UNION) {
+            lo = std::min(a_lo, b_lo);
+            hi = std::max(a_hi, b_hi);
+        }
+        else if (op == Operation::INTERSECTION) {
+            lo = std::max(a_lo, b_lo);
+            hi = std::min(a_hi, b_hi);
+        }
+        else {
+            lo = a_lo;
+            hi = a_hi;
+        }
+        auto a = align_bits(this->bits, a_lo, lo, hi);
+        auto b = align_bits(other.bits, b_lo, lo, hi);
+        std::size_t n = a.size();
+        if (op == Operation::UNION) {
+            for (std::size_t i = 0; i < n; i++)
+                a[i] |= b[i];
+        }
+        else if (op == Operation::INTERSECTION) {
+            for (std::size_t i = 0; i < n; i++)
+                a[i] &= b[i];
+        }
+        else {
+            for (std::size_t i = 0; i < n; i++)
+                a[i] &= ~b[i];
+        }
+        ids = bits_to_ids(a, lo);
+    }
+    else if (op == Operation::UNION) {
+        ids.reserve(this->sorted_ids.size() + other.sorted_ids.size());
+        std::set_union(this->sorted_ids.begin(),
+                       this->sorted_ids.end(),
+                       other.sorted_ids.begin(),
+                       other.sorted_ids.end(),
+                       std::back_inserter(ids));
+    }
+    else if (op == Operation::INTERSECTION) {
+        // probe the larger set with the nodes of the smaller one
+        const NodeSet & small = this->sorted_ids.size() <= other.sorted_ids.size() ? *this : other;
+        const NodeSet & large = &small == this ? other : *this;
+        for (auto n : small.sorted_ids)
+            if (large.contains(n))
+                ids.push_back(n);
+    }
+    else {
+        for (auto n : this->sorted_ids)
+            if (!other.contains(n))
+                ids.push_back(n);
+    }
+
+    NodeSet ns;
+    ns.set_nodes(ids);
+    return ns;
 }
 
 } // namespace exodusIIcpp
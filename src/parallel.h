@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace exodusIIcpp {
+namespace internal {
+
+/// Call `fn(i)` for `i = 0..n-1` on `n_threads` threads
+///
+/// The calling thread is one of the threads. Items are handed out one at a time, so `fn` should
+/// do enough work per item to amortize that. The first exception thrown by `fn` is rethrown once
+/// all threads have finished.
+template <typename F>
+void
+parallel_for(std::size_t n, unsigned int n_threads, F && fn)
+{
+    std::atomic<std::size_t> next(0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]() {
+        for (auto i = next++; i < n; i = next++) {
+            try {
+                fn(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                next = n;
+            }
+        }
+    };
+    auto n_workers = std::max<std::size_t>(1, std::min<std::size_t>(n_threads, n));
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < n_workers; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto & th : threads)
+        th.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace internal
+} // namespace exodusIIcpp
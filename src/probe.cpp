@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/probe.h"
+#include "exodusIIcpp/file.h"
+#include "shape_functions.h"
+#include <algorithm>
+#include <limits>
+
+namespace exodusIIcpp {
+
+/// Nodes closer than this are read in one range, even if the nodes between them are not needed
+static const int64_t MAX_RANGE_GAP = 64;
+
+Probe::Probe(const File & file,
+             const SpatialIndex & index,
+             const std::vector<std::array<double, 3>> & points) :
+    locations(index.locate(points))
+{
+    std::vector<int64_t> nodes;
+    this->point_ofst.resize(points.size() + 1);
+    this->point_ofst[0] = 0;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        auto & loc = this->locations[i];
+        if (loc.block_idx >= 0) {
+            auto & blk = file.get_element_block(loc.block_idx);
+            auto shape = internal::get_linear_shape(blk.get_element_type());
+            int n_corners = internal::shape_num_nodes(shape);
+            double N[8];
+            internal::eval_shape(shape, loc.xi, N, nullptr);
+            auto elem_nodes = blk.get_element_nodes(loc.elem_idx);
+            for (int k = 0; k < n_corners; k++) {
+                nodes.push_back(elem_nodes[k] - 1);
+                this->weights.push_back(N[k]);
+            }
+        }
+        this->point_ofst[i + 1] = static_cast<int64_t>(nodes.size());
+    }
+
+    // group the touched nodes into ranges
+    std::vector<int64_t> unique_nodes(nodes);
+    std::sort(unique_nodes.begin(), unique_nodes.end());
+    unique_nodes.erase(std::unique(unique_nodes.begin(), unique_nodes.end()), unique_nodes.end());
+    for (auto n : unique_nodes) {
+        if (!this->node_ranges.empty()) {
+            auto & last = this->node_ranges.back();
+            if (n - (last.first + last.second) <= MAX_RANGE_GAP) {
+                last.second = n - last.first + 1;
+                continue;
+            }
+        }
+        this->node_ranges.emplace_back(n, 1);
+    }
+
+    // map node indices to positions in the concatenated ranges
+    std::vector<int64_t> range_ofst(this->node_ranges.size() + 1, 0);
+    for (std::size_t r = 0; r < this->node_ranges.size(); r++)
+        range_ofst[r + 1] = range_ofst[r] + this->node_ranges[r].second;
+    this->buffer_idx.resize(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        auto it = std::upper_bound(this->node_ranges.begin(),
+                                   this->node_ranges.end(),
+                                   nodes[i],
+                                   [](int64_t n, const std::pair<int64_t, int64_t> & range) {
+                                       return n < range.first;
+                                   });
+        auto r = (it - this->node_ranges.begin()) - 1;
+        this->buffer_idx[i] = range_ofst[r] + nodes[i] - this->node_ranges[r].first;
+    }
+}
+
+std::size_t
+Probe::get_num_points() const
+{
+    return this->locations.size();
+}
+
+const std::vector<PointLocation> &
+Probe::get_locations() const
+{
+    return this->locations;
+}
+
+const std::vector<std::pair<int64_t, int64_t>> &
+Probe::get_node_ranges() const
+{
+    return this->node_ranges;
+}
+
+std::vector<std::vector<double>>
+Probe::interpolate(const File & file, int var_idx, const std::vector<int> & time_steps) const
+{
+    auto n_points = this->locations.size();
+    std::vector<std::vector<double>> values(time_steps.size());
+    std::vector<double> buffer;
+    for (std::size_t s = 0; s < time_steps.size(); s++) {
+        buffer.clear();
+        for (auto & range : this->node_ranges) {
+            auto vals = file.get_partial_nodal_variable_values(time_steps[s],
+                                                               var_idx,
+                                                               range.first,
+                                                               range.second);
+            buffer.insert(buffer.end(), vals.begin(), vals.end());
+        }
+
+        auto & step_values = values[s];
+        step_values.resize(n_points);
+        for (std::size_t i = 0; i < n_points; i++) {
+            if (this->locations[i].block_idx < 0) {
+                step_values[i] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+            double val = 0.;
+            for (auto j = this->point_ofst[i]; j < this->point_ofst[i + 1]; j++)
+                val += this->weights[j] * buffer[this->buffer_idx[j]];
+            step_values[i] = val;
+        }
+    }
+    return values;
+}
+
+} // namespace exodusIIcpp
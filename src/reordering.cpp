@@ -0,0 +1,375 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/reordering.h"
+#include "exodusIIcpp/exception.h"
+#include "fmt/printf.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace exodusIIcpp {
+
+/// Build node-to-node adjacency (CSR) from element connectivity
+static void
+build_node_graph(int64_t n_nodes,
+                 const std::vector<ElementBlock> & blocks,
+                 std::vector<int64_t> & adj_ofst,
+                 std::vector<int64_t> & adj)
+{
+    // node -> element incidence
+    std::vector<int64_t> inc_ofst(n_nodes + 1, 0);
+    std::vector<const int *> elem_nodes;
+    std::vector<int> elem_n_nodes;
+    for (auto & blk : blocks) {
+        int n_per_elem = blk.get_num_nodes_per_element();
+        for (int e = 0; e < blk.get_num_elements(); e++) {
+            const int * nodes = blk.get_connectivity().data() + (std::size_t) e * n_per_elem;
+            elem_nodes.push_back(nodes);
+            elem_n_nodes.push_back(n_per_elem);
+            for (int k = 0; k < n_per_elem; k++)
+                inc_ofst[nodes[k]]++;
+        }
+    }
+    for (int64_t i = 0; i < n_nodes; i++)
+        inc_ofst[i + 1] += inc_ofst[i];
+    std::vector<int64_t> inc(inc_ofst[n_nodes]);
+    std::vector<int64_t> pos(inc_ofst.begin(), inc_ofst.end() - 1);
+    for (std::size_t e = 0; e < elem_nodes.size(); e++)
+        for (int k = 0; k < elem_n_nodes[e]; k++)
+            inc[pos[elem_nodes[e][k] - 1]++] = e;
+
+    // node -> node, neighbors are collected through the incident elements
+    std::vector<int64_t> marker(n_nodes, -1);
+    adj_ofst.assign(n_nodes + 1, 0);
+    adj.clear();
+    for (int64_t i = 0; i < n_nodes; i++) {
+        marker[i] = i;
+        for (auto j = inc_ofst[i]; j < inc_ofst[i + 1]; j++) {
+            auto e = inc[j];
+            for (int k = 0; k < elem_n_nodes[e]; k++) {
+                int64_t nb = elem_nodes[e][k] - 1;
+                if (marker[nb] != i) {
+                    marker[nb] = i;
+                    adj.push_back(nb);
+                }
+            }
+        }
+        adj_ofst[i + 1] = static_cast<int64_t>(adj.size());
+    }
+}
+
+/// Breadth-first search from `root` over unvisited nodes, neighbors visited by increasing degree
+///
+/// Visited nodes are appended to `queue`.
+///
+/// @return Number of levels and position of the first node of the last level in `queue`
+static std::pair<std::size_t, std::size_t>
+bfs(int64_t root,
+    const std::vector<int64_t> & adj_ofst,
+    const std::vector<int64_t> & adj,
+    std::vector<char> & visited,
+    std::vector<int64_t> & queue)
+{
+    auto degree = [&](int64_t n) { return adj_ofst[n + 1] - adj_ofst[n]; };
+    queue.push_back(root);
+    visited[root] = 1;
+    std::size_t n_levels = 0;
+    std::size_t last_level = queue.size() - 1;
+    std::size_t level_start = last_level;
+    std::size_t level_end = queue.size();
+    while (level_start < level_end) {
+        n_levels++;
+        last_level = level_start;
+        for (auto q = level_start; q < level_end; q++) {
+            auto first = queue.size();
+            auto n = queue[q];
+            for (auto j = adj_ofst[n]; j < adj_ofst[n + 1]; j++)
+                if (!visited[adj[j]]) {
+                    visited[adj[j]] = 1;
+                    queue.push_back(adj[j]);
+                }
+            std::stable_sort(queue.begin() + first, queue.end(), [&](int64_t a, int64_t b) {
+                return degree(a) < degree(b);
+            });
+        }
+        level_start = level_end;
+        level_end = queue.size();
+    }
+    return { n_levels, last_level };
+}
+
+static std::vector<int64_t>
+rcm_order(int64_t n_nodes, const std::vector<ElementBlock> & blocks)
+{
+    std::vector<int64_t> adj_ofst, adj;
+    build_node_graph(n_nodes, blocks, adj_ofst, adj);
+    auto degree = [&](int64_t n) { return adj_ofst[n + 1] - adj_ofst[n]; };
+
+    std::vector<int64_t> by_degree(n_nodes);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int64_t a, int64_t b) {
+        return degree(a) < degree(b);
+    });
+
+    std::vector<char> visited(n_nodes, 0);
+    std::vector<char> probed(n_nodes, 0);
+    std::vector<int64_t> order;
+    std::vector<int64_t> component;
+    order.reserve(n_nodes);
+    for (auto root : by_degree) {
+        if (visited[root])
+            continue;
+
+        // pseudo-peripheral root (George-Liu): move to the lowest-degree node of the last level
+        // while the number of levels keeps growing
+        component.clear();
+        auto levels = bfs(root, adj_ofst, adj, probed, component);
+        while (true) {
+            auto candidate = *std::min_element(
+                component.begin() + levels.second,
+                component.end(),
+                [&](int64_t a, int64_t b) { return degree(a) < degree(b); });
+            for (auto n : component)
+                probed[n] = 0;
+            component.clear();
+            auto candidate_levels = bfs(candidate, adj_ofst, adj, probed, component);
+            if (candidate_levels.first <= levels.first)
+                break;
+            root = candidate;
+            levels = candidate_levels;
+        }
+        for (auto n : component)
+            probed[n] = 0;
+
+        bfs(root, adj_ofst, adj, visited, order);
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+/// Convert quantized coordinates to the position along a Hilbert curve
+///
+/// Uses the transpose algorithm of J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc.
+/// 707, 381 (2004).
+static uint64_t
+hilbert_key(uint32_t * X, int n_dim, int n_bits)
+{
+    uint32_t M = 1u << (n_bits - 1);
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        uint32_t P = Q - 1;
+        for (int i = 0; i < n_dim; i++)
+            if (X[i] & Q)
+                X[0] ^= P;
+            else {
+                uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+    }
+    for (int i = 1; i < n_dim; i++)
+        X[i] ^= X[i - 1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+        if (X[n_dim - 1] & Q)
+            t ^= Q - 1;
+    for (int i = 0; i < n_dim; i++)
+        X[i] ^= t;
+
+    uint64_t key = 0;
+    for (int b = n_bits - 1; b >= 0; b--)
+        for (int i = 0; i < n_dim; i++)
+            key = (key << 1) | ((X[i] >> b) & 1u);
+    return key;
+}
+
+/// Interleave bits of quantized coordinates
+static uint64_t
+morton_key(const uint32_t * X, int n_dim, int n_bits)
+{
+    uint64_t key = 0;
+    for (int b = n_bits - 1; b >= 0; b--)
+        for (int i = 0; i < n_dim; i++)
+            key = (key << 1) | ((X[i] >> b) & 1u);
+    return key;
+}
+
+/// Compute space-filling curve keys of points
+///
+/// @param pts Points, `[x0, y0, z0, x1, y1, z1, ...]`
+static std::vector<uint64_t>
+curve_keys(ReorderingMethod method, int n_dim, const std::vector<double> & pts)
+{
+    auto n = pts.size() / 3;
+    const int n_bits = std::min(32, 63 / n_dim);
+    const double n_cells = static_cast<double>((uint64_t(1) << n_bits) - 1);
+
+    double lo[3], hi[3];
+    for (int d = 0; d < 3; d++) {
+        lo[d] = std::numeric_limits<double>::max();
+        hi[d] = std::numeric_limits<double>::lowest();
+    }
+    for (std::size_t i = 0; i < n; i++)
+        for (int d = 0; d < n_dim; d++) {
+            lo[d] = std::min(lo[d], pts[3 * i + d]);
+            hi[d] = std::max(hi[d], pts[3 * i + d]);
+        }
+
+    std::vector<uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; i++) {
+        uint32_t X[3] = { 0, 0, 0 };
+        for (int d = 0; d < n_dim; d++)
+            if (hi[d] > lo[d])
+                X[d] = static_cast<uint32_t>((pts[3 * i + d] - lo[d]) / (hi[d] - lo[d]) * n_cells);
+        keys[i] = method == ReorderingMethod::HILBERT ? hilbert_key(X, n_dim, n_bits)
+                                                      : morton_key(X, n_dim, n_bits);
+    }
+    return keys;
+}
+
+/// Order of items sorted by their keys, ties are kept in the original order
+template <typename K>
+static std::vector<int64_t>
+sorted_order(const std::vector<K> & keys)
+{
+    std::vector<int64_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+        return keys[a] < keys[b];
+    });
+    return order;
+}
+
+static std::vector<int64_t>
+inverse(const std::vector<int64_t> & order)
+{
+    std::vector<int64_t> index(order.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+        index[order[i]] = static_cast<int64_t>(i);
+    return index;
+}
+
+Reordering::Reordering() : blk_elem_ofst(1, 0) {}
+
+Reordering::Reordering(ReorderingMethod method,
+                       const std::vector<double> & x,
+                       const std::vector<double> & y,
+                       const std::vector<double> & z,
+                       const std::vector<ElementBlock> & blocks) :
+    blk_elem_ofst(1, 0)
+{
+    auto n_nodes = static_cast<int64_t>(x.size());
+    if ((!y.empty() && y.size() != x.size()) || (!z.empty() && z.size() != x.size()))
+        throw Exception("Coordinate arrays must have the same size.");
+    int n_dim = z.empty() ? (y.empty() ? 1 : 2) : 3;
+
+    for (auto & blk : blocks) {
+        auto n_blk_elems = std::max(blk.get_num_elements(), 0);
+        for (auto n : blk.get_connectivity())
+            if (n < 1 || n > n_nodes)
+                throw Exception(
+                    fmt::sprintf("Element block %d references node %d which does not exist.",
+                                 blk.get_id(),
+                                 n));
+        this->blk_elem_ofst.push_back(this->blk_elem_ofst.back() + n_blk_elems);
+    }
+
+    std::vector<double> pts;
+    if (method == ReorderingMethod::RCM)
+        this->node_order = rcm_order(n_nodes, blocks);
+    else {
+        pts.resize(3 * n_nodes, 0.);
+        for (int64_t i = 0; i < n_nodes; i++) {
+            pts[3 * i] = x[i];
+            pts[3 * i + 1] = n_dim >= 2 ? y[i] : 0.;
+            pts[3 * i + 2] = n_dim >= 3 ? z[i] : 0.;
+        }
+        this->node_order = sorted_order(curve_keys(method, n_dim, pts));
+    }
+    this->node_index = inverse(this->node_order);
+
+    // elements are reordered within their block
+    this->elem_order.resize(this->blk_elem_ofst.back());
+    for (std::size_t ib = 0; ib < blocks.size(); ib++) {
+        auto & blk = blocks[ib];
+        auto ofst = this->blk_elem_ofst[ib];
+        auto n_blk_elems = this->blk_elem_ofst[ib + 1] - ofst;
+        int n_per_elem = blk.get_num_nodes_per_element();
+        const int * connect = blk.get_connectivity().data();
+
+        std::vector<int64_t> blk_order;
+        if (method == ReorderingMethod::RCM) {
+            std::vector<int64_t> keys(n_blk_elems, std::numeric_limits<int64_t>::max());
+            for (int64_t e = 0; e < n_blk_elems; e++)
+                for (int k = 0; k < n_per_elem; k++)
+                    keys[e] = std::min(keys[e], this->node_index[connect[e * n_per_elem + k] - 1]);
+            blk_order = sorted_order(keys);
+        }
+        else {
+            std::vector<double> centroids(3 * n_blk_elems, 0.);
+            for (int64_t e = 0; e < n_blk_elems; e++) {
+                for (int k = 0; k < n_per_elem; k++) {
+                    auto node = connect[e * n_per_elem + k] - 1;
+                    for (int d = 0; d < 3; d++)
+                        centroids[3 * e + d] += pts[3 * node + d];
+                }
+                for (int d = 0; d < 3; d++)
+                    centroids[3 * e + d] /= n_per_elem;
+            }
+            blk_order = sorted_order(curve_keys(method, n_dim, centroids));
+        }
+        for (int64_t e = 0; e < n_blk_elems; e++)
+            this->elem_order[ofst + e] = ofst + blk_order[e];
+    }
+    this->elem_index = inverse(this->elem_order);
+}
+
+bool
+Reordering::empty() const
+{
+    return this->node_order.empty() && this->elem_order.empty();
+}
+
+int64_t
+Reordering::get_num_nodes() const
+{
+    return static_cast<int64_t>(this->node_order.size());
+}
+
+int64_t
+Reordering::get_num_elements() const
+{
+    return static_cast<int64_t>(this->elem_order.size());
+}
+
+const std::vector<int64_t> &
+Reordering::get_node_order() const
+{
+    return this->node_order;
+}
+
+const std::vector<int64_t> &
+Reordering::get_node_index() const
+{
+    return this->node_index;
+}
+
+const std::vector<int64_t> &
+Reordering::get_elem_order() const
+{
+    return this->elem_order;
+}
+
+const std::vector<int64_t> &
+Reordering::get_elem_index() const
+{
+    return this->elem_index;
+}
+
+const std::vector<int64_t> &
+Reordering::get_block_offsets() const
+{
+    return this->blk_elem_ofst;
+}
+
+} // namespace exodusIIcpp
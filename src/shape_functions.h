@@ -0,0 +1,276 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "topology.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+namespace exodusIIcpp {
+namespace internal {
+
+/// Linear element shapes that support mapping to the reference element
+enum class Shape { BAR2 = 0, TRI3, QUAD4, TET4, HEX8, UNSUPPORTED };
+
+/// Get the linear shape of an element type
+///
+/// Higher-order elements map to the linear shape of their corner nodes. Element types are
+/// recognized by `find_topology`.
+///
+/// @param elem_type ExodusII element type
+/// @return Linear shape
+inline Shape
+get_linear_shape(const std::string & elem_type)
+{
+    auto topo = find_topology(elem_type);
+    if (topo == &BAR_TOPOLOGY)
+        return Shape::BAR2;
+    else if (topo == &TRI_TOPOLOGY)
+        return Shape::TRI3;
+    else if (topo == &QUAD_TOPOLOGY)
+        return Shape::QUAD4;
+    else if (topo == &TET_TOPOLOGY)
+        return Shape::TET4;
+    else if (topo == &HEX_TOPOLOGY)
+        return Shape::HEX8;
+    else
+        return Shape::UNSUPPORTED;
+}
+
+/// Get the spatial dimension of a shape
+inline int
+shape_dim(Shape shape)
+{
+    switch (shape) {
+    case Shape::BAR2:
+        return 1;
+    case Shape::TRI3:
+    case Shape::QUAD4:
+        return 2;
+    case Shape::TET4:
+    case Shape::HEX8:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+/// Get the number of (corner) nodes of a shape
+inline int
+shape_num_nodes(Shape shape)
+{
+    switch (shape) {
+    case Shape::BAR2:
+        return 2;
+    case Shape::TRI3:
+        return 3;
+    case Shape::QUAD4:
+    case Shape::TET4:
+        return 4;
+    case Shape::HEX8:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+/// Evaluate shape functions and their derivatives at a point of the reference element
+///
+/// @param shape Element shape
+/// @param xi Parametric coordinates
+/// @param N Values of the shape functions, `shape_num_nodes(shape)` entries
+/// @param dN Derivatives of the shape functions w.r.t. parametric coordinates (can be `nullptr`)
+inline void
+eval_shape(Shape shape, const std::array<double, 3> & xi, double * N, double (*dN)[3])
+{
+    const double r = xi[0];
+    const double s = xi[1];
+    const double t = xi[2];
+    switch (shape) {
+    case Shape::BAR2:
+        N[0] = 0.5 * (1. - r);
+        N[1] = 0.5 * (1. + r);
+        if (dN) {
+            dN[0][0] = -0.5;
+            dN[1][0] = 0.5;
+        }
+        break;
+
+    case Shape::TRI3:
+        N[0] = 1. - r - s;
+        N[1] = r;
+        N[2] = s;
+        if (dN) {
+            dN[0][0] = -1.;
+            dN[0][1] = -1.;
+            dN[1][0] = 1.;
+            dN[1][1] = 0.;
+            dN[2][0] = 0.;
+            dN[2][1] = 1.;
+        }
+        break;
+
+    case Shape::QUAD4: {
+        static const double rn[4] = { -1., 1., 1., -1. };
+        static const double sn[4] = { -1., -1., 1., 1. };
+        for (int i = 0; i < 4; i++) {
+            N[i] = 0.25 * (1. + rn[i] * r) * (1. + sn[i] * s);
+            if (dN) {
+                dN[i][0] = 0.25 * rn[i] * (1. + sn[i] * s);
+                dN[i][1] = 0.25 * sn[i] * (1. + rn[i] * r);
+            }
+        }
+        break;
+    }
+
+    case Shape::TET4:
+        N[0] = 1. - r - s - t;
+        N[1] = r;
+        N[2] = s;
+        N[3] = t;
+        if (dN) {
+            for (int i = 0; i < 4; i++)
+                for (int j = 0; j < 3; j++)
+                    dN[i][j] = (i == 0) ? -1. : (i == j + 1 ? 1. : 0.);
+        }
+        break;
+
+    case Shape::HEX8: {
+        static const double rn[8] = { -1., 1., 1., -1., -1., 1., 1., -1. };
+        static const double sn[8] = { -1., -1., 1., 1., -1., -1., 1., 1. };
+        static const double tn[8] = { -1., -1., -1., -1., 1., 1., 1., 1. };
+        for (int i = 0; i < 8; i++) {
+            N[i] = 0.125 * (1. + rn[i] * r) * (1. + sn[i] * s) * (1. + tn[i] * t);
+            if (dN) {
+                dN[i][0] = 0.125 * rn[i] * (1. + sn[i] * s) * (1. + tn[i] * t);
+                dN[i][1] = 0.125 * sn[i] * (1. + rn[i] * r) * (1. + tn[i] * t);
+                dN[i][2] = 0.125 * tn[i] * (1. + rn[i] * r) * (1. + sn[i] * s);
+            }
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/// Check if parametric coordinates lie inside the reference element
+///
+/// @param shape Element shape
+/// @param xi Parametric coordinates
+/// @param tol Tolerance
+/// @return `true` if the point is inside (or on the boundary), `false` otherwise
+inline bool
+inside_reference(Shape shape, const std::array<double, 3> & xi, double tol)
+{
+    switch (shape) {
+    case Shape::BAR2:
+        return std::abs(xi[0]) <= 1. + tol;
+    case Shape::QUAD4:
+        return std::abs(xi[0]) <= 1. + tol && std::abs(xi[1]) <= 1. + tol;
+    case Shape::HEX8:
+        return std::abs(xi[0]) <= 1. + tol && std::abs(xi[1]) <= 1. + tol &&
+               std::abs(xi[2]) <= 1. + tol;
+    case Shape::TRI3:
+        return xi[0] >= -tol && xi[1] >= -tol && xi[0] + xi[1] <= 1. + tol;
+    case Shape::TET4:
+        return xi[0] >= -tol && xi[1] >= -tol && xi[2] >= -tol &&
+               xi[0] + xi[1] + xi[2] <= 1. + tol;
+    default:
+        return false;
+    }
+}
+
+/// Map a physical point to parametric coordinates of an element using Newton's method
+///
+/// @param shape Element shape
+/// @param X Coordinates of the element (corner) nodes, `[x0, y0, z0, x1, y1, z1, ...]`
+/// @param p Physical point
+/// @param xi Parametric coordinates of the point
+/// @return `true` if Newton's method converged, `false` otherwise
+inline bool
+map_to_reference(Shape shape,
+                 const double * X,
+                 const std::array<double, 3> & p,
+                 std::array<double, 3> & xi)
+{
+    const int dim = shape_dim(shape);
+    const int n = shape_num_nodes(shape);
+    double N[8];
+    double dN[8][3];
+
+    // start from the center of the reference element
+    xi = { 0., 0., 0. };
+    if (shape == Shape::TRI3)
+        xi = { 1. / 3., 1. / 3., 0. };
+    else if (shape == Shape::TET4)
+        xi = { 0.25, 0.25, 0.25 };
+
+    double scale = 0.;
+    for (int i = 0; i < n; i++)
+        for (int d = 0; d < dim; d++)
+            scale = std::max(scale, std::abs(X[3 * i + d] - X[d]));
+    if (scale == 0.)
+        return false;
+
+    for (int it = 0; it < 20; it++) {
+        eval_shape(shape, xi, N, dN);
+        double res[3] = { 0., 0., 0. };
+        double J[3][3] = { { 0., 0., 0. }, { 0., 0., 0. }, { 0., 0., 0. } };
+        for (int i = 0; i < n; i++)
+            for (int d = 0; d < dim; d++) {
+                res[d] += N[i] * X[3 * i + d];
+                for (int k = 0; k < dim; k++)
+                    J[d][k] += X[3 * i + d] * dN[i][k];
+            }
+        double norm = 0.;
+        for (int d = 0; d < dim; d++) {
+            res[d] = p[d] - res[d];
+            norm = std::max(norm, std::abs(res[d]));
+        }
+        if (norm <= 1e-12 * scale)
+            return true;
+
+        // solve J * dxi = res
+        double dxi[3] = { 0., 0., 0. };
+        if (dim == 1) {
+            if (J[0][0] == 0.)
+                return false;
+            dxi[0] = res[0] / J[0][0];
+        }
+        else if (dim == 2) {
+            double det = J[0][0] * J[1][1] - J[0][1] * J[1][0];
+            if (det == 0.)
+                return false;
+            dxi[0] = (J[1][1] * res[0] - J[0][1] * res[1]) / det;
+            dxi[1] = (J[0][0] * res[1] - J[1][0] * res[0]) / det;
+        }
+        else {
+            double c00 = J[1][1] * J[2][2] - J[1][2] * J[2][1];
+            double c01 = J[1][2] * J[2][0] - J[1][0] * J[2][2];
+            double c02 = J[1][0] * J[2][1] - J[1][1] * J[2][0];
+            double det = J[0][0] * c00 + J[0][1] * c01 + J[0][2] * c02;
+            if (det == 0.)
+                return false;
+            double c10 = J[0][2] * J[2][1] - J[0][1] * J[2][2];
+            double c11 = J[0][0] * J[2][2] - J[0][2] * J[2][0];
+            double c12 = J[0][1] * J[2][0] - J[0][0] * J[2][1];
+            double c20 = J[0][1] * J[1][2] - J[0][2] * J[1][1];
+            double c21 = J[0][2] * J[1][0] - J[0][0] * J[1][2];
+            double c22 = J[0][0] * J[1][1] - J[0][1] * J[1][0];
+            dxi[0] = (c00 * res[0] + c10 * res[1] + c20 * res[2]) / det;
+            dxi[1] = (c01 * res[0] + c11 * res[1] + c21 * res[2]) / det;
+            dxi[2] = (c02 * res[0] + c12 * res[1] + c22 * res[2]) / det;
+        }
+        for (int d = 0; d < dim; d++)
+            xi[d] += dxi[d];
+    }
+    return false;
+}
+
+} // namespace internal
+} // namespace exodusIIcpp
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/skin.h"
+#include "exodusIIcpp/exception.h"
+#include "parallel.h"
+#include "topology.h"
+#include "fmt/printf.h"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace exodusIIcpp {
+
+using internal::SideKey;
+using internal::SideKeyHash;
+
+namespace {
+
+/// Reference to a side of an element: global (0-based) element index and (0-based) side index
+struct SideRef {
+    int64_t elem;
+    int side;
+};
+
+} // namespace
+
+using SideTable = std::unordered_map<SideKey, SideRef, SideKeyHash>;
+
+/// Match the sides of global (0-based) elements `begin..end-1`
+///
+/// Matched sides are removed from the table right away, so the memory footprint is proportional
+/// to the number of sides that are not matched yet, not to the size of the mesh.
+static void
+match_sides(const std::vector<ElementBlock> & blocks,
+            const std::vector<int64_t> & blk_ofst,
+            int64_t begin,
+            int64_t end,
+            SideTable & open_sides)
+{
+    for (std::size_t ib = 0; ib < blocks.size(); ib++) {
+        auto first = std::max(begin, blk_ofst[ib]);
+        auto last = std::min(end, blk_ofst[ib + 1]);
+        if (first >= last)
+            continue;
+
+        auto & blk = blocks[ib];
+        auto & topo = internal::get_topology(blk.get_element_type());
+        int n_nodes_per_elem = blk.get_num_nodes_per_element();
+        const int * connect = blk.get_connectivity().data();
+        for (auto e = first; e < last; e++) {
+            const int * elem_nodes = connect + (std::size_t) (e - blk_ofst[ib]) * n_nodes_per_elem;
+            for (int s = 0; s < topo.n_sides; s++) {
+                auto key = internal::make_key(elem_nodes, topo.sides[s]);
+                auto res = open_sides.try_emplace(key, SideRef { e, s });
+                if (!res.second)
+                    open_sides.erase(res.first);
+            }
+        }
+    }
+}
+
+/// Find all sides referenced by exactly one element
+///
+/// The elements are split into `n_threads` contiguous ranges whose sides are matched
+/// concurrently. Sides left open in a range are distributed by their hash into as many
+/// partitions, and each partition is matched concurrently again, since both references to an
+/// interior side on a range boundary land in the same partition.
+static std::vector<SideRef>
+find_exterior_sides(const std::vector<ElementBlock> & blocks, unsigned int n_threads)
+{
+    // first global element index of each block
+    std::vector<int64_t> blk_ofst(blocks.size() + 1, 0);
+    for (std::size_t ib = 0; ib < blocks.size(); ib++) {
+        auto & blk = blocks[ib];
+        int n_elems = std::max(blk.get_num_elements(), 0);
+        if (n_elems > 0) {
+            auto & topo = internal::get_topology(blk.get_element_type());
+            if (blk.get_num_nodes_per_element() < topo.n_corners)
+                throw Exception(
+                    fmt::sprintf("Element block %d has too few nodes per element.", blk.get_id()));
+        }
+        blk_ofst[ib + 1] = blk_ofst[ib] + n_elems;
+    }
+
+    auto n_elems = blk_ofst.back();
+    auto n_ranges = static_cast<std::size_t>(
+        std::max<int64_t>(1, std::min<int64_t>(std::max(n_threads, 1u), n_elems)));
+    // sides left open in range `r` that fall into partition `p` are in `open[r * n_ranges + p]`.
+    // With a single range, all open sides are exterior.
+    std::vector<std::vector<std::pair<SideKey, SideRef>>> open(n_ranges * n_ranges);
+    std::vector<std::vector<SideRef>> exterior_parts(n_ranges);
+    internal::parallel_for(n_ranges, n_threads, [&](std::size_t r) {
+        SideTable open_sides;
+        match_sides(blocks,
+                    blk_ofst,
+                    n_elems * r / n_ranges,
+                    n_elems * (r + 1) / n_ranges,
+                    open_sides);
+        SideKeyHash hash;
+        for (auto & it : open_sides)
+            if (n_ranges == 1)
+                exterior_parts[0].push_back(it.second);
+            else
+                open[r * n_ranges + (hash(it.first) >> 32) % n_ranges].push_back(it);
+    });
+
+    if (n_ranges > 1)
+        internal::parallel_for(n_ranges, n_threads, [&](std::size_t p) {
+            SideTable open_sides;
+            for (std::size_t r = 0; r < n_ranges; r++) {
+                auto & sides = open[r * n_ranges + p];
+                for (auto & it : sides) {
+                    auto res = open_sides.insert(it);
+                    if (!res.second)
+                        open_sides.erase(res.first);
+                }
+                std::vector<std::pair<SideKey, SideRef>>().swap(sides);
+            }
+            auto & part = exterior_parts[p];
+            part.reserve(open_sides.size());
+            for (auto & it : open_sides)
+                part.push_back(it.second);
+        });
+
+    std::vector<SideRef> exterior;
+    for (auto & part : exterior_parts)
+        exterior.insert(exterior.end(), part.begin(), part.end());
+    std::sort(exterior.begin(), exterior.end(), [](const SideRef & a, const SideRef & b) {
+        return a.elem < b.elem || (a.elem == b.elem && a.side < b.side);
+    });
+    return exterior;
+}
+
+static SideSet
+build_side_set(const std::vector<SideRef> & exterior)
+{
+    std::vector<int> elem_ids(exterior.size());
+    std::vector<int> side_ids(exterior.size());
+    for (std::size_t i = 0; i < exterior.size(); i++) {
+        elem_ids[i] = static_cast<int>(exterior[i].elem + 1);
+        side_ids[i] = exterior[i].side + 1;
+    }
+    SideSet ss;
+    ss.set_sides(elem_ids, side_ids);
+    return ss;
+}
+
+static const char *
+surface_element_type(int n_nodes)
+{
+    switch (n_nodes) {
+    case 1:
+        return "SPHERE";
+    case 2:
+        return "BAR2";
+    case 3:
+        return "TRI3";
+    default:
+        return "QUAD4";
+    }
+}
+
+SideSet
+skin(const std::vector<ElementBlock> & blocks, unsigned int n_threads)
+{
+    return build_side_set(find_exterior_sides(blocks, n_threads));
+}
+
+SideSet
+skin(const std::vector<ElementBlock> & blocks, ElementBlock & surface, unsigned int n_threads)
+{
+    auto exterior = find_exterior_sides(blocks, n_threads);
+
+    // first global element index of each block
+    std::vector<int64_t> blk_ofst(blocks.size() + 1, 0);
+    for (std::size_t i = 0; i < blocks.size(); i++)
+        blk_ofst[i + 1] = blk_ofst[i] + std::max(blocks[i].get_num_elements(), 0);
+
+    int n_side_nodes = -1;
+    std::vector<int> connect;
+    for (auto & ref : exterior) {
+        auto it = std::upper_bound(blk_ofst.begin(), blk_ofst.end(), ref.elem);
+        auto & blk = blocks[(it - blk_ofst.begin()) - 1];
+        auto local = ref.elem - *(it - 1);
+        auto & side = internal::get_topology(blk.get_element_type()).sides[ref.side];
+        if (n_side_nodes == -1) {
+            n_side_nodes = side.n_nodes;
+            connect.reserve(exterior.size() * n_side_nodes);
+        }
+        else if (n_side_nodes != side.n_nodes)
+            throw Exception("Exterior sides have different shapes, unable to build a surface "
+                            "element block.");
+
+        const int * elem_nodes =
+            blk.get_connectivity().data() + local * blk.get_num_nodes_per_element();
+        for (int i = 0; i < side.n_nodes; i++)
+            connect.push_back(elem_nodes[side.nodes[i]]);
+    }
+
+    if (n_side_nodes > 0)
+        surface.set_connectivity(surface_element_type(n_side_nodes),
+                                 static_cast<int>(exterior.size()),
+                                 n_side_nodes,
+                                 connect);
+
+    return build_side_set(exterior);
+}
+
+} // namespace exodusIIcpp
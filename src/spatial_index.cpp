@@ -0,0 +1,437 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/spatial_index.h"
+#include "exodusIIcpp/file.h"
+#include "exodusIIcpp/exception.h"
+#include "fmt/printf.h"
+#include "parallel.h"
+#include "shape_functions.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace exodusIIcpp {
+
+using internal::Shape;
+
+/// Maximum number of items in a leaf of the hierarchy
+static const int64_t LEAF_SIZE = 4;
+
+/// Minimum number of items in a subtree built by a thread
+static const int64_t MIN_TASK_SIZE = 4096;
+
+/// Number of elements, nodes or points processed at once by a thread
+static const int64_t CHUNK_SIZE = 16384;
+
+/// Relative tolerance used for point-in-element tests
+static const double INSIDE_TOL = 1e-10;
+
+/// Call `fn(begin, end)` for chunks of `[0, n)` on `n_threads` threads
+template <typename F>
+static void
+for_each_chunk(int64_t n, unsigned int n_threads, F && fn)
+{
+    auto n_chunks = static_cast<std::size_t>((n + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    internal::parallel_for(n_chunks, n_threads, [&](std::size_t i) {
+        auto begin = static_cast<int64_t>(i) * CHUNK_SIZE;
+        fn(begin, std::min(begin + CHUNK_SIZE, n));
+    });
+}
+
+static void
+get_point(const File & file, int dim, int64_t node_idx, double * pt)
+{
+    pt[0] = file.get_x_coords()[node_idx];
+    pt[1] = dim >= 2 ? file.get_y_coords()[node_idx] : 0.;
+    pt[2] = dim >= 3 ? file.get_z_coords()[node_idx] : 0.;
+}
+
+static bool
+point_in_box(const double * min, const double * max, const std::array<double, 3> & p, double tol)
+{
+    return p[0] >= min[0] - tol && p[0] <= max[0] + tol && p[1] >= min[1] - tol &&
+           p[1] <= max[1] + tol && p[2] >= min[2] - tol && p[2] <= max[2] + tol;
+}
+
+static double
+box_distance2(const double * min, const double * max, const std::array<double, 3> & p)
+{
+    double dist2 = 0.;
+    for (int d = 0; d < 3; d++) {
+        double delta = std::max(std::max(min[d] - p[d], p[d] - max[d]), 0.);
+        dist2 += delta * delta;
+    }
+    return dist2;
+}
+
+SpatialIndex::SpatialIndex(const File & file, unsigned int n_threads) : dim(file.get_dim())
+{
+    auto n_nodes = static_cast<int64_t>(file.get_x_coords().size());
+    if (file.get_num_nodes() > 0 && n_nodes != file.get_num_nodes())
+        throw Exception("Coordinates were not read. Call read_coords() first.");
+    if (file.get_num_element_blocks() > 0 && file.get_element_blocks().empty())
+        throw Exception("Element blocks were not read. Call read_blocks() first.");
+
+    // elements: blocks with a supported shape and their offset among the indexed elements
+    struct IndexedBlock {
+        int blk_idx;
+        Shape shape;
+        int64_t ofst;
+    };
+    std::vector<IndexedBlock> indexed;
+    int64_t n_elems = 0;
+    auto & blocks = file.get_element_blocks();
+    for (std::size_t ib = 0; ib < blocks.size(); ib++) {
+        auto & blk = blocks[ib];
+        auto shape = internal::get_linear_shape(blk.get_element_type());
+        if (shape == Shape::UNSUPPORTED || internal::shape_dim(shape) != this->dim)
+            continue;
+        if (blk.get_num_nodes_per_element() < internal::shape_num_nodes(shape))
+            throw Exception(
+                fmt::sprintf("Element block %d has too few nodes per element.", blk.get_id()));
+        indexed.push_back({ static_cast<int>(ib), shape, n_elems });
+        n_elems += std::max(blk.get_num_elements(), 0);
+    }
+
+    std::vector<int> blk_idx(n_elems);
+    std::vector<int64_t> local_idx(n_elems);
+    std::vector<int> shapes(n_elems);
+    std::vector<double> bounds(6 * n_elems);
+    for_each_chunk(n_elems, n_threads, [&](int64_t begin, int64_t end) {
+        auto it = std::upper_bound(indexed.begin(),
+                                   indexed.end(),
+                                   begin,
+                                   [](int64_t i, const IndexedBlock & ib) { return i < ib.ofst; });
+        for (int64_t j = begin; j < end; j++) {
+            while (it != indexed.end() && it->ofst <= j)
+                ++it;
+            auto & ib = *(it - 1);
+            auto & blk = blocks[ib.blk_idx];
+            int n_corners = internal::shape_num_nodes(ib.shape);
+            auto nodes = blk.get_element_nodes(static_cast<int>(j - ib.ofst));
+            double * lo = bounds.data() + 6 * j;
+            double * hi = lo + 3;
+            double pt[3];
+            get_point(file, this->dim, nodes[0] - 1, lo);
+            std::copy(lo, lo + 3, hi);
+            for (int i = 1; i < n_corners; i++) {
+                get_point(file, this->dim, nodes[i] - 1, pt);
+                for (int d = 0; d < 3; d++) {
+                    lo[d] = std::min(lo[d], pt[d]);
+                    hi[d] = std::max(hi[d], pt[d]);
+                }
+            }
+            blk_idx[j] = ib.blk_idx;
+            local_idx[j] = j - ib.ofst;
+            shapes[j] = static_cast<int>(ib.shape);
+        }
+    });
+
+    std::vector<int64_t> order;
+    build_tree(bounds, this->elem_tree, order, n_threads);
+
+    this->elem_block_idx.resize(n_elems);
+    this->elem_block_id.resize(n_elems);
+    this->elem_local_idx.resize(n_elems);
+    this->elem_shape.resize(n_elems);
+    this->elem_coord_ofst.resize(n_elems + 1);
+    this->elem_coord_ofst[0] = 0;
+    for (int64_t i = 0; i < n_elems; i++) {
+        auto j = order[i];
+        auto & blk = blocks[blk_idx[j]];
+        int n_corners = internal::shape_num_nodes(static_cast<Shape>(shapes[j]));
+        this->elem_block_idx[i] = blk_idx[j];
+        this->elem_block_id[i] = blk.get_id();
+        this->elem_local_idx[i] = local_idx[j];
+        this->elem_shape[i] = shapes[j];
+        this->elem_coord_ofst[i + 1] = this->elem_coord_ofst[i] + 3 * n_corners;
+    }
+    this->elem_coords.resize(this->elem_coord_ofst[n_elems]);
+    for_each_chunk(n_elems, n_threads, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            auto & blk = blocks[this->elem_block_idx[i]];
+            auto nodes = blk.get_element_nodes(static_cast<int>(this->elem_local_idx[i]));
+            int n_corners = internal::shape_num_nodes(static_cast<Shape>(this->elem_shape[i]));
+            double * X = this->elem_coords.data() + this->elem_coord_ofst[i];
+            for (int k = 0; k < n_corners; k++)
+                get_point(file, this->dim, nodes[k] - 1, X + 3 * k);
+        }
+    });
+
+    // nodes
+    bounds.resize(6 * n_nodes);
+    for_each_chunk(n_nodes, n_threads, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            double * b = bounds.data() + 6 * i;
+            get_point(file, this->dim, i, b);
+            std::copy(b, b + 3, b + 3);
+        }
+    });
+    build_tree(bounds, this->node_tree, order, n_threads);
+    this->node_ids.resize(n_nodes);
+    this->node_coords.resize(3 * n_nodes);
+    for_each_chunk(n_nodes, n_threads, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            this->node_ids[i] = static_cast<int>(order[i] + 1);
+            std::copy(bounds.data() + 6 * order[i],
+                      bounds.data() + 6 * order[i] + 3,
+                      this->node_coords.data() + 3 * i);
+        }
+    });
+}
+
+int
+SpatialIndex::get_dim() const
+{
+    return this->dim;
+}
+
+int64_t
+SpatialIndex::split_items(const std::vector<double> & bounds,
+                          std::vector<int64_t> & order,
+                          int64_t begin,
+                          int64_t end,
+                          TreeNode & nd)
+{
+    double cmin[3], cmax[3];
+    for (int d = 0; d < 3; d++) {
+        nd.min[d] = cmin[d] = std::numeric_limits<double>::max();
+        nd.max[d] = cmax[d] = std::numeric_limits<double>::lowest();
+    }
+    for (int64_t i = begin; i < end; i++) {
+        const double * b = bounds.data() + 6 * order[i];
+        for (int d = 0; d < 3; d++) {
+            nd.min[d] = std::min(nd.min[d], b[d]);
+            nd.max[d] = std::max(nd.max[d], b[d + 3]);
+            double c = b[d] + b[d + 3];
+            cmin[d] = std::min(cmin[d], c);
+            cmax[d] = std::max(cmax[d], c);
+        }
+    }
+
+    int axis = 0;
+    for (int d = 1; d < 3; d++)
+        if (cmax[d] - cmin[d] > cmax[axis] - cmin[axis])
+            axis = d;
+
+    if (end - begin <= LEAF_SIZE || cmax[axis] <= cmin[axis]) {
+        nd.offset = begin;
+        nd.count = end - begin;
+        return -1;
+    }
+
+    auto mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin,
+                     order.begin() + mid,
+                     order.begin() + end,
+                     [&](int64_t a, int64_t b) {
+                         return bounds[6 * a + axis] + bounds[6 * a + axis + 3] <
+                                bounds[6 * b + axis] + bounds[6 * b + axis + 3];
+                     });
+    nd.count = 0;
+    return mid;
+}
+
+void
+SpatialIndex::build_tree(const std::vector<double> & bounds,
+                         std::vector<TreeNode> & tree,
+                         std::vector<int64_t> & order,
+                         unsigned int n_threads)
+{
+    auto n = static_cast<int64_t>(bounds.size() / 6);
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    tree.clear();
+    if (n == 0)
+        return;
+    tree.reserve(2 * ((n + LEAF_SIZE - 1) / LEAF_SIZE));
+
+    // the top of the tree is built here, ranges of at most `task_size` items become subtrees that
+    // are built on the threads. Subtrees work on disjoint ranges of `order`.
+    int64_t task_size = 0;
+    if (n_threads > 1)
+        task_size = std::max(n / (8 * static_cast<int64_t>(n_threads)), MIN_TASK_SIZE);
+
+    struct Range {
+        std::size_t node;
+        int64_t begin;
+        int64_t end;
+    };
+    std::vector<Range> tasks;
+    std::vector<Range> stack;
+    tree.push_back(TreeNode());
+    stack.push_back({ 0, 0, n });
+    while (!stack.empty()) {
+        auto r = stack.back();
+        stack.pop_back();
+        if (r.end - r.begin <= task_size) {
+            tasks.push_back(r);
+            continue;
+        }
+
+        TreeNode nd;
+        auto mid = split_items(bounds, order, r.begin, r.end, nd);
+        if (mid >= 0) {
+            auto left = static_cast<int64_t>(tree.size());
+            tree.emplace_back();
+            tree.emplace_back();
+            nd.offset = left;
+            stack.push_back({ static_cast<std::size_t>(left + 1), mid, r.end });
+            stack.push_back({ static_cast<std::size_t>(left), r.begin, mid });
+        }
+        tree[r.node] = nd;
+    }
+
+    std::vector<std::vector<TreeNode>> subtrees(tasks.size());
+    internal::parallel_for(tasks.size(), n_threads, [&](std::size_t it) {
+        auto & task = tasks[it];
+        auto & sub = subtrees[it];
+        sub.push_back(TreeNode());
+        std::vector<Range> sub_stack;
+        sub_stack.push_back({ 0, task.begin, task.end });
+        while (!sub_stack.empty()) {
+            auto r = sub_stack.back();
+            sub_stack.pop_back();
+            TreeNode nd;
+            auto mid = split_items(bounds, order, r.begin, r.end, nd);
+            if (mid >= 0) {
+                auto left = static_cast<int64_t>(sub.size());
+                sub.emplace_back();
+                sub.emplace_back();
+                nd.offset = left;
+                sub_stack.push_back({ static_cast<std::size_t>(left + 1), mid, r.end });
+                sub_stack.push_back({ static_cast<std::size_t>(left), r.begin, mid });
+            }
+            sub[r.node] = nd;
+        }
+    });
+
+    // splice the subtrees in: the root replaces the task node, the rest is appended
+    for (std::size_t it = 0; it < tasks.size(); it++) {
+        auto & sub = subtrees[it];
+        auto base = static_cast<int64_t>(tree.size()) - 1;
+        for (auto & nd : sub)
+            if (nd.count == 0)
+                nd.offset += base;
+        tree[tasks[it].node] = sub[0];
+        tree.insert(tree.end(), sub.begin() + 1, sub.end());
+    }
+}
+
+std::vector<PointLocation>
+SpatialIndex::locate(const std::vector<std::array<double, 3>> & points,
+                     unsigned int n_threads) const
+{
+    std::vector<PointLocation> locations(points.size());
+    if (this->elem_tree.empty()) {
+        for (auto & loc : locations)
+            loc = { -1, -1, -1, { 0., 0., 0. } };
+        return locations;
+    }
+
+    auto & root = this->elem_tree[0];
+    double extent = 0.;
+    for (int d = 0; d < 3; d++)
+        extent = std::max(extent, root.max[d] - root.min[d]);
+    const double box_tol = INSIDE_TOL * extent;
+
+    auto n_points = static_cast<int64_t>(points.size());
+    for_each_chunk(n_points, n_threads, [&](int64_t begin, int64_t end) {
+        std::vector<int64_t> stack;
+        for (int64_t ip = begin; ip < end; ip++) {
+            std::array<double, 3> p = { 0., 0., 0. };
+            for (int d = 0; d < this->dim; d++)
+                p[d] = points[ip][d];
+
+            auto & loc = locations[ip];
+            loc = { -1, -1, -1, { 0., 0., 0. } };
+            stack.clear();
+            stack.push_back(0);
+            bool found = false;
+            while (!stack.empty() && !found) {
+                auto & nd = this->elem_tree[stack.back()];
+                stack.pop_back();
+                if (!point_in_box(nd.min, nd.max, p, box_tol))
+                    continue;
+                if (nd.count == 0) {
+                    stack.push_back(nd.offset + 1);
+                    stack.push_back(nd.offset);
+                    continue;
+                }
+                for (int64_t i = nd.offset; i < nd.offset + nd.count; i++) {
+                    auto shape = static_cast<Shape>(this->elem_shape[i]);
+                    std::array<double, 3> xi;
+                    const double * X = this->elem_coords.data() + this->elem_coord_ofst[i];
+                    if (internal::map_to_reference(shape, X, p, xi) &&
+                        internal::inside_reference(shape, xi, INSIDE_TOL)) {
+                        loc = { this->elem_block_idx[i],
+                                this->elem_block_id[i],
+                                this->elem_local_idx[i],
+                                xi };
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+    });
+    return locations;
+}
+
+std::vector<int>
+SpatialIndex::find_nearest_nodes(const std::vector<std::array<double, 3>> & points,
+                                 unsigned int n_threads) const
+{
+    std::vector<int> nearest(points.size(), -1);
+    if (this->node_tree.empty())
+        return nearest;
+
+    auto n_points = static_cast<int64_t>(points.size());
+    for_each_chunk(n_points, n_threads, [&](int64_t begin, int64_t end) {
+        std::vector<int64_t> stack;
+        for (int64_t ip = begin; ip < end; ip++) {
+            std::array<double, 3> p = { 0., 0., 0. };
+            for (int d = 0; d < this->dim; d++)
+                p[d] = points[ip][d];
+
+            double best = std::numeric_limits<double>::max();
+            stack.clear();
+            stack.push_back(0);
+            while (!stack.empty()) {
+                auto & nd = this->node_tree[stack.back()];
+                stack.pop_back();
+                if (box_distance2(nd.min, nd.max, p) >= best)
+                    continue;
+                if (nd.count == 0) {
+                    // visit the closer child first so that the bound tightens quickly
+                    auto & l = this->node_tree[nd.offset];
+                    auto & r = this->node_tree[nd.offset + 1];
+                    if (box_distance2(l.min, l.max, p) <= box_distance2(r.min, r.max, p)) {
+                        stack.push_back(nd.offset + 1);
+                        stack.push_back(nd.offset);
+                    }
+                    else {
+                        stack.push_back(nd.offset);
+                        stack.push_back(nd.offset + 1);
+                    }
+                    continue;
+                }
+                for (int64_t i = nd.offset; i < nd.offset + nd.count; i++) {
+                    const double * x = this->node_coords.data() + 3 * i;
+                    double dist2 = 0.;
+                    for (int d = 0; d < 3; d++)
+                        dist2 += (x[d] - p[d]) * (x[d] - p[d]);
+                    if (dist2 < best) {
+                        best = dist2;
+                        nearest[ip] = this->node_ids[i];
+                    }
+                }
+            }
+        }
+    });
+    return nearest;
+}
+
+} // namespace exodusIIcpp
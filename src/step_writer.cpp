@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "exodusIIcpp/step_writer.h"
+#include "exodusIIcpp/file.h"
+
+namespace exodusIIcpp {
+
+StepWriter::StepWriter(File & file) : file(file) {}
+
+void
+StepWriter::add_global_vars(Span<const double> values)
+{
+    this->global_values = values;
+}
+
+void
+StepWriter::add_nodal_var(int var_index, Span<const double> values)
+{
+    this->nodal_values[var_index] = values;
+}
+
+void
+StepWriter::add_elem_var(int var_index, Span<const double> values)
+{
+    this->elem_values[var_index] = values;
+}
+
+void
+StepWriter::add_elem_var(int var_index, int64_t blk_id, Span<const double> values)
+{
+    auto blk_idx = this->file.get_element_block_index(blk_id);
+    this->blk_elem_values[{ blk_idx, var_index }] = values;
+}
+
+void
+StepWriter::write(int step_num, double time) const
+{
+    this->file.write_time(step_num, time);
+    this->file.write_global_vars(step_num, this->global_values);
+    for (auto & [var_index, values] : this->nodal_values)
+        this->file.write_nodal_var(step_num, var_index, values);
+    for (auto & [var_index, values] : this->elem_values)
+        this->file.write_elem_var(step_num, var_index, values);
+    auto & blk_ids = this->file.get_element_block_ids();
+    for (auto & [key, values] : this->blk_elem_values)
+        this->file.write_elem_var(step_num, key.second, blk_ids[key.first], values);
+}
+
+void
+StepWriter::clear()
+{
+    this->global_values = Span<const double>();
+    this->nodal_values.clear();
+    this->elem_values.clear();
+    this->blk_elem_values.clear();
+}
+
+} // namespace exodusIIcpp
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "exodusIIcpp/exception.h"
+#include "fmt/printf.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <string>
+
+namespace exodusIIcpp {
+namespace internal {
+
+/// Side of an element given by local (0-based) indices of its corner nodes
+struct Side {
+    int n_nodes;
+    int nodes[4];
+};
+
+/// Sides of an element type, ordered by the ExodusII side numbering
+struct Topology {
+    int n_corners;
+    int n_sides;
+    Side sides[6];
+};
+
+/* clang-format off */
+inline const Topology BAR_TOPOLOGY = { 2, 2, {
+    { 1, { 0 } },
+    { 1, { 1 } }
+} };
+
+inline const Topology TRI_TOPOLOGY = { 3, 3, {
+    { 2, { 0, 1 } },
+    { 2, { 1, 2 } },
+    { 2, { 2, 0 } }
+} };
+
+inline const Topology QUAD_TOPOLOGY = { 4, 4, {
+    { 2, { 0, 1 } },
+    { 2, { 1, 2 } },
+    { 2, { 2, 3 } },
+    { 2, { 3, 0 } }
+} };
+
+inline const Topology TET_TOPOLOGY = { 4, 4, {
+    { 3, { 0, 1, 3 } },
+    { 3, { 1, 2, 3 } },
+    { 3, { 0, 3, 2 } },
+    { 3, { 0, 2, 1 } }
+} };
+
+inline const Topology PYRAMID_TOPOLOGY = { 5, 5, {
+    { 3, { 0, 1, 4 } },
+    { 3, { 1, 2, 4 } },
+    { 3, { 2, 3, 4 } },
+    { 3, { 3, 0, 4 } },
+    { 4, { 0, 3, 2, 1 } }
+} };
+
+inline const Topology WEDGE_TOPOLOGY = { 6, 5, {
+    { 4, { 0, 1, 4, 3 } },
+    { 4, { 1, 2, 5, 4 } },
+    { 4, { 0, 3, 5, 2 } },
+    { 3, { 0, 2, 1 } },
+    { 3, { 3, 4, 5 } }
+} };
+
+inline const Topology HEX_TOPOLOGY = { 8, 6, {
+    { 4, { 0, 1, 5, 4 } },
+    { 4, { 1, 2, 6, 5 } },
+    { 4, { 2, 3, 7, 6 } },
+    { 4, { 0, 4, 7, 3 } },
+    { 4, { 0, 3, 2, 1 } },
+    { 4, { 4, 5, 6, 7 } }
+} };
+/* clang-format on */
+
+/// Key identifying a side: sorted corner node IDs, unused entries are zero
+struct SideKey {
+    std::array<int, 4> nodes;
+
+    bool
+    operator==(const SideKey & other) const
+    {
+        return this->nodes == other.nodes;
+    }
+};
+
+struct SideKeyHash {
+    std::size_t
+    operator()(const SideKey & key) const
+    {
+        uint64_t h = 0x9e3779b97f4a7c15ULL;
+        for (auto n : key.nodes) {
+            h ^= static_cast<uint64_t>(static_cast<uint32_t>(n));
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 32;
+        }
+        return static_cast<std::size_t>(h);
+    }
+};
+
+/// Find the side topology of an element type
+///
+/// Higher-order elements share the topology of their linear counterpart, sides are given by the
+/// corner nodes only.
+///
+/// @param elem_type ExodusII element type
+/// @return Topology of the element type, `nullptr` if the element type is not supported
+inline const Topology *
+find_topology(const std::string & elem_type)
+{
+    std::string shape;
+    for (auto ch : elem_type) {
+        if (std::isdigit(static_cast<unsigned char>(ch)))
+            break;
+        shape += static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    }
+
+    if (shape == "BAR" || shape == "EDGE" || shape == "BEAM" || shape == "TRUSS")
+        return &BAR_TOPOLOGY;
+    else if (shape == "TRI" || shape == "TRIANGLE")
+        return &TRI_TOPOLOGY;
+    else if (shape == "QUAD")
+        return &QUAD_TOPOLOGY;
+    else if (shape == "TET" || shape == "TETRA")
+        return &TET_TOPOLOGY;
+    else if (shape == "PYRAMID" || shape == "PYRA")
+        return &PYRAMID_TOPOLOGY;
+    else if (shape == "WEDGE")
+        return &WEDGE_TOPOLOGY;
+    else if (shape == "HEX" || shape == "HEXAHEDRON")
+        return &HEX_TOPOLOGY;
+    else
+        return nullptr;
+}
+
+/// Get the side topology of an element type
+///
+/// @param elem_type ExodusII element type
+/// @return Topology of the element type, an exception is thrown if it is not supported
+inline const Topology &
+get_topology(const std::string & elem_type)
+{
+    auto topo = find_topology(elem_type);
+    if (topo == nullptr)
+        throw Exception(fmt::sprintf("Unsupported element type '%s'.", elem_type));
+    return *topo;
+}
+
+/// Make the key of a side of an element
+inline SideKey
+make_key(const int * elem_nodes, const Side & side)
+{
+    SideKey key = { { 0, 0, 0, 0 } };
+    for (int i = 0; i < side.n_nodes; i++)
+        key.nodes[i] = elem_nodes[side.nodes[i]];
+    std::sort(key.nodes.begin(), key.nodes.begin() + side.n_nodes);
+    return key;
+}
+
+} // namespace internal
+} // namespace exodusIIcpp
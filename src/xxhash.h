@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace exodusIIcpp {
+namespace internal {
+
+/// Streaming XXH64 hash
+///
+/// Data is hashed in 32-byte stripes by four independent accumulators, so the hash runs at close
+/// to memory bandwidth. Feeding the same bytes in differently sized pieces gives the same digest.
+/// Multi-byte values are read in host byte order, i.e. the digest of non-byte data is portable
+/// between little-endian hosts only.
+class XXH64 {
+public:
+    explicit XXH64(uint64_t seed = 0) :
+        acc { seed + P1 + P2, seed + P2, seed, seed - P1 },
+        seed(seed),
+        total_len(0),
+        buf_len(0)
+    {
+    }
+
+    /// Hash a range of bytes
+    void
+    update(const void * data, std::size_t size)
+    {
+        auto p = static_cast<const unsigned char *>(data);
+        auto end = p + size;
+        this->total_len += size;
+
+        if (this->buf_len + size < 32) {
+            std::memcpy(this->buf + this->buf_len, p, size);
+            this->buf_len += size;
+            return;
+        }
+        if (this->buf_len > 0) {
+            auto fill = 32 - this->buf_len;
+            std::memcpy(this->buf + this->buf_len, p, fill);
+            stripe(this->buf);
+            p += fill;
+            this->buf_len = 0;
+        }
+        for (; p + 32 <= end; p += 32)
+            stripe(p);
+        this->buf_len = end - p;
+        std::memcpy(this->buf, p, this->buf_len);
+    }
+
+    /// Get the digest of the bytes hashed so far
+    uint64_t
+    digest() const
+    {
+        uint64_t h;
+        if (this->total_len >= 32) {
+            h = rotl(this->acc[0], 1) + rotl(this->acc[1], 7) + rotl(this->acc[2], 12) +
+                rotl(this->acc[3], 18);
+            for (auto v : this->acc)
+                h = (h ^ round(0, v)) * P1 + P4;
+        }
+        else
+            h = this->seed + P5;
+        h += this->total_len;
+
+        const unsigned char * p = this->buf;
+        const unsigned char * end = this->buf + this->buf_len;
+        for (; p + 8 <= end; p += 8) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * P1 + P4;
+        }
+        if (p + 4 <= end) {
+            h ^= read32(p) * P1;
+            h = rotl(h, 23) * P2 + P3;
+            p += 4;
+        }
+        for (; p < end; p++) {
+            h ^= *p * P5;
+            h = rotl(h, 11) * P1;
+        }
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return h;
+    }
+
+private:
+    static constexpr uint64_t P1 = 11400714785074694791ULL;
+    static constexpr uint64_t P2 = 14029467366897019727ULL;
+    static constexpr uint64_t P3 = 1609587929392839161ULL;
+    static constexpr uint64_t P4 = 9650029242287828579ULL;
+    static constexpr uint64_t P5 = 2870177450012600261ULL;
+
+    static uint64_t
+    rotl(uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static uint64_t
+    round(uint64_t acc, uint64_t input)
+    {
+        return rotl(acc + input * P2, 31) * P1;
+    }
+
+    static uint64_t
+    read64(const unsigned char * p)
+    {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint64_t
+    read32(const unsigned char * p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    void
+    stripe(const unsigned char * p)
+    {
+        for (int i = 0; i < 4; i++)
+            this->acc[i] = round(this->acc[i], read64(p + 8 * i));
+    }
+
+    /// Accumulators of the four lanes
+    uint64_t acc[4];
+    /// Seed
+    uint64_t seed;
+    /// Number of bytes hashed so far
+    uint64_t total_len;
+    /// Bytes not yet hashed, less than one stripe
+    unsigned char buf[32];
+    /// Number of bytes in `buf`
+    std::size_t buf_len;
+};
+
+} // namespace internal
+} // namespace exodusIIcpp
@@ -0,0 +1,42 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+TEST(ConnectivityTest, empty)
+{
+    Connectivity conn;
+    EXPECT_EQ(conn.get_num_elements(), 0);
+    EXPECT_THROW(conn.get_element_nodes(0), Exception);
+}
+
+TEST(ConnectivityTest, test)
+{
+    Connectivity conn;
+    conn.set({ 0, 3, 7, 10 },
+             { 1, 2, 4, 2, 3, 6, 5, 2, 5, 4 },
+             { 0, 1, 0 },
+             { "TRI3", "QUAD4" });
+    EXPECT_EQ(conn.get_num_elements(), 3);
+
+    auto e0 = conn.get_element_nodes(0);
+    EXPECT_THAT(std::vector<int>(e0.begin(), e0.end()), ElementsAre(1, 2, 4));
+    auto e1 = conn.get_element_nodes(1);
+    EXPECT_EQ(e1.size(), 4);
+    EXPECT_EQ(e1[0], 2);
+    EXPECT_EQ(e1[3], 5);
+    EXPECT_THROW(conn.get_element_nodes(3), Exception);
+    EXPECT_THROW(conn.get_element_nodes(-1), Exception);
+
+    EXPECT_EQ(conn.get_element_type(0), "TRI3");
+    EXPECT_EQ(conn.get_element_type(1), "QUAD4");
+    EXPECT_EQ(conn.get_element_type(2), "TRI3");
+
+    EXPECT_THAT(conn.get_offsets(), ElementsAre(0, 3, 7, 10));
+    EXPECT_THAT(conn.get_type_tags(), ElementsAre(0, 1, 0));
+    EXPECT_THAT(conn.get_element_types(), ElementsAre("TRI3", "QUAD4"));
+    EXPECT_EQ(conn.get_node_ids().size(), 10);
+
+    EXPECT_THROW(conn.set({ 0, 3 }, { 1, 2, 3 }, { 0, 0 }, { "TRI3" }), Exception);
+}
@@ -0,0 +1,253 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+namespace {
+
+void
+write_source(const std::string & file_name)
+{
+    File f(file_name, FileAccess::WRITE);
+    f.init("source", 2, 6, 3, 2, 1, 1);
+    f.write_info({ "created by test" });
+    f.write_coord_names({ "r", "z" });
+    f.write_coords({ 0, 1, 2, 0, 1, 2 }, { 0, 0, 0, 1, 1, 1 });
+    f.write_block(10, "TRI3", 2, { 1, 2, 4, 2, 5, 4 });
+    f.write_block(20, "QUAD4", 1, { 2, 3, 6, 5 });
+    f.write_block_names({ "tris", "quads" });
+    f.write_node_set(3, { 1, 4 });
+    f.write_node_set_names({ "left" });
+    f.write_side_set(7, { 3 }, { 2 });
+    f.write_nodal_var_names({ "u", "v" });
+    f.write_elem_var_names({ "e", "s" });
+    f.write_elem_var_truth_table({ 1, 1, 0, 1 });
+    f.write_global_var_names({ "g1", "g2", "g3" });
+    for (int step = 1; step <= 4; step++) {
+        double t = 0.5 * step;
+        f.write_time(step, t);
+        f.write_nodal_var(step, 1, { t, t, t, t, t, t });
+        f.write_nodal_var(step, 2, { -t, -t, -t, -t, -t, -t });
+        f.write_elem_var(step, 1, 10, { 10 * t, 20 * t });
+        f.write_elem_var(step, 2, 10, { 1., 2. });
+        f.write_elem_var(step, 2, 20, { 3 * t });
+        f.write_global_vars(step, { t, 2 * t, 3 * t });
+    }
+}
+
+void
+write_run(const std::string & file_name,
+          double x_max,
+          const std::vector<double> & times,
+          double scale)
+{
+    File f(file_name, FileAccess::WRITE);
+    f.init("run", 1, 3, 2, 1, 0, 0);
+    f.write_coords({ 0., x_max / 2, x_max });
+    f.write_block(1, "BAR2", 2, { 1, 2, 2, 3 });
+    f.write_nodal_var_names({ "u" });
+    f.write_elem_var_names({ "e" });
+    f.write_global_var_names({ "g" });
+    for (std::size_t i = 0; i < times.size(); i++) {
+        int step = static_cast<int>(i + 1);
+        double t = times[i];
+        f.write_time(step, t);
+        f.write_nodal_var(step, 1, { scale * t, scale * t, scale * t });
+        f.write_elem_var(step, 1, { -scale * t, -scale * t });
+        f.write_global_var(step, 1, scale);
+    }
+}
+
+} // namespace
+
+TEST(CopyTest, copy_mesh)
+{
+    write_source("copy-src.e");
+    {
+        File src("copy-src.e", FileAccess::READ);
+        File dest("copy-mesh.e", FileAccess::WRITE);
+        copy_mesh(src, dest);
+    }
+
+    File src("copy-src.e", FileAccess::READ);
+    File g("copy-mesh.e", FileAccess::READ);
+    EXPECT_EQ(g.get_title(), "source");
+    EXPECT_THAT(g.read_info(), ElementsAre("created by test"));
+    EXPECT_EQ(g.mesh_fingerprint(), src.mesh_fingerprint());
+    g.read_coord_names();
+    EXPECT_THAT(g.get_coord_names(), ElementsAre("r", "z"));
+    g.read_blocks();
+    EXPECT_EQ(g.get_element_block(0).get_name(), "tris");
+    EXPECT_THAT(g.get_element_block(1).get_connectivity(), ElementsAre(2, 3, 6, 5));
+    EXPECT_EQ(g.read_node_set(3).get_name(), "left");
+    EXPECT_THAT(g.read_side_set(7).get_side_ids(), ElementsAre(2));
+    EXPECT_EQ(g.get_num_times(), 0);
+}
+
+TEST(CopyTest, copy_time_steps)
+{
+    write_source("copy-steps-src.e");
+    {
+        File src("copy-steps-src.e", FileAccess::READ);
+        File dest("copy-steps.e", FileAccess::WRITE);
+        copy_mesh(src, dest);
+        EXPECT_THROW(copy_time_steps(src, dest, { 5 }), Exception);
+        EXPECT_THROW(copy_time_steps(src, dest, { 1 }, { "w" }), Exception);
+        copy_time_steps(src, dest, { 2, 4 }, { "u", "e", "g2" });
+    }
+
+    File g("copy-steps.e", FileAccess::READ);
+    g.read_times();
+    EXPECT_THAT(g.get_times(), ElementsAre(1., 2.));
+    EXPECT_THAT(g.get_nodal_variable_names(), ElementsAre("v"));
+    EXPECT_THAT(g.get_elemental_variable_names(), ElementsAre("s"));
+    EXPECT_THAT(g.get_global_variable_names(), ElementsAre("g1", "g3"));
+    EXPECT_THAT(g.read_elem_var_truth_table(), ElementsAre(1, 1));
+    EXPECT_THAT(g.get_nodal_variable_values(2, 1), Each(-2.));
+    EXPECT_THAT(g.get_elemental_variable_values(1, 1), ElementsAre(1., 2., 3.));
+    EXPECT_THAT(g.get_elemental_variable_values(2, 1), ElementsAre(1., 2., 6.));
+    EXPECT_THAT(g.get_global_variable_values(2), ElementsAre(2., 6.));
+}
+
+TEST(CopyTest, copy_time_steps_buffered)
+{
+    write_source("copy-buffered-src.e");
+    {
+        File src("copy-buffered-src.e", FileAccess::READ);
+        File dest("copy-buffered.e", FileAccess::WRITE);
+        copy_mesh(src, dest);
+        // two time steps of a nodal variable fit into the buffer, so the run 2..4 is not divided
+        // evenly into transfers
+        copy_time_steps(src, dest, { 2, 3, 4 }, {}, 12);
+    }
+
+    File g("copy-buffered.e", FileAccess::READ);
+    EXPECT_EQ(g.get_num_times(), 3);
+    for (int step = 1; step <= 3; step++) {
+        double t = 0.5 * (step + 1);
+        EXPECT_THAT(g.get_nodal_variable_values(step, 1), Each(t));
+        EXPECT_THAT(g.get_nodal_variable_values(step, 2), Each(-t));
+        auto e = g.get_elemental_variable_values(step, 1);
+        EXPECT_EQ(e[0], 10 * t);
+        EXPECT_EQ(e[1], 20 * t);
+        EXPECT_TRUE(std::isnan(e[2]));
+        EXPECT_THAT(g.get_elemental_variable_values(step, 2), ElementsAre(1., 2., 3 * t));
+        EXPECT_THAT(g.get_global_variable_values(step), ElementsAre(t, 2 * t, 3 * t));
+    }
+}
+
+TEST(CopyTest, join_time_steps)
+{
+    write_run("join-1.e", 1., { 0., 1., 2., 3. }, 1.);
+    write_run("join-2.e", 1., { 2., 3., 4. }, 2.);
+    write_run("join-3.e", 1., { 4.5, 5. }, 3.);
+    write_run("join-other.e", 2., { 6. }, 4.);
+    {
+        File dest("join.e", FileAccess::WRITE);
+        join_time_steps({ "join-1.e", "join-2.e", "join-3.e" }, dest, { "e" });
+    }
+    {
+        File dest("join-bad.e", FileAccess::WRITE);
+        EXPECT_THROW(join_time_steps({ "join-1.e", "join-other.e" }, dest), Exception);
+    }
+    {
+        File f("join-undefined.e", FileAccess::WRITE);
+        f.init("run", 1, 3, 2, 1, 0, 0);
+        f.write_coords({ 0., 0.5, 1. });
+        f.write_block(1, "BAR2", 2, { 1, 2, 2, 3 });
+        f.write_nodal_var_names({ "u" });
+        f.write_elem_var_names({ "e" });
+        f.write_elem_var_truth_table({ 0 });
+        f.write_global_var_names({ "g" });
+        f.write_time(1, 6.);
+        f.write_nodal_var(1, 1, { 0., 0., 0. });
+        f.write_global_var(1, 1, 1.);
+    }
+    {
+        File dest("join-bad-e.e", FileAccess::WRITE);
+        EXPECT_THROW(join_time_steps({ "join-1.e", "join-undefined.e" }, dest), Exception);
+    }
+    {
+        File dest("join-no-e.e", FileAccess::WRITE);
+        EXPECT_NO_THROW(join_time_steps({ "join-1.e", "join-undefined.e" }, dest, { "e" }));
+    }
+
+    File g("join.e", FileAccess::READ);
+    g.read_times();
+    EXPECT_THAT(g.get_times(), ElementsAre(0., 1., 2., 3., 4., 4.5, 5.));
+    EXPECT_THAT(g.get_nodal_variable_names(), ElementsAre("u"));
+    EXPECT_TRUE(g.get_elemental_variable_names().empty());
+    EXPECT_THAT(g.get_nodal_variable_values(4, 1), Each(6.));
+    EXPECT_THAT(g.get_nodal_variable_values(7, 1), Each(15.));
+    EXPECT_THAT(g.get_global_variable_values(1, 1), ElementsAre(1., 1., 2., 2., 2., 3., 3.));
+}
+
+TEST(CopyTest, join_parts)
+{
+    {
+        File f("parts.e", FileAccess::WRITE);
+        f.init("parts", 2, 10, 4, 1, 1, 1);
+        f.write_coords({ 0, 1, 2, 3, 4, 0, 1, 2, 3, 4 }, { 0, 0, 0, 0, 0, 1, 1, 1, 1, 1 });
+        f.write_block(1, "QUAD4", 4, { 1, 2, 7, 6, 2, 3, 8, 7, 3, 4, 9, 8, 4, 5, 10, 9 });
+        f.write_node_set(1, { 1, 6 });
+        f.write_side_set(2, { 4 }, { 2 });
+    }
+    File src("parts.e", FileAccess::READ);
+    src.read();
+    Decomposition dd(src, 3);
+    dd.write(src, "parts.e");
+
+    // fill each part with values derived from the global numbering
+    std::vector<fs::path> part_paths;
+    for (int p = 0; p < 3; p++) {
+        part_paths.push_back(Decomposition::get_part_file_path("parts.e", 3, p));
+        File part(part_paths.back(), FileAccess::APPEND);
+        part.read_node_id_map();
+        part.read_elem_id_map();
+        auto & node_ids = part.get_node_id_map().get_ids();
+        auto & elem_ids = part.get_elem_id_map().get_ids();
+        part.write_nodal_var_names({ "u", "v" });
+        part.write_elem_var_names({ "e" });
+        // the first part does not define `e`
+        part.write_elem_var_truth_table({ p > 0 });
+        part.write_global_var_names({ "g" });
+        for (int step = 1; step <= 2; step++) {
+            part.write_time(step, 0.5 * step);
+            std::vector<double> u(node_ids.begin(), node_ids.end());
+            for (auto & val : u)
+                val *= step;
+            part.write_nodal_var(step, 1, u);
+            part.write_nodal_var(step, 2, std::vector<double>(u.size(), -1.));
+            std::vector<double> e(elem_ids.begin(), elem_ids.end());
+            if (p > 0)
+                part.write_elem_var(step, 1, 1, e);
+            part.write_global_var(step, 1, 10. * step);
+        }
+    }
+    {
+        File dest("parts-joined.e", FileAccess::WRITE);
+        join_parts(part_paths, dest, { "v" }, 2);
+    }
+
+    File g("parts-joined.e", FileAccess::READ);
+    EXPECT_EQ(g.mesh_fingerprint(), src.mesh_fingerprint());
+    g.read_times();
+    EXPECT_THAT(g.get_times(), ElementsAre(0.5, 1.));
+    EXPECT_THAT(g.get_nodal_variable_names(), ElementsAre("u"));
+    EXPECT_THAT(g.get_nodal_variable_values(2, 1),
+                ElementsAre(2., 4., 6., 8., 10., 12., 14., 16., 18., 20.));
+    File part0(part_paths[0], FileAccess::READ);
+    part0.read_elem_id_map();
+    auto & part0_elem_ids = part0.get_elem_id_map().get_ids();
+    auto e = g.get_elemental_variable_values(1, 1);
+    ASSERT_EQ(e.size(), 4u);
+    for (int i = 0; i < 4; i++) {
+        auto id = i + 1;
+        if (std::count(part0_elem_ids.begin(), part0_elem_ids.end(), id) > 0)
+            EXPECT_TRUE(std::isnan(e[i]));
+        else
+            EXPECT_EQ(e[i], id);
+    }
+    EXPECT_THAT(g.get_global_variable_values(2), ElementsAre(20.));
+}
@@ -0,0 +1,176 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+namespace {
+
+/// Write a strip of `n` QUAD4 elements along the x-axis
+///
+/// With `id_ofst > 0`, ID maps are written: node `i` of row `j` (both 1-based) gets ID
+/// `j * id_ofst + i`, element `i` gets ID `10 * id_ofst + i`.
+void
+write_strip(const std::string & file_name, int n, int id_ofst = 0)
+{
+    std::vector<double> x, y;
+    for (int j = 0; j < 2; j++)
+        for (int i = 0; i <= n; i++) {
+            x.push_back(i);
+            y.push_back(j);
+        }
+    std::vector<int> connect;
+    for (int i = 1; i <= n; i++)
+        connect.insert(connect.end(), { i, i + 1, i + n + 2, i + n + 1 });
+
+    File f(file_name, FileAccess::WRITE);
+    f.init("strip", 2, 2 * (n + 1), n, 1, 1, 1);
+    f.write_coords(x, y);
+    f.write_block(1, "QUAD4", n, connect);
+    f.write_block_names({ "strip" });
+    f.write_node_set(1, { 1, n + 2 });
+    f.write_node_set_names({ "left" });
+    f.write_side_set(2, { n }, { 2 });
+    f.write_side_set_names({ "right" });
+    if (id_ofst > 0) {
+        std::vector<int64_t> node_ids, elem_ids;
+        for (int j = 1; j <= 2; j++)
+            for (int i = 1; i <= n + 1; i++)
+                node_ids.push_back(j * id_ofst + i);
+        for (int i = 1; i <= n; i++)
+            elem_ids.push_back(10 * id_ofst + i);
+        f.write_node_id_map(node_ids);
+        f.write_elem_id_map(elem_ids);
+    }
+}
+
+} // namespace
+
+TEST(DecompositionTest, balance)
+{
+    std::vector<double> x, y;
+    for (int j = 0; j <= 8; j++)
+        for (int i = 0; i <= 8; i++) {
+            x.push_back(i);
+            y.push_back(j);
+        }
+    std::vector<int> connect;
+    for (int j = 0; j < 8; j++)
+        for (int i = 1; i <= 8; i++) {
+            int n = 9 * j + i;
+            connect.insert(connect.end(), { n, n + 1, n + 10, n + 9 });
+        }
+    {
+        File f("decomp-square.e", FileAccess::WRITE);
+        f.init("square", 2, 81, 64, 1, 0, 0);
+        f.write_coords(x, y);
+        f.write_block(1, "QUAD4", 64, connect);
+    }
+
+    File f("decomp-square.e", FileAccess::READ);
+    f.read();
+    Decomposition dd(f, 5);
+    EXPECT_EQ(dd.get_num_parts(), 5);
+    std::vector<int> sizes(5, 0);
+    for (auto p : dd.get_element_parts())
+        sizes[p]++;
+    EXPECT_THAT(sizes, UnorderedElementsAre(12, 13, 13, 13, 13));
+
+    EXPECT_THROW(Decomposition(f, 0), Exception);
+    EXPECT_THROW(Decomposition(f, 65), Exception);
+}
+
+TEST(DecompositionTest, elements_without_nodes)
+{
+    {
+        File f("decomp-null.e", FileAccess::WRITE);
+        f.init("null", 2, 10, 7, 2, 0, 0);
+        f.write_coords({ 0, 1, 2, 3, 4, 0, 1, 2, 3, 4 }, { 0, 0, 0, 0, 0, 1, 1, 1, 1, 1 });
+        f.write_block_info(1, "NULL", 3, 0);
+        f.write_block(2, "QUAD4", 4, { 1, 2, 7, 6, 2, 3, 8, 7, 3, 4, 9, 8, 4, 5, 10, 9 });
+    }
+
+    File f("decomp-null.e", FileAccess::READ);
+    f.read();
+    Decomposition dd(f, 2);
+    // the quads are bisected by their centroids, the NULL elements fill up the smaller parts
+    EXPECT_THAT(dd.get_element_parts(), ElementsAre(0, 1, 0, 0, 0, 1, 1));
+    dd.write(f, "decomp-null.e");
+
+    File p0("decomp-null.e.2.0", FileAccess::READ);
+    EXPECT_EQ(p0.get_num_elements(), 4);
+    File p1("decomp-null.e.2.1", FileAccess::READ);
+    EXPECT_EQ(p1.get_num_elements(), 3);
+}
+
+TEST(DecompositionTest, part_file_path)
+{
+    EXPECT_EQ(Decomposition::get_part_file_path("mesh.e", 16, 3).string(), "mesh.e.16.03");
+    EXPECT_EQ(Decomposition::get_part_file_path("mesh.e", 4, 3).string(), "mesh.e.4.3");
+    EXPECT_EQ(Decomposition::get_part_file_path("mesh.e", 100, 7).string(), "mesh.e.100.007");
+}
+
+TEST(DecompositionTest, write)
+{
+    write_strip("decomp-strip.e", 4);
+    File f("decomp-strip.e", FileAccess::READ);
+    f.read();
+    Decomposition dd(f, 2);
+    EXPECT_THAT(dd.get_element_parts(), ElementsAre(0, 0, 1, 1));
+    dd.write(f, "decomp-strip.e", 2);
+
+    File p0("decomp-strip.e.2.0", FileAccess::READ);
+    EXPECT_EQ(p0.get_num_nodes(), 6);
+    EXPECT_EQ(p0.get_num_elements(), 2);
+    p0.read();
+    p0.read_node_id_map();
+    p0.read_elem_id_map();
+    EXPECT_THAT(p0.get_node_id_map().get_ids(), ElementsAre(1, 2, 3, 6, 7, 8));
+    EXPECT_THAT(p0.get_elem_id_map().get_ids(), ElementsAre(1, 2));
+    EXPECT_THAT(p0.get_x_coords(), ElementsAre(0., 1., 2., 0., 1., 2.));
+    EXPECT_EQ(p0.get_element_block(0).get_name(), "strip");
+    EXPECT_THAT(p0.get_element_block(0).get_connectivity(), ElementsAre(1, 2, 5, 4, 2, 3, 6, 5));
+    ASSERT_EQ(p0.get_num_node_sets(), 1);
+    EXPECT_THAT(p0.get_node_sets()[0].get_node_ids(), ElementsAre(1, 4));
+    EXPECT_EQ(p0.get_num_side_sets(), 0);
+
+    File p1("decomp-strip.e.2.1", FileAccess::READ);
+    p1.read();
+    p1.read_node_id_map();
+    p1.read_elem_id_map();
+    EXPECT_THAT(p1.get_node_id_map().get_ids(), ElementsAre(3, 4, 5, 8, 9, 10));
+    EXPECT_THAT(p1.get_elem_id_map().get_ids(), ElementsAre(3, 4));
+    EXPECT_EQ(p1.get_num_node_sets(), 0);
+    ASSERT_EQ(p1.get_num_side_sets(), 1);
+    EXPECT_EQ(p1.get_side_sets()[0].get_name(), "right");
+    EXPECT_THAT(p1.get_side_sets()[0].get_element_ids(), ElementsAre(2));
+    EXPECT_THAT(p1.get_side_sets()[0].get_side_ids(), ElementsAre(2));
+}
+
+TEST(DecompositionTest, write_id_maps)
+{
+    write_strip("decomp-ids.e", 4, 10);
+
+    File f("decomp-ids.e", FileAccess::READ);
+    f.read();
+    f.read_node_id_map();
+    f.read_elem_id_map();
+    Decomposition dd(f, 2);
+    dd.write(f, "decomp-ids.e");
+
+    File p1("decomp-ids.e.2.1", FileAccess::READ);
+    p1.read_node_id_map();
+    p1.read_elem_id_map();
+    EXPECT_THAT(p1.get_node_id_map().get_ids(), ElementsAre(13, 14, 15, 23, 24, 25));
+    EXPECT_THAT(p1.get_elem_id_map().get_ids(), ElementsAre(103, 104));
+
+    {
+        File dest("decomp-ids-joined.e", FileAccess::WRITE);
+        join_parts({ "decomp-ids.e.2.0", "decomp-ids.e.2.1" }, dest);
+    }
+    File g("decomp-ids-joined.e", FileAccess::READ);
+    g.read_node_id_map();
+    g.read_elem_id_map();
+    EXPECT_EQ(g.get_node_id_map().get_ids(), f.get_node_id_map().get_ids());
+    EXPECT_EQ(g.get_elem_id_map().get_ids(), f.get_elem_id_map().get_ids());
+}
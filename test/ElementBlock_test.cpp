@@ -30,4 +30,19 @@ TEST(ElementBlockTest, test)
     EXPECT_THAT(eb.get_connectivity(), testing::ElementsAre(1, 2, 2, 3, 3, 4));
 
     EXPECT_THROW(eb.get_element_connectivity(3), Exception);
+
+    auto nodes = eb.get_element_nodes(1);
+    EXPECT_EQ(nodes.size(), 2);
+    EXPECT_EQ(nodes[0], 2);
+    EXPECT_EQ(nodes[1], 3);
+    EXPECT_EQ(nodes.data(), eb.get_connectivity().data() + 2);
+    EXPECT_THROW(eb.get_element_nodes(3), Exception);
+
+    ElementBlock empty;
+    EXPECT_THROW(empty.get_element_nodes(0), Exception);
+
+    // only the block info is known, not the connectivity
+    ElementBlock info;
+    info.set_connectivity("BAR2", 3, 2, {});
+    EXPECT_THROW(info.get_element_nodes(0), Exception);
 }
@@ -0,0 +1,77 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+namespace {
+
+void
+write_member(const std::string & file_name, double x_max, double scale)
+{
+    File f(file_name, FileAccess::WRITE);
+    f.init("test", 1, 3, 2, 1, 0, 0);
+    f.write_coords({ 0., x_max / 2, x_max });
+    f.write_block(1, "BAR2", 2, { 1, 2, 2, 3 });
+    f.write_nodal_var_names({ "u" });
+    f.write_elem_var_names({ "e" });
+    f.write_global_var_names({ "g" });
+    f.write_time(1, 0.);
+    f.write_nodal_var(1, 1, { scale, 2 * scale, 3 * scale });
+    f.write_elem_var(1, 1, { -scale, -2 * scale });
+    f.write_global_var(1, 1, 10 * scale);
+}
+
+} // namespace
+
+TEST(EnsembleTest, shared_mesh)
+{
+    write_member("ens-1.e", 1., 1.);
+    write_member("ens-2.e", 1., 2.);
+    write_member("ens-3.e", 1., 3.);
+
+    Ensemble ens({ "ens-1.e", "ens-2.e", "ens-3.e" }, 1);
+    EXPECT_EQ(ens.get_num_members(), 3);
+    EXPECT_EQ(ens.get_num_meshes(), 1);
+    EXPECT_EQ(&ens.get_mesh(0), &ens.get_mesh(2));
+    EXPECT_EQ(ens.get_mesh_fingerprint(0), ens.get_mesh_fingerprint(1));
+    EXPECT_THAT(ens.get_mesh(1).get_x_coords(), ElementsAre(0., 0.5, 1.));
+    EXPECT_EQ(ens.get_mesh(1).get_element_block(0).get_num_elements(), 2);
+    EXPECT_EQ(ens.get_file_path(1), fs::path("ens-2.e"));
+    EXPECT_LE(ens.get_num_open_files(), 1);
+
+    EXPECT_THAT(ens.read_nodal_variable(1, "u"),
+                ElementsAre(1., 2., 3., 2., 4., 6., 3., 6., 9.));
+    EXPECT_THAT(ens.read_elemental_variable(1, "e"), ElementsAre(-1., -2., -2., -4., -3., -6.));
+    EXPECT_THAT(ens.read_global_variable(1, "g"), ElementsAre(10., 20., 30.));
+    EXPECT_EQ(ens.get_num_open_files(), 1);
+
+    EXPECT_THROW(ens.read_nodal_variable(1, "v"), Exception);
+}
+
+TEST(EnsembleTest, distinct_meshes)
+{
+    write_member("ens-a.e", 1., 1.);
+    write_member("ens-b.e", 2., 1.);
+    write_member("ens-c.e", 1., 2.);
+
+    Ensemble ens({ "ens-a.e", "ens-b.e", "ens-c.e" });
+    EXPECT_EQ(ens.get_num_meshes(), 2);
+    EXPECT_EQ(ens.get_mesh_index(0), 0);
+    EXPECT_EQ(ens.get_mesh_index(1), 1);
+    EXPECT_EQ(ens.get_mesh_index(2), 0);
+    EXPECT_NE(ens.get_mesh_fingerprint(0), ens.get_mesh_fingerprint(1));
+    EXPECT_THAT(ens.get_mesh(1).get_x_coords(), ElementsAre(0., 1., 2.));
+
+    EXPECT_THROW(ens.read_nodal_variable(1, "u"), Exception);
+    EXPECT_THAT(ens.read_global_variable(1, "g"), ElementsAre(10., 10., 20.));
+
+    Ensemble threaded({ "ens-a.e", "ens-b.e", "ens-c.e" }, 16, 3);
+    EXPECT_EQ(threaded.get_num_meshes(), 2);
+    for (std::size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(threaded.get_mesh_index(i), ens.get_mesh_index(i));
+        EXPECT_EQ(threaded.get_mesh_fingerprint(i), ens.get_mesh_fingerprint(i));
+    }
+    EXPECT_THAT(threaded.read_global_variable(1, "g"), ElementsAre(10., 10., 20.));
+    EXPECT_THROW(Ensemble({ "ens-a.e", "ens-missing.e" }, 16, 2), Exception);
+}
@@ -0,0 +1,95 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+#include <mpi.h>
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+namespace {
+
+/// Range `[first, last)` of `n` items assigned to a rank
+std::pair<int64_t, int64_t>
+rank_range(int64_t n, int rank, int n_ranks)
+{
+    return { n * rank / n_ranks, n * (rank + 1) / n_ranks };
+}
+
+/// Strip of `N_ELEMS` QUAD4 elements along the x-axis
+const int N_ELEMS = 2;
+const int N_NODES = 2 * (N_ELEMS + 1);
+
+} // namespace
+
+TEST(FileParallelTest, write_read)
+{
+    int rank, n_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
+
+    // each rank writes its own range of nodes and elements; with more ranks than elements, some
+    // ranks have nothing to write, but still take part in the collective calls
+    {
+        File f("parallel.e", FileAccess::WRITE, MPI_COMM_WORLD);
+        EXPECT_TRUE(f.is_parallel());
+        f.init("parallel", 2, N_NODES, N_ELEMS, 1, 0, 0);
+        f.write_coord_names();
+        f.write_block_info(1, "QUAD4", N_ELEMS, 4);
+        f.write_nodal_var_names({ "u" });
+        f.write_elem_var_names({ "e" });
+        f.write_elem_var_truth_table({ 1 });
+        f.write_time(1, 0.5);
+
+        auto [n0, n1] = rank_range(N_NODES, rank, n_ranks);
+        std::vector<double> x, y, u;
+        for (auto i = n0; i < n1; i++) {
+            x.push_back(i % (N_ELEMS + 1));
+            y.push_back(i / (N_ELEMS + 1));
+            u.push_back(i);
+        }
+        f.write_partial_coords(n0, x, y, {});
+        f.write_partial_nodal_var_range(1, 1, n0, u);
+
+        auto [e0, e1] = rank_range(N_ELEMS, rank, n_ranks);
+        std::vector<int> connect;
+        std::vector<double> e;
+        for (auto i = e0; i < e1; i++) {
+            int k = static_cast<int>(i + 1);
+            connect.insert(connect.end(), { k, k + 1, k + N_ELEMS + 2, k + N_ELEMS + 1 });
+            e.push_back(10. * i);
+        }
+        f.write_partial_connectivity(1, e0, e1 - e0, connect);
+        f.write_partial_elem_var_range(1, 1, 1, e0, e);
+    }
+
+    // each rank reads back what the next rank wrote
+    File f("parallel.e", FileAccess::READ, MPI_COMM_WORLD);
+    EXPECT_EQ(f.get_num_nodes(), N_NODES);
+    EXPECT_EQ(f.get_num_elements(), N_ELEMS);
+    int other = (rank + 1) % n_ranks;
+
+    auto [n0, n1] = rank_range(N_NODES, other, n_ranks);
+    std::vector<double> x, y, z;
+    f.read_partial_coords(n0, n1 - n0, x, y, z);
+    auto u = f.get_partial_nodal_variable_values(1, 1, n0, n1 - n0);
+    for (auto i = n0; i < n1; i++) {
+        EXPECT_EQ(x[i - n0], i % (N_ELEMS + 1));
+        EXPECT_EQ(y[i - n0], i / (N_ELEMS + 1));
+        EXPECT_EQ(u[i - n0], i);
+    }
+
+    auto [e0, e1] = rank_range(N_ELEMS, other, n_ranks);
+    std::vector<int> connect;
+    f.read_partial_connectivity(1, e0, e1 - e0, connect);
+    auto e = f.get_partial_elemental_variable_values(1, 1, 1, e0, e1 - e0);
+    ASSERT_EQ(connect.size(), 4 * e.size());
+    for (auto i = e0; i < e1; i++) {
+        EXPECT_EQ(connect[4 * (i - e0)], i + 1);
+        EXPECT_EQ(e[i - e0], 10. * i);
+    }
+
+    EXPECT_TRUE(f.is_parallel());
+    f.close();
+    EXPECT_FALSE(f.is_parallel());
+    f.open("parallel.e");
+    EXPECT_FALSE(f.is_parallel());
+}
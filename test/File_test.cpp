@@ -31,6 +31,11 @@ TEST(FileTest, open)
 
     f.read_elem_map();
     // TODO: add a check that map was read and is ok
+
+    f.read_node_id_map();
+    EXPECT_THAT(f.get_node_id_map().get_ids(), ElementsAre(1, 2, 3));
+    f.read_elem_id_map();
+    EXPECT_THAT(f.get_elem_id_map().get_ids(), ElementsAre(1));
 }
 
 TEST(FileTest, open_non_existing)
@@ -166,6 +171,8 @@ TEST(FileTest, create_edge2)
     f.write_coords(x);
 
     std::vector<int> connect1 = { 1, 2, 2, 3 };
+    EXPECT_THROW(f.write_block(1, "BAR2", 0, connect1), Exception);
+    EXPECT_THROW(f.write_block(1, "BAR2", 3, connect1), Exception);
     f.write_block(1, "BAR2", 2, connect1);
 
     f.write_time(1, 1.);
@@ -258,8 +265,447 @@ TEST(FileTest, append_time_step)
         auto ts2_values = f.get_nodal_variable_values(2, 1);
         EXPECT_THAT(ts2_values, ElementsAre(DoubleEq(2.0), DoubleEq(4.0), DoubleEq(6.0)));
 
+        auto partial = f.get_partial_nodal_variable_values(2, 1, 1, 2);
+        EXPECT_THAT(partial, ElementsAre(DoubleEq(4.0), DoubleEq(6.0)));
+        EXPECT_THROW(f.get_partial_nodal_variable_values(2, 1, 2, 2), Exception);
+
+        f.close();
+    }
+}
+
+TEST(FileTest, append_step)
+{
+    {
+        File f(std::string("append_step.e"), FileAccess::WRITE);
+        f.init("test", 2, 4, 2, 2, 0, 0);
+        f.write_coords({ 0, 1, 0, 1 }, { 0, 0, 1, 1 });
+        f.write_block(1, "TRI3", 1, { 1, 2, 3 });
+        f.write_block(2, "TRI3", 1, { 2, 4, 3 });
+        f.write_nodal_var_names({ "u" });
+        f.write_elem_var_names({ "e1", "e2" });
+        f.write_elem_var_truth_table({ 1, 1, 0, 1 });
+        f.write_global_var_names({ "g1", "g2" });
+        f.write_time(1, 0.);
+        f.write_nodal_var(1, 1, { 0., 0., 0., 0. });
+        f.write_elem_var(1, 1, 1, { 0. });
+        f.write_elem_var(1, 2, 1, { 0. });
+        f.write_elem_var(1, 2, 2, { 0. });
+        f.write_global_vars(1, { 0., 0. });
+        EXPECT_THROW(f.append_step(1., {}, {}, {}), Exception);
+    }
+
+    {
+        File f(std::string("append_step.e"), FileAccess::APPEND);
+        EXPECT_EQ(f.get_num_times(), 1);
+        EXPECT_THAT(f.get_nodal_variable_names(), ElementsAre("u"));
+        EXPECT_THAT(f.get_elemental_variable_names(), ElementsAre("e1", "e2"));
+        EXPECT_THAT(f.get_global_variable_names(), ElementsAre("g1", "g2"));
+
+        std::vector<double> u = { 1., 2., 3., 4. };
+        std::vector<double> e1 = { 5., 6. };
+        std::vector<double> e2 = { 7., 8. };
+        std::vector<double> g = { 9., 10. };
+        EXPECT_EQ(f.append_step(0.5, { u }, { e1, e2 }, g), 2);
+        EXPECT_EQ(f.append_step(1.0, { u }, { e1, e2 }, g), 3);
+        EXPECT_EQ(f.get_num_times(), 3);
+
+        EXPECT_THROW(f.append_step(1.5, {}, { e1, e2 }, g), Exception);
+        EXPECT_THROW(f.append_step(1.5, { e1 }, { e1, e2 }, g), Exception);
+        EXPECT_THROW(f.append_step(1.5, { u }, { u, e2 }, g), Exception);
+        EXPECT_THROW(f.append_step(1.5, { u }, { e1, e2 }, u), Exception);
+        f.update();
+    }
+
+    File f(std::string("append_step.e"), FileAccess::READ);
+    f.read_times();
+    EXPECT_THAT(f.get_times(), ElementsAre(DoubleEq(0.), DoubleEq(0.5), DoubleEq(1.)));
+    EXPECT_THAT(f.get_nodal_variable_values(3, 1), ElementsAre(1., 2., 3., 4.));
+    auto e1 = f.get_elemental_variable_values(3, 1);
+    EXPECT_EQ(e1[0], 5.);
+    EXPECT_TRUE(std::isnan(e1[1]));
+    EXPECT_THAT(f.get_elemental_variable_values(3, 2), ElementsAre(7., 8.));
+    EXPECT_THAT(f.get_global_variable_values(3), ElementsAre(9., 10.));
+}
+
+TEST(FileTest, write_elem_var_truth_table)
+{
+    {
+        File f(std::string("write_truth_table.e"), FileAccess::WRITE);
+        f.init("test", 2, 4, 2, 2, 0, 0);
+        f.write_coords({ 0, 1, 0, 1 }, { 0, 0, 1, 1 });
+        f.write_block(1, "TRI3", 1, { 1, 2, 3 });
+        f.write_block(2, "TRI3", 1, { 2, 4, 3 });
+        f.write_elem_var_names({ "e1", "e2" });
+        f.write_elem_var_truth_table({ 1, 1, 0, 1 });
+        f.write_time(1, 0.);
+        // `e1` is not defined on the second block, its value there is dropped
+        f.write_elem_var(1, 1, { 1., 2. });
+        f.write_elem_var(1, 2, { 3., 4. });
+        auto e1 = f.get_elemental_variable_values(1, 1);
+        EXPECT_EQ(e1[0], 1.);
+        EXPECT_TRUE(std::isnan(e1[1]));
+    }
+
+    File f(std::string("write_truth_table.e"), FileAccess::READ);
+    EXPECT_THAT(f.read_elem_var_truth_table(), ElementsAre(1, 1, 0, 1));
+    auto e1 = f.get_elemental_variable_values(1, 1);
+    EXPECT_EQ(e1[0], 1.);
+    EXPECT_TRUE(std::isnan(e1[1]));
+    EXPECT_THAT(f.get_elemental_variable_values(1, 2), ElementsAre(3., 4.));
+    auto part = f.get_partial_elemental_variable_values(1, 1, 1, 1);
+    EXPECT_TRUE(std::isnan(part[0]));
+}
+
+TEST(FileTest, append_step_without_truth_table)
+{
+    {
+        // no truth table is stored and `e` was written on the first block only
+        File f(std::string("append_step_no_tab.e"), FileAccess::WRITE);
+        f.init("test", 2, 4, 2, 2, 0, 0);
+        f.write_coords({ 0, 1, 0, 1 }, { 0, 0, 1, 1 });
+        f.write_block(1, "TRI3", 1, { 1, 2, 3 });
+        f.write_block(2, "TRI3", 1, { 2, 4, 3 });
+        f.write_elem_var_names({ "e" });
+        f.write_time(1, 0.);
+        f.write_elem_var(1, 1, 1, { 1. });
+    }
+
+    {
+        File f(std::string("append_step_no_tab.e"), FileAccess::APPEND);
+        std::vector<double> e = { 2., 3. };
+        EXPECT_EQ(f.append_step(0.5, {}, { e }, {}), 2);
+    }
+
+    File f(std::string("append_step_no_tab.e"), FileAccess::READ);
+    EXPECT_THAT(f.get_elemental_variable_values(2, 1), ElementsAre(2., 3.));
+}
+
+TEST(FileTest, id_maps)
+{
+    {
+        File f(std::string("id_maps.e"), FileAccess::WRITE);
+        f.init("test", 2, 4, 2, 1, 0, 0);
+        f.write_coords({ 0, 1, 0, 1 }, { 0, 0, 1, 1 });
+        f.write_block(1, "TRI3", 2, { 1, 2, 3, 2, 4, 3 });
+        f.write_node_id_map({ 10, 20, 30, 5000000000LL });
+        f.write_elem_id_map({ 7, 3 });
         f.close();
     }
+
+    File g(std::string("id_maps.e"), FileAccess::READ);
+    g.read_node_id_map();
+    g.read_elem_id_map();
+
+    const auto & node_map = g.get_node_id_map();
+    EXPECT_THAT(node_map.get_ids(), ElementsAre(10, 20, 30, 5000000000LL));
+    EXPECT_EQ(node_map.get_index(20), 1);
+    EXPECT_EQ(node_map.get_index(5000000000LL), 3);
+    EXPECT_EQ(node_map.get_index(15), -1);
+
+    const auto & elem_map = g.get_elem_id_map();
+    EXPECT_THAT(elem_map.get_ids(), ElementsAre(7, 3));
+    EXPECT_EQ(elem_map.get_index(3), 1);
+    EXPECT_EQ(elem_map.get_index(7), 0);
+}
+
+TEST(FileTest, global_element_index)
+{
+    {
+        File f(std::string("global_elem.e"), FileAccess::WRITE);
+        f.init("test", 2, 6, 3, 2, 0, 0);
+        f.write_coords({ 0, 1, 2, 0, 1, 2 }, { 0, 0, 0, 1, 1, 1 });
+        f.write_block(10, "TRI3", 2, { 1, 2, 4, 2, 5, 4 });
+        f.write_block(20, "QUAD4", 1, { 2, 3, 6, 5 });
+
+        EXPECT_EQ(f.get_global_element_index(1, 0), 2);
+
+        f.write_time(1, 0.);
+        f.write_elem_var_names({ "ev" });
+        f.write_elem_var(1, 1, { 1., 2., 3. });
+        EXPECT_THROW(f.write_elem_var(1, 1, { 1., 2. }), Exception);
+        f.write_partial_elem_var_range(1, 1, 1, { 5., 6. });
+        EXPECT_THROW(f.write_partial_elem_var_range(1, 1, 2, { 5., 6. }), Exception);
+        f.close();
+    }
+
+    File g(std::string("global_elem.e"), FileAccess::READ);
+    EXPECT_EQ(g.get_element_block_index(10), 0);
+    EXPECT_EQ(g.get_element_block_index(20), 1);
+    EXPECT_THROW(g.get_element_block_index(30), Exception);
+
+    EXPECT_EQ(g.get_global_element_index(0, 0), 0);
+    EXPECT_EQ(g.get_global_element_index(0, 1), 1);
+    EXPECT_EQ(g.get_global_element_index(1, 0), 2);
+    EXPECT_THROW(g.get_global_element_index(0, 2), Exception);
+    EXPECT_THROW(g.get_global_element_index(2, 0), Exception);
+
+    EXPECT_EQ(g.get_local_element_index(0), std::make_pair(std::size_t(0), int64_t(0)));
+    EXPECT_EQ(g.get_local_element_index(1), std::make_pair(std::size_t(0), int64_t(1)));
+    EXPECT_EQ(g.get_local_element_index(2), std::make_pair(std::size_t(1), int64_t(0)));
+    EXPECT_THROW(g.get_local_element_index(3), Exception);
+    EXPECT_THROW(g.get_local_element_index(-1), Exception);
+
+    EXPECT_THAT(g.get_elemental_variable_values(1, 1),
+                ElementsAre(DoubleEq(1.), DoubleEq(5.), DoubleEq(6.)));
+    EXPECT_THAT(g.get_elemental_variable_values(1, 1, 20), ElementsAre(DoubleEq(6.)));
+    EXPECT_THROW(g.get_elemental_variable_values(1, 0), Exception);
+    EXPECT_THROW(g.get_elemental_variable_values(1, 2), Exception);
+
+    EXPECT_THAT(g.get_partial_elemental_variable_values(1, 1, 1, 2),
+                ElementsAre(DoubleEq(5.), DoubleEq(6.)));
+    EXPECT_THAT(g.get_partial_elemental_variable_values(1, 1, 0, 0), IsEmpty());
+    EXPECT_THROW(g.get_partial_elemental_variable_values(1, 1, 2, 2), Exception);
+    EXPECT_THROW(g.get_partial_elemental_variable_values(1, 2, 0, 1), Exception);
+}
+
+TEST(FileTest, read_connectivity)
+{
+    {
+        File f(std::string("csr.e"), FileAccess::WRITE);
+        f.init("test", 2, 6, 3, 2, 0, 0);
+        f.write_coords({ 0, 1, 2, 0, 1, 2 }, { 0, 0, 0, 1, 1, 1 });
+        f.write_block(10, "TRI3", 2, { 1, 2, 4, 2, 5, 4 });
+        f.write_block(20, "QUAD4", 1, { 2, 3, 6, 5 });
+        f.close();
+    }
+
+    File g(std::string("csr.e"), FileAccess::READ);
+    g.read_connectivity();
+    const auto & conn = g.get_connectivity();
+    EXPECT_EQ(conn.get_num_elements(), 3);
+    EXPECT_THAT(conn.get_offsets(), ElementsAre(0, 3, 6, 10));
+    EXPECT_THAT(conn.get_node_ids(), ElementsAre(1, 2, 4, 2, 5, 4, 2, 3, 6, 5));
+    EXPECT_THAT(conn.get_type_tags(), ElementsAre(0, 0, 1));
+    EXPECT_THAT(conn.get_element_types(), ElementsAre("TRI3", "QUAD4"));
+    auto nodes = conn.get_element_nodes(2);
+    EXPECT_THAT(std::vector<int>(nodes.begin(), nodes.end()), ElementsAre(2, 3, 6, 5));
+}
+
+TEST(FileTest, geometry_summary)
+{
+    {
+        File f(std::string("geom.e"), FileAccess::WRITE);
+        f.init("test", 2, 7, 5, 3, 0, 0);
+        f.write_coords({ 0, 1, 2, 0, 1, 2, 5 }, { 0, 0, 0, 1, 1, 1, -1 });
+        f.write_block(10, "TRI3", 2, { 1, 2, 4, 2, 5, 4 });
+        f.write_block(20, "QUAD4", 1, { 2, 3, 6, 5 });
+        f.write_block_info(30, "NULL", 2, 0);
+        f.close();
+    }
+
+    File g(std::string("geom.e"), FileAccess::READ);
+    EXPECT_THROW(g.compute_geometry_summary(), Exception);
+
+    g.read_coords();
+    g.read_blocks();
+    auto summary = g.compute_geometry_summary();
+    EXPECT_THAT(summary.bbox.min, ElementsAre(DoubleEq(0.), DoubleEq(-1.), DoubleEq(0.)));
+    EXPECT_THAT(summary.bbox.max, ElementsAre(DoubleEq(5.), DoubleEq(1.), DoubleEq(0.)));
+
+    ASSERT_EQ(summary.blocks.size(), 3);
+    auto & b0 = summary.blocks[0];
+    EXPECT_EQ(b0.block_id, 10);
+    EXPECT_THAT(b0.bbox.min, ElementsAre(DoubleEq(0.), DoubleEq(0.), DoubleEq(0.)));
+    EXPECT_THAT(b0.bbox.max, ElementsAre(DoubleEq(1.), DoubleEq(1.), DoubleEq(0.)));
+    EXPECT_THAT(b0.centroids,
+                ElementsAre(DoubleEq(1. / 3.),
+                            DoubleEq(1. / 3.),
+                            DoubleEq(0.),
+                            DoubleEq(2. / 3.),
+                            DoubleEq(2. / 3.),
+                            DoubleEq(0.)));
+    EXPECT_THAT(b0.char_lengths, ElementsAre(DoubleEq(std::sqrt(2.)), DoubleEq(std::sqrt(2.))));
+
+    auto & b1 = summary.blocks[1];
+    EXPECT_EQ(b1.block_id, 20);
+    EXPECT_THAT(b1.bbox.min, ElementsAre(DoubleEq(1.), DoubleEq(0.), DoubleEq(0.)));
+    EXPECT_THAT(b1.bbox.max, ElementsAre(DoubleEq(2.), DoubleEq(1.), DoubleEq(0.)));
+    EXPECT_THAT(b1.centroids, ElementsAre(DoubleEq(1.5), DoubleEq(0.5), DoubleEq(0.)));
+    EXPECT_DOUBLE_EQ(b1.min_char_length, std::sqrt(2.));
+    EXPECT_DOUBLE_EQ(b1.max_char_length, std::sqrt(2.));
+
+    auto & b2 = summary.blocks[2];
+    EXPECT_EQ(b2.block_id, 30);
+    EXPECT_TRUE(b2.centroids.empty());
+    EXPECT_TRUE(b2.char_lengths.empty());
+
+    auto threaded = g.compute_geometry_summary(4);
+    ASSERT_EQ(threaded.blocks.size(), 3);
+    EXPECT_EQ(threaded.blocks[0].centroids, b0.centroids);
+    EXPECT_EQ(threaded.blocks[1].char_lengths, b1.char_lengths);
+    EXPECT_DOUBLE_EQ(threaded.blocks[1].min_char_length, b1.min_char_length);
+}
+
+TEST(FileTest, reordering)
+{
+    // 1D mesh with nodes numbered right to left
+    std::vector<double> x = { 3, 2, 1, 0 };
+    std::vector<int> connect = { 2, 1, 3, 2, 4, 3 };
+    ElementBlock blk;
+    blk.set_id(1);
+    blk.set_connectivity("BAR2", 3, 2, connect);
+    Reordering r(ReorderingMethod::HILBERT, x, {}, {}, { blk });
+
+    {
+        File f(std::string("reorder-bad.e"), FileAccess::WRITE);
+        f.init("test", 1, 5, 3, 1, 0, 0);
+        EXPECT_THROW(f.set_reordering(r), Exception);
+    }
+    {
+        File f(std::string("reorder.e"), FileAccess::WRITE);
+        f.init("test", 1, 4, 3, 1, 1, 1);
+        f.set_reordering(r);
+        f.write_coords(x);
+        EXPECT_THROW(f.write_block(1, "BAR2", 3, { 2, 1, 3, 2, 5, 3 }), Exception);
+        f.write_block(1, "BAR2", 3, connect);
+        // the reordering was computed for one block only
+        EXPECT_THROW(f.write_block(2, "BAR2", 3, connect), Exception);
+        f.write_node_set(10, { 1 });
+        f.write_side_set(20, { 1 }, { 2 });
+        f.write_nodal_var_names({ "u" });
+        f.write_elem_var_names({ "e" });
+        f.write_time(1, 0.);
+        f.write_nodal_var(1, 1, { 30., 20., 10., 0. });
+        f.write_elem_var(1, 1, { 0.5, 1.5, 2.5 });
+        EXPECT_THROW(f.write_partial_nodal_var(1, 1, 1, 5, 0.), Exception);
+        EXPECT_THROW(f.write_partial_elem_var(1, 1, 1, 4, 0.), Exception);
+        f.close();
+    }
+
+    File g(std::string("reorder.e"), FileAccess::READ);
+    g.read_coords();
+    g.read_blocks();
+    g.read_node_sets();
+    g.read_side_sets();
+    g.read_node_id_map();
+    g.read_elem_id_map();
+    EXPECT_THAT(g.get_x_coords(), ElementsAre(0., 1., 2., 3.));
+    EXPECT_THAT(g.get_element_block(0).get_connectivity(), ElementsAre(1, 2, 2, 3, 3, 4));
+    EXPECT_THAT(g.get_node_sets()[0].get_node_ids(), ElementsAre(4));
+    EXPECT_THAT(g.get_side_sets()[0].get_element_ids(), ElementsAre(3));
+    EXPECT_THAT(g.get_nodal_variable_values(1, 1), ElementsAre(0., 10., 20., 30.));
+    EXPECT_THAT(g.get_elemental_variable_values(1, 1), ElementsAre(2.5, 1.5, 0.5));
+    // original numbering is stored in the ID maps
+    EXPECT_THAT(g.get_node_id_map().get_ids(), ElementsAre(4, 3, 2, 1));
+    EXPECT_THAT(g.get_elem_id_map().get_ids(), ElementsAre(3, 2, 1));
+}
+
+TEST(FileTest, partial_reads)
+{
+    {
+        File f(std::string("partial.e"), FileAccess::WRITE);
+        f.init("test", 2, 6, 3, 2, 1, 1);
+        f.write_coords({ 0, 1, 2, 0, 1, 2 }, { 0, 0, 0, 1, 1, 1 });
+        f.write_block(10, "TRI3", 2, { 1, 2, 4, 2, 5, 4 });
+        f.write_block(20, "QUAD4", 1, { 2, 3, 6, 5 });
+        f.write_block_names({ "tris", "quads" });
+        f.write_node_set(3, { 1, 4 });
+        f.write_node_set_names({ "left" });
+        f.write_side_set(7, { 3 }, { 2 });
+        f.close();
+    }
+
+    File g(std::string("partial.e"), FileAccess::READ);
+    EXPECT_THAT(g.get_element_block_ids(), ElementsAre(10, 20));
+
+    std::vector<double> x, y, z;
+    g.read_partial_coords(2, 3, x, y, z);
+    EXPECT_THAT(x, ElementsAre(2., 0., 1.));
+    EXPECT_THAT(y, ElementsAre(0., 1., 1.));
+    EXPECT_TRUE(z.empty());
+    EXPECT_THROW(g.read_partial_coords(4, 3, x, y, z), Exception);
+
+    auto blk = g.read_block_info(10);
+    EXPECT_EQ(blk.get_id(), 10);
+    EXPECT_EQ(blk.get_name(), "tris");
+    EXPECT_EQ(blk.get_element_type(), "TRI3");
+    EXPECT_EQ(blk.get_num_elements(), 2);
+    EXPECT_EQ(blk.get_num_nodes_per_element(), 3);
+    EXPECT_TRUE(blk.get_connectivity().empty());
+
+    std::vector<int> connect;
+    g.read_partial_connectivity(10, 1, 1, connect);
+    EXPECT_THAT(connect, ElementsAre(2, 5, 4));
+    EXPECT_THROW(g.read_partial_connectivity(20, 0, 2, connect), Exception);
+
+    EXPECT_THAT(g.read_node_set_ids(), ElementsAre(3));
+    auto ns = g.read_node_set(3);
+    EXPECT_EQ(ns.get_name(), "left");
+    EXPECT_THAT(ns.get_node_ids(), ElementsAre(1, 4));
+
+    EXPECT_THAT(g.read_side_set_ids(), ElementsAre(7));
+    auto ss = g.read_side_set(7);
+    EXPECT_THAT(ss.get_element_ids(), ElementsAre(3));
+    EXPECT_THAT(ss.get_side_ids(), ElementsAre(2));
+}
+
+TEST(FileTest, variable_steps)
+{
+    {
+        File f(std::string("steps.e"), FileAccess::WRITE);
+        f.init("test", 1, 3, 3, 2, 0, 0);
+        f.write_coords({ 0, 1, 2 });
+        f.write_block(1, "BAR2", 1, { 1, 2 });
+        f.write_block(2, "BAR2", 2, { 2, 3, 3, 1 });
+        f.write_nodal_var_names({ "u" });
+        f.write_elem_var_names({ "e" });
+        for (int step = 1; step <= 3; step++) {
+            f.write_time(step, step);
+            f.write_nodal_var(step, 1, { 1. * step, 2. * step, 3. * step });
+            f.write_elem_var(step, 1, 2, { -1. * step, -2. * step });
+        }
+    }
+
+    File g(std::string("steps.e"), FileAccess::READ);
+    std::vector<double> values;
+    g.get_nodal_variable_steps(1, 2, 3, values);
+    EXPECT_THAT(values, ElementsAre(2., 4., 6., 3., 6., 9.));
+    g.get_elemental_variable_steps(1, 2, 1, 2, values);
+    EXPECT_THAT(values, ElementsAre(-1., -2., -2., -4.));
+    EXPECT_GE(g.get_nodal_variable_steps_per_chunk(1), 1);
+    EXPECT_GE(g.get_elemental_variable_steps_per_chunk(1, 2), 1);
+    EXPECT_THROW(g.get_elemental_variable_steps_per_chunk(1, 3), Exception);
+}
+
+TEST(FileTest, partial_writes)
+{
+    {
+        File f(std::string("partial-write.e"), FileAccess::WRITE);
+        f.init("test", 2, 6, 3, 2, 0, 0);
+        f.write_partial_coords(0, { 0, 1 }, { 0, 0 }, {});
+        f.write_partial_coords(2, { 2, 0, 1, 2 }, { 0, 1, 1, 1 }, {});
+        EXPECT_THROW(f.write_partial_coords(0, { 0, 1 }, { 0 }, {}), Exception);
+        f.write_block_info(10, "TRI3", 2, 3);
+        f.write_partial_connectivity(10, 1, 1, { 2, 5, 4 });
+        f.write_partial_connectivity(10, 0, 1, { 1, 2, 4 });
+        f.write_block_info(20, "QUAD4", 1, 4);
+        f.write_partial_connectivity(20, 0, 1, { 2, 3, 6, 5 });
+        f.write_nodal_var_names({ "u" });
+        f.write_elem_var_names({ "e" });
+        f.write_time(1, 0.);
+        f.write_partial_nodal_var_range(1, 1, 3, { 3., 4., 5. });
+        f.write_partial_nodal_var_range(1, 1, 0, { 0., 1., 2. });
+        f.write_partial_elem_var_range(1, 1, 10, 1, { 20. });
+        f.write_partial_elem_var_range(1, 1, 10, 0, { 10. });
+        f.write_partial_elem_var_range(1, 1, 20, 0, { 30. });
+        f.close();
+    }
+
+    File g(std::string("partial-write.e"), FileAccess::READ);
+    g.read_coords();
+    EXPECT_THAT(g.get_x_coords(), ElementsAre(0., 1., 2., 0., 1., 2.));
+    EXPECT_THAT(g.get_y_coords(), ElementsAre(0., 0., 0., 1., 1., 1.));
+    g.read_blocks();
+    EXPECT_EQ(g.get_num_element_blocks(), 2);
+    auto & blk = g.get_element_block(0);
+    EXPECT_EQ(blk.get_id(), 10);
+    EXPECT_THAT(blk.get_connectivity(), ElementsAre(1, 2, 4, 2, 5, 4));
+    EXPECT_THAT(g.get_element_block(1).get_connectivity(), ElementsAre(2, 3, 6, 5));
+    EXPECT_FALSE(g.is_parallel());
+    EXPECT_THAT(g.get_nodal_variable_values(1, 1), ElementsAre(0., 1., 2., 3., 4., 5.));
+    EXPECT_THAT(g.get_partial_elemental_variable_values(1, 1, 10, 1, 1), ElementsAre(20.));
+    EXPECT_THAT(g.get_partial_elemental_variable_values(1, 1, 10, 0, 2), ElementsAre(10., 20.));
+    EXPECT_THROW(g.get_partial_elemental_variable_values(1, 1, 20, 0, 2), Exception);
 }
 
 TEST(FileTest, read_square)
@@ -390,3 +836,35 @@ TEST(FileTest, test)
         f.close();
     }
 }
+
+TEST(FileTest, mesh_fingerprint)
+{
+    auto write_mesh = [](const std::string & file_name, double y_top, bool store) {
+        File f(file_name, FileAccess::WRITE);
+        f.init("test", 2, 4, 1, 1, 1, 1);
+        f.write_coords({ 0, 1, 1, 0 }, { 0, 0, y_top, y_top });
+        f.write_block(1, "QUAD4", 1, { 1, 2, 3, 4 });
+        f.write_node_set(10, { 1, 2 });
+        f.write_side_set(20, { 1 }, { 1 });
+        if (store)
+            f.write_info_with_fingerprint({ "created by a test" });
+        else
+            f.write_info({ "created by a test" });
+    };
+    write_mesh("fingerprint-1.e", 1., false);
+    write_mesh("fingerprint-2.e", 1., true);
+    write_mesh("fingerprint-3.e", 2., false);
+
+    File f1(std::string("fingerprint-1.e"), FileAccess::READ);
+    File f2(std::string("fingerprint-2.e"), FileAccess::READ);
+    File f3(std::string("fingerprint-3.e"), FileAccess::READ);
+    EXPECT_EQ(f1.mesh_fingerprint(), f2.mesh_fingerprint(false));
+    EXPECT_EQ(f1.mesh_fingerprint(), f2.mesh_fingerprint());
+    EXPECT_NE(f1.mesh_fingerprint(), f3.mesh_fingerprint());
+    EXPECT_EQ(f1.mesh_fingerprint(false, 4), f1.mesh_fingerprint(false));
+
+    auto info = f2.read_info();
+    ASSERT_EQ(info.size(), 2);
+    EXPECT_EQ(info[0], "created by a test");
+    EXPECT_EQ(info[1], fmt::format("mesh-fingerprint: {:016x}", f1.mesh_fingerprint()));
+}
@@ -0,0 +1,77 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+TEST(IdMapTest, empty)
+{
+    IdMap map;
+    EXPECT_EQ(map.get_size(), 0);
+    EXPECT_EQ(map.get_index(1), -1);
+    EXPECT_THROW(map.get_id(0), Exception);
+}
+
+TEST(IdMapTest, dense)
+{
+    IdMap map;
+    map.set_ids({ 11, 13, 12, 10 });
+    EXPECT_EQ(map.get_size(), 4);
+    EXPECT_EQ(map.get_id(0), 11);
+    EXPECT_EQ(map.get_id(3), 10);
+    EXPECT_THROW(map.get_id(4), Exception);
+    EXPECT_THAT(map.get_ids(), ElementsAre(11, 13, 12, 10));
+
+    EXPECT_EQ(map.get_index(10), 3);
+    EXPECT_EQ(map.get_index(11), 0);
+    EXPECT_EQ(map.get_index(12), 2);
+    EXPECT_EQ(map.get_index(13), 1);
+    EXPECT_EQ(map.get_index(9), -1);
+    EXPECT_EQ(map.get_index(14), -1);
+}
+
+TEST(IdMapTest, sparse)
+{
+    IdMap map;
+    std::vector<int64_t> ids;
+    for (int64_t i = 0; i < 1000; i++)
+        ids.push_back(i * 1000003 + 5000000000LL);
+    map.set_ids(ids);
+
+    for (int64_t i = 0; i < 1000; i++)
+        EXPECT_EQ(map.get_index(ids[i]), i);
+    EXPECT_EQ(map.get_index(1), -1);
+    EXPECT_EQ(map.get_index(5000000001LL), -1);
+}
+
+TEST(IdMapTest, duplicates)
+{
+    IdMap dense;
+    EXPECT_THROW(dense.set_ids({ 1, 2, 2 }), Exception);
+
+    IdMap sparse;
+    EXPECT_THROW(sparse.set_ids({ 1, 1000000, 1 }), Exception);
+}
+
+TEST(IdMapTest, extreme_ids)
+{
+    IdMap map;
+    map.set_ids({ INT64_MIN, INT64_MAX });
+    EXPECT_EQ(map.get_index(INT64_MIN), 0);
+    EXPECT_EQ(map.get_index(INT64_MAX), 1);
+    EXPECT_EQ(map.get_index(0), -1);
+
+    map.set_ids({ INT64_MAX - 1, INT64_MAX });
+    EXPECT_EQ(map.get_index(INT64_MAX), 1);
+    EXPECT_EQ(map.get_index(INT64_MIN), -1);
+}
+
+TEST(IdMapTest, duplicates_keep_map)
+{
+    IdMap map;
+    map.set_ids({ 1, 2, 3 });
+    EXPECT_THROW(map.set_ids({ 4, 5, 5 }), Exception);
+    EXPECT_THAT(map.get_ids(), ElementsAre(1, 2, 3));
+    EXPECT_EQ(map.get_index(3), 2);
+    EXPECT_EQ(map.get_index(4), -1);
+}
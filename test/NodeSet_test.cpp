@@ -29,3 +29,82 @@ TEST(NodeSetTest, test)
 
     EXPECT_THAT(ns.get_node_ids(), ElementsAre(1, 2, 3));
 }
+
+TEST(NodeSetTest, contains)
+{
+    NodeSet sparse;
+    sparse.set_nodes({ 1000, 5, 70000, 5 });
+    EXPECT_TRUE(sparse.contains(5));
+    EXPECT_TRUE(sparse.contains(1000));
+    EXPECT_TRUE(sparse.contains(70000));
+    EXPECT_FALSE(sparse.contains(6));
+    EXPECT_FALSE(sparse.contains(-1));
+
+    NodeSet dense;
+    std::vector<int> nodes;
+    for (int i = 200; i > 0; i -= 2)
+        nodes.push_back(i);
+    dense.set_nodes(nodes);
+    EXPECT_TRUE(dense.contains(2));
+    EXPECT_TRUE(dense.contains(128));
+    EXPECT_TRUE(dense.contains(200));
+    EXPECT_FALSE(dense.contains(1));
+    EXPECT_FALSE(dense.contains(201));
+    EXPECT_FALSE(dense.contains(202));
+    EXPECT_FALSE(dense.contains(100000));
+
+    dense.set_nodes({ 3 });
+    EXPECT_TRUE(dense.contains(3));
+    EXPECT_FALSE(dense.contains(2));
+}
+
+TEST(NodeSetTest, set_operations_sparse)
+{
+    NodeSet a;
+    a.set_nodes({ 1, 1000, 20000, 300000 });
+    NodeSet b;
+    b.set_nodes({ 300000, 5, 1000 });
+
+    EXPECT_THAT(a.union_with(b).get_node_ids(), ElementsAre(1, 5, 1000, 20000, 300000));
+    EXPECT_THAT(a.intersection_with(b).get_node_ids(), ElementsAre(1000, 300000));
+    EXPECT_THAT(a.difference_with(b).get_node_ids(), ElementsAre(1, 20000));
+    EXPECT_THAT(b.difference_with(a).get_node_ids(), ElementsAre(5));
+}
+
+TEST(NodeSetTest, set_operations_dense)
+{
+    std::vector<int> a_nodes, b_nodes;
+    for (int i = 1; i <= 100; i++)
+        a_nodes.push_back(i);
+    for (int i = 51; i <= 150; i++)
+        b_nodes.push_back(i);
+    NodeSet a;
+    a.set_nodes(a_nodes);
+    NodeSet b;
+    b.set_nodes(b_nodes);
+
+    a.set_id(1);
+    a.set_name("a");
+    auto u = a.union_with(b);
+    EXPECT_EQ(u.get_id(), -1);
+    EXPECT_EQ(u.get_name(), "");
+    EXPECT_EQ(u.get_size(), 150);
+    EXPECT_EQ(u.get_node_id(0), 1);
+    EXPECT_EQ(u.get_node_id(149), 150);
+
+    auto i = a.intersection_with(b);
+    EXPECT_EQ(i.get_size(), 50);
+    EXPECT_EQ(i.get_node_id(0), 51);
+    EXPECT_EQ(i.get_node_id(49), 100);
+
+    auto d = a.difference_with(b);
+    EXPECT_EQ(d.get_size(), 50);
+    EXPECT_EQ(d.get_node_id(0), 1);
+    EXPECT_EQ(d.get_node_id(49), 50);
+
+    NodeSet sparse;
+    sparse.set_nodes({ 10, 120, 100000 });
+    EXPECT_THAT(a.intersection_with(sparse).get_node_ids(), ElementsAre(10));
+    EXPECT_THAT(sparse.difference_with(a).get_node_ids(), ElementsAre(120, 100000));
+    EXPECT_EQ(sparse.union_with(a).get_size(), 102);
+}
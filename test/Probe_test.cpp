@@ -0,0 +1,60 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+TEST(ProbeTest, interpolate)
+{
+    const int n_elems = 200;
+    {
+        std::vector<double> x;
+        std::vector<int> connect;
+        for (int i = 0; i <= n_elems; i++)
+            x.push_back(i);
+        for (int i = 0; i < n_elems; i++) {
+            connect.push_back(i + 1);
+            connect.push_back(i + 2);
+        }
+
+        File f(std::string("probe.e"), FileAccess::WRITE);
+        f.init("test", 1, n_elems + 1, n_elems, 1, 0, 0);
+        f.write_coords(x);
+        f.write_block(1, "BAR2", n_elems, connect);
+        f.write_nodal_var_names({ "u" });
+        for (int step = 1; step <= 3; step++) {
+            f.write_time(step, step);
+            std::vector<double> u(x.size());
+            for (std::size_t i = 0; i < x.size(); i++)
+                u[i] = step * x[i];
+            f.write_nodal_var(step, 1, u);
+        }
+        f.close();
+    }
+
+    File g(std::string("probe.e"), FileAccess::READ);
+    g.read_coords();
+    g.read_blocks();
+    SpatialIndex idx(g);
+    Probe probe(g,
+                idx,
+                { { 10.25, 0., 0. }, { 180.5, 0., 0. }, { 11.5, 0., 0. }, { -1., 0., 0. } });
+    EXPECT_EQ(probe.get_num_points(), 4);
+    EXPECT_EQ(probe.get_locations()[3].block_id, -1);
+
+    // nodes around 10.25 and 11.5 share a range, nodes around 180.5 are far away
+    EXPECT_THAT(probe.get_node_ranges(), ElementsAre(Pair(10, 3), Pair(180, 2)));
+
+    auto vals = probe.interpolate(g, 1, { 1, 3 });
+    ASSERT_EQ(vals.size(), 2);
+    EXPECT_THAT(vals[0],
+                ElementsAre(DoubleNear(10.25, 1e-12),
+                            DoubleNear(180.5, 1e-12),
+                            DoubleNear(11.5, 1e-12),
+                            IsNan()));
+    EXPECT_THAT(vals[1],
+                ElementsAre(DoubleNear(30.75, 1e-12),
+                            DoubleNear(541.5, 1e-12),
+                            DoubleNear(34.5, 1e-12),
+                            IsNan()));
+}
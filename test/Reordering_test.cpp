@@ -0,0 +1,123 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+#include <cmath>
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+namespace {
+
+/// Structured grid of QUAD4 elements with nodes numbered in a scrambled order
+struct Grid {
+    int nx, ny;
+    std::vector<double> x, y;
+    ElementBlock block;
+
+    Grid(int nx, int ny) : nx(nx), ny(ny)
+    {
+        int n_nodes = (nx + 1) * (ny + 1);
+        // node (i, j) gets number perm[i + (nx + 1) * j]
+        std::vector<int> perm(n_nodes);
+        for (int k = 0; k < n_nodes; k++)
+            perm[k] = (k * 7919) % n_nodes;
+        x.resize(n_nodes);
+        y.resize(n_nodes);
+        for (int j = 0; j <= ny; j++)
+            for (int i = 0; i <= nx; i++) {
+                x[perm[i + (nx + 1) * j]] = i;
+                y[perm[i + (nx + 1) * j]] = j;
+            }
+        std::vector<int> connect;
+        auto node = [&](int i, int j) { return perm[i + (nx + 1) * j] + 1; };
+        for (int j = 0; j < ny; j++)
+            for (int i = 0; i < nx; i++)
+                connect.insert(connect.end(),
+                               { node(i, j), node(i + 1, j), node(i + 1, j + 1), node(i, j + 1) });
+        block.set_id(1);
+        block.set_connectivity("QUAD4", nx * ny, 4, connect);
+    }
+};
+
+int64_t
+bandwidth(const ElementBlock & blk, const std::vector<int64_t> & node_index)
+{
+    int64_t bw = 0;
+    for (int e = 0; e < blk.get_num_elements(); e++) {
+        auto nodes = blk.get_element_nodes(e);
+        for (auto a : nodes)
+            for (auto b : nodes)
+                bw = std::max(bw, std::abs(node_index[a - 1] - node_index[b - 1]));
+    }
+    return bw;
+}
+
+} // namespace
+
+TEST(ReorderingTest, empty)
+{
+    Reordering r;
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(r.get_num_nodes(), 0);
+    EXPECT_EQ(r.get_num_elements(), 0);
+}
+
+TEST(ReorderingTest, rcm)
+{
+    Grid grid(20, 5);
+    Reordering r(ReorderingMethod::RCM, grid.x, grid.y, {}, { grid.block });
+    EXPECT_FALSE(r.empty());
+    ASSERT_EQ(r.get_num_nodes(), 126);
+    ASSERT_EQ(r.get_num_elements(), 100);
+
+    std::vector<int64_t> identity(126);
+    for (int i = 0; i < 126; i++)
+        identity[i] = i;
+    EXPECT_GT(bandwidth(grid.block, identity), 50);
+    // level sets of the RCM ordering run across the short side of the grid
+    EXPECT_LE(bandwidth(grid.block, r.get_node_index()), 2 * (grid.ny + 1));
+
+    for (int i = 0; i < 126; i++)
+        EXPECT_EQ(r.get_node_index()[r.get_node_order()[i]], i);
+}
+
+TEST(ReorderingTest, hilbert)
+{
+    Grid grid(3, 3);
+    Reordering r(ReorderingMethod::HILBERT, grid.x, grid.y, {}, { grid.block });
+    auto x = r.permute_nodal(grid.x);
+    auto y = r.permute_nodal(grid.y);
+    // consecutive points on a Hilbert curve are neighbors
+    for (std::size_t i = 1; i < x.size(); i++)
+        EXPECT_DOUBLE_EQ(std::abs(x[i] - x[i - 1]) + std::abs(y[i] - y[i - 1]), 1.);
+}
+
+TEST(ReorderingTest, morton)
+{
+    std::vector<double> x = { 1, 0, 1, 0 };
+    std::vector<double> y = { 1, 1, 0, 0 };
+    Reordering r(ReorderingMethod::MORTON, x, y, {}, {});
+    EXPECT_THAT(r.get_node_order(), ElementsAre(3, 1, 2, 0));
+    EXPECT_THAT(r.get_node_index(), ElementsAre(3, 1, 2, 0));
+}
+
+TEST(ReorderingTest, elements_stay_in_blocks)
+{
+    std::vector<double> x = { 3, 2, 1, 0 };
+    ElementBlock b1, b2;
+    b1.set_connectivity("BAR2", 2, 2, { 1, 2, 3, 4 });
+    b2.set_connectivity("BAR2", 1, 2, { 2, 3 });
+    Reordering r(ReorderingMethod::MORTON, x, {}, {}, { b1, b2 });
+    EXPECT_THAT(r.get_node_order(), ElementsAre(3, 2, 1, 0));
+    EXPECT_THAT(r.get_elem_order(), ElementsAre(1, 0, 2));
+    EXPECT_THAT(r.get_block_offsets(), ElementsAre(0, 2, 3));
+    EXPECT_THAT(r.permute_elemental(std::vector<double> { 10., 20., 30. }),
+                ElementsAre(20., 10., 30.));
+}
+
+TEST(ReorderingTest, invalid_input)
+{
+    ElementBlock b;
+    b.set_connectivity("BAR2", 1, 2, { 1, 5 });
+    EXPECT_THROW(Reordering(ReorderingMethod::RCM, { 0, 1 }, {}, {}, { b }), Exception);
+    EXPECT_THROW(Reordering(ReorderingMethod::RCM, { 0, 1 }, { 0 }, {}, {}), Exception);
+}
@@ -0,0 +1,104 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+TEST(SkinTest, quad4)
+{
+    ElementBlock eb;
+    eb.set_connectivity("QUAD4", 2, 4, { 1, 2, 5, 4, 2, 3, 6, 5 });
+
+    ElementBlock surface;
+    auto ss = skin({ eb }, surface);
+    EXPECT_THAT(ss.get_element_ids(), ElementsAre(1, 1, 1, 2, 2, 2));
+    EXPECT_THAT(ss.get_side_ids(), ElementsAre(1, 3, 4, 1, 2, 3));
+
+    EXPECT_EQ(surface.get_element_type(), "BAR2");
+    EXPECT_EQ(surface.get_num_elements(), 6);
+    EXPECT_EQ(surface.get_num_nodes_per_element(), 2);
+    EXPECT_THAT(surface.get_connectivity(), ElementsAre(1, 2, 5, 4, 4, 1, 2, 3, 3, 6, 6, 5));
+}
+
+TEST(SkinTest, multiple_blocks)
+{
+    ElementBlock eb1;
+    eb1.set_connectivity("QUAD4", 1, 4, { 1, 2, 5, 4 });
+    ElementBlock eb2;
+    eb2.set_connectivity("QUAD4", 1, 4, { 2, 3, 6, 5 });
+
+    auto ss = skin({ eb1, eb2 });
+    EXPECT_THAT(ss.get_element_ids(), ElementsAre(1, 1, 1, 2, 2, 2));
+    EXPECT_THAT(ss.get_side_ids(), ElementsAre(1, 3, 4, 1, 2, 3));
+}
+
+TEST(SkinTest, threads)
+{
+    // n x n grid of QUAD4 elements split into two blocks
+    const int n = 20;
+    auto node = [&](int i, int j) { return 1 + i + (n + 1) * j; };
+    std::vector<int> connect1, connect2;
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < n; i++) {
+            auto & connect = j < n / 2 ? connect1 : connect2;
+            connect.insert(connect.end(),
+                           { node(i, j), node(i + 1, j), node(i + 1, j + 1), node(i, j + 1) });
+        }
+    ElementBlock eb1;
+    eb1.set_connectivity("QUAD4", n * n / 2, 4, connect1);
+    ElementBlock eb2;
+    eb2.set_connectivity("QUAD4", n * n / 2, 4, connect2);
+
+    ElementBlock surface1, surface4;
+    auto ss1 = skin({ eb1, eb2 }, surface1);
+    auto ss4 = skin({ eb1, eb2 }, surface4, 4);
+    EXPECT_EQ(ss1.get_size(), 4 * n);
+    EXPECT_EQ(ss4.get_element_ids(), ss1.get_element_ids());
+    EXPECT_EQ(ss4.get_side_ids(), ss1.get_side_ids());
+    EXPECT_EQ(surface4.get_connectivity(), surface1.get_connectivity());
+}
+
+TEST(SkinTest, tet4)
+{
+    ElementBlock eb;
+    eb.set_connectivity("TETRA4", 2, 4, { 1, 2, 3, 4, 2, 3, 4, 5 });
+
+    ElementBlock surface;
+    auto ss = skin({ eb }, surface);
+    EXPECT_EQ(ss.get_size(), 6);
+    EXPECT_THAT(ss.get_element_ids(), ElementsAre(1, 1, 1, 2, 2, 2));
+    EXPECT_THAT(ss.get_side_ids(), ElementsAre(1, 3, 4, 1, 2, 3));
+    EXPECT_EQ(surface.get_element_type(), "TRI3");
+    EXPECT_EQ(surface.get_num_elements(), 6);
+}
+
+TEST(SkinTest, hex8)
+{
+    ElementBlock eb;
+    eb.set_connectivity("HEX8", 1, 8, { 1, 2, 3, 4, 5, 6, 7, 8 });
+
+    ElementBlock surface;
+    auto ss = skin({ eb }, surface);
+    EXPECT_THAT(ss.get_side_ids(), ElementsAre(1, 2, 3, 4, 5, 6));
+    EXPECT_EQ(surface.get_element_type(), "QUAD4");
+    EXPECT_THAT(surface.get_element_connectivity(4), ElementsAre(1, 4, 3, 2));
+}
+
+TEST(SkinTest, mixed_sides)
+{
+    ElementBlock eb;
+    eb.set_connectivity("WEDGE6", 1, 6, { 1, 2, 3, 4, 5, 6 });
+
+    auto ss = skin({ eb });
+    EXPECT_EQ(ss.get_size(), 5);
+
+    ElementBlock surface;
+    EXPECT_THROW(skin({ eb }, surface), Exception);
+}
+
+TEST(SkinTest, unsupported_type)
+{
+    ElementBlock eb;
+    eb.set_connectivity("NSIDED", 1, 3, { 1, 2, 3 });
+    EXPECT_THROW(skin({ eb }), Exception);
+}
@@ -0,0 +1,151 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+TEST(SpatialIndexTest, locate_2d)
+{
+    {
+        File f(std::string("spatial2d.e"), FileAccess::WRITE);
+        f.init("test", 2, 7, 3, 2, 0, 0);
+        f.write_coords({ 0, 1, 2, 0, 1, 2, 5 }, { 0, 0, 0, 1, 1, 1, -1 });
+        f.write_block(10, "TRI3", 2, { 1, 2, 4, 2, 5, 4 });
+        f.write_block(20, "QUAD4", 1, { 2, 3, 6, 5 });
+        f.close();
+    }
+
+    File g(std::string("spatial2d.e"), FileAccess::READ);
+    g.read_coords();
+    g.read_blocks();
+    SpatialIndex idx(g);
+    EXPECT_EQ(idx.get_dim(), 2);
+
+    auto locs = idx.locate(
+        { { 0.25, 0.25, 0. }, { 0.75, 0.75, 0. }, { 1.5, 0.5, 0. }, { 3., 3., 0. } });
+    ASSERT_EQ(locs.size(), 4);
+    EXPECT_EQ(locs[0].block_id, 10);
+    EXPECT_EQ(locs[0].block_idx, 0);
+    EXPECT_EQ(locs[0].elem_idx, 0);
+    EXPECT_NEAR(locs[0].xi[0], 0.25, 1e-12);
+    EXPECT_NEAR(locs[0].xi[1], 0.25, 1e-12);
+
+    EXPECT_EQ(locs[1].block_id, 10);
+    EXPECT_EQ(locs[1].elem_idx, 1);
+
+    EXPECT_EQ(locs[2].block_id, 20);
+    EXPECT_EQ(locs[2].block_idx, 1);
+    EXPECT_EQ(locs[2].elem_idx, 0);
+    EXPECT_NEAR(locs[2].xi[0], 0., 1e-12);
+    EXPECT_NEAR(locs[2].xi[1], 0., 1e-12);
+
+    EXPECT_EQ(locs[3].block_id, -1);
+    EXPECT_EQ(locs[3].elem_idx, -1);
+
+    auto nodes = idx.find_nearest_nodes({ { 0.1, 0.1, 0. }, { 1.9, 0.8, 0. }, { 10., -3., 0. } });
+    EXPECT_THAT(nodes, ElementsAre(1, 6, 7));
+}
+
+TEST(SpatialIndexTest, locate_3d)
+{
+    // 3 x 3 x 3 structured grid of HEX8 elements
+    const int n = 3;
+    std::vector<double> x, y, z;
+    for (int k = 0; k <= n; k++)
+        for (int j = 0; j <= n; j++)
+            for (int i = 0; i <= n; i++) {
+                x.push_back(i);
+                y.push_back(j);
+                z.push_back(k);
+            }
+    auto node = [&](int i, int j, int k) { return 1 + i + (n + 1) * (j + (n + 1) * k); };
+    std::vector<int> connect;
+    for (int k = 0; k < n; k++)
+        for (int j = 0; j < n; j++)
+            for (int i = 0; i < n; i++) {
+                connect.insert(connect.end(),
+                               { node(i, j, k),
+                                 node(i + 1, j, k),
+                                 node(i + 1, j + 1, k),
+                                 node(i, j + 1, k),
+                                 node(i, j, k + 1),
+                                 node(i + 1, j, k + 1),
+                                 node(i + 1, j + 1, k + 1),
+                                 node(i, j + 1, k + 1) });
+            }
+
+    {
+        File f(std::string("spatial3d.e"), FileAccess::WRITE);
+        f.init("test", 3, (int) x.size(), n * n * n, 1, 0, 0);
+        f.write_coords(x, y, z);
+        f.write_block(1, "HEX8", n * n * n, connect);
+        f.close();
+    }
+
+    File g(std::string("spatial3d.e"), FileAccess::READ);
+    g.read_coords();
+    g.read_blocks();
+    SpatialIndex idx(g);
+
+    auto locs = idx.locate({ { 2.5, 1.5, 0.25 }, { 0.5, 0.5, 3.5 } });
+    EXPECT_EQ(locs[0].block_id, 1);
+    EXPECT_EQ(locs[0].elem_idx, 2 + 3 * 1);
+    EXPECT_NEAR(locs[0].xi[0], 0., 1e-12);
+    EXPECT_NEAR(locs[0].xi[1], 0., 1e-12);
+    EXPECT_NEAR(locs[0].xi[2], -0.5, 1e-12);
+    EXPECT_EQ(locs[1].block_id, -1);
+
+    auto nodes = idx.find_nearest_nodes({ { 2.9, 0.1, 1.2 } });
+    EXPECT_THAT(nodes, ElementsAre(node(3, 0, 1)));
+}
+
+TEST(SpatialIndexTest, coords_not_read)
+{
+    File g(std::string(EXODUSIICPP_UNIT_TEST_ASSETS) + std::string("/square.e"), FileAccess::READ);
+    EXPECT_THROW(SpatialIndex idx(g), Exception);
+}
+
+TEST(SpatialIndexTest, threads)
+{
+    // n x n grid of QUAD4 elements, large enough to be split into subtrees
+    const int n = 100;
+    std::vector<double> x, y;
+    for (int j = 0; j <= n; j++)
+        for (int i = 0; i <= n; i++) {
+            x.push_back(i);
+            y.push_back(j + 0.1 * i);
+        }
+    auto node = [&](int i, int j) { return 1 + i + (n + 1) * j; };
+    std::vector<int> connect;
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < n; i++)
+            connect.insert(connect.end(),
+                           { node(i, j), node(i + 1, j), node(i + 1, j + 1), node(i, j + 1) });
+
+    {
+        File f(std::string("spatial_threads.e"), FileAccess::WRITE);
+        f.init("test", 2, (int) x.size(), n * n, 1, 0, 0);
+        f.write_coords(x, y);
+        f.write_block(1, "QUAD4", n * n, connect);
+        f.close();
+    }
+
+    File g(std::string("spatial_threads.e"), FileAccess::READ);
+    g.read_coords();
+    g.read_blocks();
+    SpatialIndex serial(g);
+    SpatialIndex threaded(g, 4);
+
+    std::vector<std::array<double, 3>> points;
+    for (int k = 0; k < 1000; k++)
+        points.push_back({ 0.0917 * k, 0.1031 * k + 0.5, 0. });
+    auto locs = serial.locate(points);
+    auto tlocs = threaded.locate(points, 3);
+    ASSERT_EQ(tlocs.size(), locs.size());
+    for (std::size_t k = 0; k < locs.size(); k++) {
+        EXPECT_EQ(tlocs[k].block_id, locs[k].block_id);
+        EXPECT_EQ(tlocs[k].elem_idx, locs[k].elem_idx);
+    }
+    EXPECT_EQ(locs[10].elem_idx, 0 + n * 1);
+    EXPECT_EQ(threaded.find_nearest_nodes(points, 3), serial.find_nearest_nodes(points));
+}
@@ -0,0 +1,91 @@
+#include "gmock/gmock.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+using namespace exodusIIcpp;
+using namespace testing;
+
+TEST(StepWriterTest, write)
+{
+    std::vector<double> u(4), e1(2), e2(1), g(2);
+    {
+        File f(std::string("step_writer.e"), FileAccess::WRITE);
+        f.init("test", 2, 4, 2, 2, 0, 0);
+        f.write_coords({ 0, 1, 0, 1 }, { 0, 0, 1, 1 });
+        f.write_block(1, "TRI3", 1, { 1, 2, 3 });
+        f.write_block(2, "TRI3", 1, { 2, 4, 3 });
+        f.write_nodal_var_names({ "u" });
+        f.write_elem_var_names({ "e1", "e2" });
+        f.write_global_var_names({ "g1", "g2" });
+
+        StepWriter writer(f);
+        writer.add_global_vars(g);
+        writer.add_nodal_var(1, u);
+        writer.add_elem_var(1, e1);
+        writer.add_elem_var(2, 2, e2);
+        EXPECT_THROW(writer.add_elem_var(2, 3, e2), Exception);
+
+        for (int step = 1; step <= 2; step++) {
+            std::fill(u.begin(), u.end(), step);
+            std::fill(e1.begin(), e1.end(), 10. * step);
+            e2[0] = 20. * step;
+            g[0] = 30. * step;
+            g[1] = 40. * step;
+            writer.write(step, 0.5 * step);
+        }
+
+        writer.clear();
+        writer.add_nodal_var(1, u);
+        writer.write(3, 1.5);
+    }
+
+    File f(std::string("step_writer.e"), FileAccess::READ);
+    f.read_times();
+    EXPECT_THAT(f.get_times(), ElementsAre(0.5, 1., 1.5));
+    EXPECT_THAT(f.get_nodal_variable_values(2, 1), ElementsAre(2., 2., 2., 2.));
+    EXPECT_THAT(f.get_elemental_variable_values(2, 1), ElementsAre(20., 20.));
+    auto e2_values = f.get_elemental_variable_values(2, 2);
+    EXPECT_TRUE(std::isnan(e2_values[0]));
+    EXPECT_EQ(e2_values[1], 40.);
+    EXPECT_THAT(f.get_global_variable_values(1), ElementsAre(30., 40.));
+    EXPECT_THAT(f.get_global_variable_values(2), ElementsAre(60., 80.));
+}
+
+TEST(StepWriterTest, truth_table)
+{
+    std::vector<double> e1(2), e2(2);
+    {
+        File f(std::string("step_writer_tab.e"), FileAccess::WRITE);
+        f.init("test", 2, 4, 2, 2, 0, 0);
+        f.write_coords({ 0, 1, 0, 1 }, { 0, 0, 1, 1 });
+        f.write_block(1, "TRI3", 1, { 1, 2, 3 });
+        f.write_block(2, "TRI3", 1, { 2, 4, 3 });
+        f.write_elem_var_names({ "e1", "e2" });
+        f.write_elem_var_truth_table({ 1, 0, 1, 1 });
+
+        StepWriter writer(f);
+        writer.add_elem_var(1, e1);
+        writer.add_elem_var(2, e2);
+        e1 = { 1., 2. };
+        e2 = { 3., 4. };
+        writer.write(1, 0.5);
+    }
+
+    {
+        File f(std::string("step_writer_tab.e"), FileAccess::APPEND);
+        StepWriter writer(f);
+        writer.add_elem_var(1, e1);
+        writer.add_elem_var(2, e2);
+        e1 = { 5., 6. };
+        e2 = { 7., 8. };
+        writer.write(2, 1.);
+    }
+
+    File f(std::string("step_writer_tab.e"), FileAccess::READ);
+    EXPECT_THAT(f.get_elemental_variable_values(1, 1), ElementsAre(1., 2.));
+    EXPECT_THAT(f.get_elemental_variable_values(2, 1), ElementsAre(5., 6.));
+    for (int step = 1; step <= 2; step++) {
+        auto vals = f.get_elemental_variable_values(step, 2);
+        EXPECT_TRUE(std::isnan(vals[0]));
+        EXPECT_EQ(vals[1], 4. * step);
+    }
+}
@@ -0,0 +1,20 @@
+#include "gtest/gtest.h"
+#include <mpi.h>
+
+int
+main(int argc, char ** argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleTest(&argc, argv);
+    // only the first rank reports, failures on the others still fail the run
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0)
+        delete ::testing::UnitTest::GetInstance()->listeners().Release(
+            ::testing::UnitTest::GetInstance()->listeners().default_result_printer());
+    int result = RUN_ALL_TESTS();
+    int max_result;
+    MPI_Allreduce(&result, &max_result, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return max_result;
+}
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "fmt/format.h"
+#include "common/error.h"
+
+// Reading and writing of NumPy `.npy` files (format version 1.0)
+//
+// Only little-endian `float64`, `int32` and `int64` arrays are supported, which covers the data
+// stored in ExodusII files.
+
+namespace npy {
+
+template <typename T>
+const char * descr();
+
+template <>
+inline const char *
+descr<double>()
+{
+    return "<f8";
+}
+
+template <>
+inline const char *
+descr<int32_t>()
+{
+    return "<i4";
+}
+
+template <>
+inline const char *
+descr<int64_t>()
+{
+    return "<i8";
+}
+
+} // namespace npy
+
+/// Writer for `.npy` files
+///
+/// The header is written when the file is created, values are then written sequentially or at
+/// a given position, so arrays can be written in chunks. Call `close` once all values are written,
+/// the destructor cannot report a failed flush.
+template <typename T>
+class NpyWriter {
+public:
+    /// Create a `.npy` file
+    ///
+    /// @param file_name File name
+    /// @param shape Shape of the array
+    /// @param fortran_order Store the array in column-major order
+    NpyWriter(const std::string & file_name,
+              const std::vector<int64_t> & shape,
+              bool fortran_order = false) :
+        file_name(file_name),
+        out(std::fopen(file_name.c_str(), "wb"))
+    {
+        if (this->out == nullptr)
+            error("Unable to create '{}'.", file_name);
+
+        std::string shp;
+        for (auto & n : shape)
+            shp += fmt::format("{}, ", n);
+        if (shape.size() > 1)
+            shp.resize(shp.size() - 2);
+        else if (shape.size() == 1)
+            shp.pop_back();
+        auto header = fmt::format("{{'descr': '{}', 'fortran_order': {}, 'shape': ({}), }}",
+                                  npy::descr<T>(),
+                                  fortran_order ? "True" : "False",
+                                  shp);
+        // magic (6) + version (2) + header length (2) + header, padded to a multiple of 64 bytes
+        // and terminated by a newline
+        auto total = (10 + header.size() + 1 + 63) / 64 * 64;
+        header.resize(total - 10 - 1, ' ');
+        header.push_back('\n');
+
+        const char magic[] = "\x93NUMPY\x01\x00";
+        uint16_t len = static_cast<uint16_t>(header.size());
+        unsigned char len_le[2] = { static_cast<unsigned char>(len & 0xff),
+                                    static_cast<unsigned char>(len >> 8) };
+        put(magic, 8);
+        put(len_le, 2);
+        put(header.data(), header.size());
+        this->data_ofst = static_cast<long>(total);
+    }
+
+    NpyWriter(const NpyWriter &) = delete;
+    NpyWriter & operator=(const NpyWriter &) = delete;
+
+    /// Close the file without reporting errors, call `close` to have them reported
+    ~NpyWriter()
+    {
+        if (this->out != nullptr)
+            std::fclose(this->out);
+    }
+
+    /// Close the file, flushing the buffered values
+    void
+    close()
+    {
+        auto res = std::fclose(this->out);
+        this->out = nullptr;
+        if (res != 0)
+            error("Failed to write '{}'.", this->file_name);
+    }
+
+    /// Write values after the previously written ones
+    void
+    write(const T * data, std::size_t n)
+    {
+        put(data, n * sizeof(T));
+    }
+
+    /// Write values starting at a (flat) index of the array
+    void
+    write_at(int64_t idx, const T * data, std::size_t n)
+    {
+        if (std::fseek(this->out, this->data_ofst + idx * (long) sizeof(T), SEEK_SET) != 0)
+            error("Failed to write '{}'.", this->file_name);
+        write(data, n);
+    }
+
+protected:
+    void
+    put(const void * data, std::size_t size)
+    {
+        if (size > 0 && std::fwrite(data, 1, size, this->out) != size)
+            error("Failed to write '{}'.", this->file_name);
+    }
+
+    std::string file_name;
+    std::FILE * out;
+    /// Position of the first value in the file
+    long data_ofst;
+};
+
+/// Memory-mapped `.npy` file
+///
+/// Values are paged in from disk as they are accessed, so arrays of any size can be read in
+/// chunks without loading them into memory.
+class NpyArray {
+public:
+    enum class Type { FLOAT64, INT32, INT64 };
+
+    explicit NpyArray(const std::string & file_name) : file_name(file_name)
+    {
+        int fd = ::open(file_name.c_str(), O_RDONLY);
+        if (fd < 0)
+            error("Unable to open '{}'.", file_name);
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size < 10) {
+            ::close(fd);
+            error("'{}' is not a .npy file.", file_name);
+        }
+        this->map_size = static_cast<std::size_t>(st.st_size);
+        void * addr = ::mmap(nullptr, this->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED)
+            error("Unable to map '{}'.", file_name);
+        this->map = static_cast<const char *>(addr);
+        ::madvise(addr, this->map_size, MADV_SEQUENTIAL);
+        parse_header();
+    }
+
+    NpyArray(const NpyArray &) = delete;
+    NpyArray & operator=(const NpyArray &) = delete;
+
+    ~NpyArray() { ::munmap(const_cast<char *>(this->map), this->map_size); }
+
+    /// Get the type of the values
+    Type
+    get_type() const
+    {
+        return this->type;
+    }
+
+    /// Get the shape of the array
+    const std::vector<int64_t> &
+    get_shape() const
+    {
+        return this->shape;
+    }
+
+    /// Check if the array is stored in column-major order
+    bool
+    is_fortran_order() const
+    {
+        return this->fortran_order;
+    }
+
+    /// Get the total number of values
+    int64_t
+    size() const
+    {
+        int64_t n = 1;
+        for (auto & s : this->shape)
+            n *= s;
+        return n;
+    }
+
+    /// Copy values starting at a (flat) index of the array, converting them to `U`
+    template <typename U>
+    void
+    copy(int64_t idx, std::size_t n, U * out) const
+    {
+        if (idx < 0 || idx + static_cast<int64_t>(n) > size())
+            error("Reading past the end of '{}'.", this->file_name);
+        switch (this->type) {
+        case Type::FLOAT64:
+            convert<double>(idx, n, out);
+            break;
+        case Type::INT32:
+            convert<int32_t>(idx, n, out);
+            break;
+        case Type::INT64:
+            convert<int64_t>(idx, n, out);
+            break;
+        }
+    }
+
+protected:
+    template <typename S, typename U>
+    void
+    convert(int64_t idx, std::size_t n, U * out) const
+    {
+        const char * src = this->data + idx * sizeof(S);
+        if (std::is_same<S, U>::value)
+            std::memcpy(out, src, n * sizeof(S));
+        else {
+            for (std::size_t i = 0; i < n; i++) {
+                S val;
+                std::memcpy(&val, src + i * sizeof(S), sizeof(S));
+                if constexpr (std::is_integral<U>::value)
+                    if (!(val >= std::numeric_limits<U>::min() &&
+                          val <= std::numeric_limits<U>::max()))
+                        error("'{}' has value {} that does not fit into a {}-bit integer.",
+                              this->file_name,
+                              val,
+                              8 * sizeof(U));
+                out[i] = static_cast<U>(val);
+            }
+        }
+    }
+
+    /// Get the value of a key from the header dictionary
+    std::string
+    header_value(const std::string & header, const char * key) const
+    {
+        auto pos = header.find(fmt::format("'{}':", key));
+        if (pos == std::string::npos)
+            error("'{}' has an invalid header.", this->file_name);
+        pos = header.find_first_not_of(' ', pos + std::strlen(key) + 3);
+        auto end = header[pos] == '(' ? header.find(')', pos) + 1 : header.find(',', pos);
+        return header.substr(pos, end - pos);
+    }
+
+    void
+    parse_header()
+    {
+        if (std::memcmp(this->map, "\x93NUMPY", 6) != 0)
+            error("'{}' is not a .npy file.", this->file_name);
+        auto major = static_cast<unsigned char>(this->map[6]);
+        std::size_t hdr_ofst = major == 1 ? 10 : 12;
+        std::size_t hdr_len = static_cast<unsigned char>(this->map[8]) |
+                              static_cast<unsigned char>(this->map[9]) << 8;
+        if (major > 1)
+            hdr_len |= static_cast<std::size_t>(static_cast<unsigned char>(this->map[10])) << 16 |
+                       static_cast<std::size_t>(static_cast<unsigned char>(this->map[11])) << 24;
+        if (hdr_ofst + hdr_len > this->map_size)
+            error("'{}' has an invalid header.", this->file_name);
+        std::string header(this->map + hdr_ofst, hdr_len);
+
+        auto descr = header_value(header, "descr");
+        if (descr == "'<f8'")
+            this->type = Type::FLOAT64;
+        else if (descr == "'<i4'")
+            this->type = Type::INT32;
+        else if (descr == "'<i8'")
+            this->type = Type::INT64;
+        else
+            error("'{}' has unsupported type {}.", this->file_name, descr);
+
+        this->fortran_order = header_value(header, "fortran_order") == "True";
+
+        auto shp = header_value(header, "shape");
+        for (std::size_t pos = 1; pos < shp.size();) {
+            auto end = shp.find_first_of(",)", pos);
+            auto item = shp.substr(pos, end - pos);
+            if (item.find_first_not_of(' ') != std::string::npos)
+                this->shape.push_back(std::stoll(item));
+            pos = end + 1;
+        }
+
+        this->data = this->map + hdr_ofst + hdr_len;
+        std::size_t val_size = this->type == Type::INT32 ? 4 : 8;
+        if (hdr_ofst + hdr_len + size() * val_size > this->map_size)
+            error("'{}' is truncated.", this->file_name);
+    }
+
+    std::string file_name;
+    const char * map = nullptr;
+    std::size_t map_size = 0;
+    /// First value of the array
+    const char * data = nullptr;
+    Type type = Type::FLOAT64;
+    bool fortran_order = false;
+    std::vector<int64_t> shape;
+};
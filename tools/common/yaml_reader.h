@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "yaml-cpp/eventhandler.h"
+#include "yaml-cpp/exceptions.h"
+#include "yaml-cpp/parser.h"
+
+/// Event-based reader for YAML documents made of maps, sequences and scalars
+///
+/// The parser reports values one by one together with their position in the document, so derived
+/// classes can process arbitrarily large documents without building the whole tree in memory.
+/// The position is kept as a stack of levels: for a map, the level holds the current key; for a
+/// sequence, it holds the index of the current item. Anchors, aliases and complex keys are not
+/// supported.
+class YamlReader : public YAML::EventHandler {
+public:
+    /// Parse the first document of a YAML stream
+    void
+    parse(std::istream & in)
+    {
+        this->levels.clear();
+        YAML::Parser parser(in);
+        parser.HandleNextDocument(*this);
+    }
+
+    void
+    OnDocumentStart(const YAML::Mark &) override
+    {
+    }
+
+    void
+    OnDocumentEnd() override
+    {
+    }
+
+    void
+    OnNull(const YAML::Mark & mark, YAML::anchor_t) override
+    {
+        if (is_key())
+            throw YAML::ParserException(mark, "null keys are not supported");
+        on_null();
+        value_done();
+    }
+
+    void
+    OnAlias(const YAML::Mark & mark, YAML::anchor_t) override
+    {
+        throw YAML::ParserException(mark, "aliases are not supported");
+    }
+
+    void
+    OnScalar(const YAML::Mark &,
+             const std::string &,
+             YAML::anchor_t,
+             const std::string & value) override
+    {
+        if (is_key()) {
+            auto & lvl = this->levels.back();
+            lvl.key = value;
+            lvl.expect_key = false;
+        }
+        else {
+            on_scalar(value);
+            value_done();
+        }
+    }
+
+    void
+    OnSequenceStart(const YAML::Mark & mark,
+                    const std::string &,
+                    YAML::anchor_t,
+                    YAML::EmitterStyle::value) override
+    {
+        begin(mark, false);
+    }
+
+    void
+    OnSequenceEnd() override
+    {
+        end();
+    }
+
+    void
+    OnMapStart(const YAML::Mark & mark,
+               const std::string &,
+               YAML::anchor_t,
+               YAML::EmitterStyle::value) override
+    {
+        begin(mark, true);
+    }
+
+    void
+    OnMapEnd() override
+    {
+        end();
+    }
+
+protected:
+    /// Called for every scalar value (map keys are not reported)
+    virtual void on_scalar(const std::string & value) = 0;
+
+    /// Called for every null value
+    virtual void
+    on_null()
+    {
+    }
+
+    /// Called when a map or a sequence begins, the new level is already on the stack
+    virtual void
+    on_begin()
+    {
+    }
+
+    /// Called when a map or a sequence ends, before its level is removed from the stack
+    virtual void
+    on_end()
+    {
+    }
+
+    /// Number of levels, i.e. the nesting depth of the current position
+    std::size_t
+    depth() const
+    {
+        return this->levels.size();
+    }
+
+    /// Check that a level is a map positioned at `name`
+    bool
+    key_is(std::size_t level, const char * name) const
+    {
+        return level < this->levels.size() && this->levels[level].is_map &&
+               this->levels[level].key == name;
+    }
+
+    /// Key of a map level
+    const std::string &
+    key(std::size_t level) const
+    {
+        return this->levels[level].key;
+    }
+
+    /// Index of the current item of a sequence level (number of items when the sequence ends)
+    int64_t
+    index(std::size_t level) const
+    {
+        return this->levels[level].index;
+    }
+
+    struct Level {
+        bool is_map;
+        bool expect_key;
+        std::string key;
+        int64_t index;
+    };
+
+    bool
+    is_key() const
+    {
+        return !this->levels.empty() && this->levels.back().expect_key;
+    }
+
+    void
+    begin(const YAML::Mark & mark, bool is_map)
+    {
+        if (is_key())
+            throw YAML::ParserException(mark, "complex keys are not supported");
+        this->levels.push_back({ is_map, is_map, std::string(), 0 });
+        on_begin();
+    }
+
+    void
+    end()
+    {
+        on_end();
+        this->levels.pop_back();
+        value_done();
+    }
+
+    void
+    value_done()
+    {
+        if (this->levels.empty())
+            return;
+        auto & lvl = this->levels.back();
+        if (lvl.is_map)
+            lvl.expect_key = true;
+        else
+            lvl.index++;
+    }
+
+    std::vector<Level> levels;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "fmt/format.h"
+#include "common/error.h"
+
+/// Buffered writer for block-style YAML documents
+///
+/// Output is formatted into an in-memory buffer that is flushed to the file once it grows past a
+/// fixed size, so memory use does not depend on the size of the document. Numbers are written in
+/// their shortest round-trip representation.
+class YamlWriter {
+public:
+    /// Create a file
+    ///
+    /// @param file_name File name
+    explicit YamlWriter(const std::string & file_name) :
+        file_name(file_name),
+        out(std::fopen(file_name.c_str(), "w"), &std::fclose)
+    {
+        if (this->out == nullptr)
+            error("Unable to open file '{}'.", file_name);
+    }
+
+    /// Close the file, flushing the buffered output and reporting errors
+    void
+    close()
+    {
+        flush();
+        auto res = std::fclose(this->out.release());
+        if (res != 0)
+            error("Failed to write '{}'.", this->file_name);
+    }
+
+    /// Write formatted text
+    template <typename... T>
+    void
+    write(fmt::format_string<T...> format, T &&... args)
+    {
+        fmt::format_to(std::back_inserter(this->buffer), format, std::forward<T>(args)...);
+        flush_if_full();
+    }
+
+    /// Write a key of a mapping, `<indent><key>:`
+    void
+    key(int indent, std::string_view name)
+    {
+        write("{:{}}{}:", "", indent, name);
+    }
+
+    /// Write a double-quoted string scalar (valid JSON string as well)
+    void
+    string(std::string_view str)
+    {
+        this->buffer.push_back('"');
+        for (auto ch : str) {
+            if (ch == '"' || ch == '\\') {
+                this->buffer.push_back('\\');
+                this->buffer.push_back(ch);
+            }
+            else if (static_cast<unsigned char>(ch) < 0x20)
+                fmt::format_to(std::back_inserter(this->buffer), "\\u{:04x}", (unsigned) ch);
+            else
+                this->buffer.push_back(ch);
+        }
+        this->buffer.push_back('"');
+        flush_if_full();
+    }
+
+    /// Write a flow sequence, `[a, b, c]`
+    template <typename T>
+    void
+    flow_seq(const T * data, std::size_t n)
+    {
+        this->buffer.push_back('[');
+        for (std::size_t i = 0; i < n; i++) {
+            if (i > 0) {
+                this->buffer.push_back(',');
+                this->buffer.push_back(' ');
+            }
+            fmt::format_to(std::back_inserter(this->buffer), "{}", data[i]);
+        }
+        this->buffer.push_back(']');
+        flush_if_full();
+    }
+
+    /// Write buffered output to the file
+    void
+    flush()
+    {
+        auto size = this->buffer.size();
+        if (size > 0 && std::fwrite(this->buffer.data(), 1, size, this->out.get()) != size)
+            error("Failed to write '{}'.", this->file_name);
+        this->buffer.clear();
+    }
+
+protected:
+    void
+    flush_if_full()
+    {
+        if (this->buffer.size() >= BUFFER_SIZE)
+            flush();
+    }
+
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+    std::string file_name;
+    /// Closed without reporting errors if `close` is not called
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> out;
+    fmt::memory_buffer buffer;
+};
@@ -0,0 +1,259 @@
+#include <cstdint>
+#include <filesystem>
+#include "cxxopts/cxxopts.hpp"
+#include "fmt/printf.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+#include "common/error.h"
+#include "common/npy.h"
+#include "common/yaml_writer.h"
+
+// The mesh is stored as a directory of `.npy` files described by `mesh.json`:
+//
+// - `coords.npy` - float64 (n_nodes, dim), column-major, i.e. x, y and z are contiguous
+// - `block-<id>.npy` - int32 (n_elems, n_nodes_per_elem), 1-based node IDs
+// - `side-set-<id>.npy` - int32 (n_sides, 2), 1-based (element ID, side number) pairs
+// - `node-set-<id>.npy` - int32 (n_nodes), 1-based node IDs
+// - `times.npy` - float64 (n_times)
+// - `nodal-var-<idx>.npy` - float64 (n_times, n_nodes), 1-based variable index
+// - `elem-var-<idx>.npy` - float64 (n_times, n_elems), NaN where the variable is not defined
+// - `global-vars.npy` - float64 (n_times, n_global_vars)
+
+namespace fs = std::filesystem;
+
+/// Number of nodes or elements read from the file at once
+static const int64_t CHUNK_SIZE = 65536;
+
+void
+write_string_list(YamlWriter & json, const std::vector<std::string> & strs)
+{
+    json.write("[");
+    for (std::size_t i = 0; i < strs.size(); i++) {
+        if (i > 0)
+            json.write(", ");
+        json.string(strs[i]);
+    }
+    json.write("]");
+}
+
+void
+write_coordinates(const fs::path & dir, exodusIIcpp::File & exo)
+{
+    int dim = exo.get_dim();
+    int64_t n_nodes = exo.get_num_nodes();
+    NpyWriter<double> npy((dir / "coords.npy").string(), { n_nodes, dim }, true);
+    std::vector<double> xyz[3];
+    for (int64_t start = 0; start < n_nodes; start += CHUNK_SIZE) {
+        auto count = std::min(CHUNK_SIZE, n_nodes - start);
+        exo.read_partial_coords(start, count, xyz[0], xyz[1], xyz[2]);
+        for (int d = 0; d < dim; d++)
+            npy.write_at(d * n_nodes + start, xyz[d].data(), count);
+    }
+    npy.close();
+}
+
+void
+write_element_blocks(YamlWriter & json, const fs::path & dir, exodusIIcpp::File & exo)
+{
+    json.write("  \"element-blocks\": [");
+    auto & ids = exo.get_element_block_ids();
+    std::vector<int> connect;
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        auto blk = exo.read_block_info(ids[i]);
+        int64_t n_elems = std::max(blk.get_num_elements(), 0);
+        int64_t n_nodes_per_elem = std::max(blk.get_num_nodes_per_element(), 0);
+
+        json.write("{}\n    {{\"id\": {}, \"name\": ", i > 0 ? "," : "", blk.get_id());
+        json.string(blk.get_name());
+        json.write(", \"element-type\": ");
+        json.string(blk.get_element_type());
+        json.write(", \"num-elements\": {}, \"num-nodes-per-element\": {}}}",
+                   n_elems,
+                   n_nodes_per_elem);
+
+        NpyWriter<int32_t> npy((dir / fmt::format("block-{}.npy", blk.get_id())).string(),
+                               { n_elems, n_nodes_per_elem });
+        for (int64_t start = 0; start < n_elems && n_nodes_per_elem > 0; start += CHUNK_SIZE) {
+            auto count = std::min(CHUNK_SIZE, n_elems - start);
+            exo.read_partial_connectivity(blk.get_id(), start, count, connect);
+            npy.write(connect.data(), connect.size());
+        }
+        npy.close();
+    }
+    json.write("{}],\n", ids.empty() ? "" : "\n  ");
+}
+
+void
+write_side_sets(YamlWriter & json, const fs::path & dir, exodusIIcpp::File & exo)
+{
+    json.write("  \"side-sets\": [");
+    auto ids = exo.read_side_set_ids();
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        auto ss = exo.read_side_set(ids[i]);
+        json.write("{}\n    {{\"id\": {}, \"name\": ", i > 0 ? "," : "", ids[i]);
+        json.string(ss.get_name());
+        json.write("}}");
+
+        auto & elem_ids = ss.get_element_ids();
+        auto & side_ids = ss.get_side_ids();
+        std::vector<int32_t> data(2 * elem_ids.size());
+        for (std::size_t j = 0; j < elem_ids.size(); j++) {
+            data[2 * j] = elem_ids[j];
+            data[2 * j + 1] = side_ids[j];
+        }
+        NpyWriter<int32_t> npy((dir / fmt::format("side-set-{}.npy", ids[i])).string(),
+                               { static_cast<int64_t>(elem_ids.size()), 2 });
+        npy.write(data.data(), data.size());
+        npy.close();
+    }
+    json.write("{}],\n", ids.empty() ? "" : "\n  ");
+}
+
+void
+write_node_sets(YamlWriter & json, const fs::path & dir, exodusIIcpp::File & exo)
+{
+    json.write("  \"node-sets\": [");
+    auto ids = exo.read_node_set_ids();
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        auto ns = exo.read_node_set(ids[i]);
+        json.write("{}\n    {{\"id\": {}, \"name\": ", i > 0 ? "," : "", ids[i]);
+        json.string(ns.get_name());
+        json.write("}}");
+
+        auto & node_ids = ns.get_node_ids();
+        NpyWriter<int32_t> npy((dir / fmt::format("node-set-{}.npy", ids[i])).string(),
+                               { static_cast<int64_t>(node_ids.size()) });
+        npy.write(node_ids.data(), node_ids.size());
+        npy.close();
+    }
+    json.write("{}],\n", ids.empty() ? "" : "\n  ");
+}
+
+void
+write_variables(YamlWriter & json, const fs::path & dir, exodusIIcpp::File & exo)
+{
+    exo.read_times();
+    auto & times = exo.get_times();
+    int64_t n_times = times.size();
+    {
+        NpyWriter<double> npy((dir / "times.npy").string(), { n_times });
+        npy.write(times.data(), times.size());
+        npy.close();
+    }
+
+    auto nodal_names = exo.get_nodal_variable_names();
+    int64_t n_nodes = exo.get_num_nodes();
+    for (std::size_t i = 0; i < nodal_names.size(); i++) {
+        int var_idx = static_cast<int>(i + 1);
+        NpyWriter<double> npy((dir / fmt::format("nodal-var-{}.npy", var_idx)).string(),
+                              { n_times, n_nodes });
+        for (int step = 1; step <= n_times; step++)
+            for (int64_t start = 0; start < n_nodes; start += CHUNK_SIZE) {
+                auto count = std::min(CHUNK_SIZE, n_nodes - start);
+                auto vals = exo.get_partial_nodal_variable_values(step, var_idx, start, count);
+                npy.write(vals.data(), vals.size());
+            }
+        npy.close();
+    }
+
+    auto elem_names = exo.get_elemental_variable_names();
+    int64_t n_elems = exo.get_num_elements();
+    for (std::size_t i = 0; i < elem_names.size(); i++) {
+        int var_idx = static_cast<int>(i + 1);
+        NpyWriter<double> npy((dir / fmt::format("elem-var-{}.npy", var_idx)).string(),
+                              { n_times, n_elems });
+        for (int step = 1; step <= n_times; step++) {
+            auto vals = exo.get_elemental_variable_values(step, var_idx);
+            npy.write(vals.data(), vals.size());
+        }
+        npy.close();
+    }
+
+    auto global_names = exo.get_global_variable_names();
+    if (!global_names.empty()) {
+        NpyWriter<double> npy((dir / "global-vars.npy").string(),
+                              { n_times, static_cast<int64_t>(global_names.size()) });
+        for (int step = 1; step <= n_times; step++) {
+            auto vals = exo.get_global_variable_values(step);
+            npy.write(vals.data(), vals.size());
+        }
+        npy.close();
+    }
+
+    json.write("  \"num-times\": {},\n", n_times);
+    json.write("  \"nodal-variables\": ");
+    write_string_list(json, nodal_names);
+    json.write(",\n  \"elemental-variables\": ");
+    write_string_list(json, elem_names);
+    json.write(",\n  \"global-variables\": ");
+    write_string_list(json, global_names);
+    json.write("\n");
+}
+
+void
+save_npy(const fs::path & dir, exodusIIcpp::File & exo)
+{
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec)
+        error("Unable to create directory '{}'.", dir.string());
+
+    YamlWriter json((dir / "mesh.json").string());
+    json.write("{{\n  \"title\": ");
+    json.string(exo.get_title());
+    json.write(",\n  \"dim\": {},\n  \"coord-names\": ", exo.get_dim());
+    exo.read_coord_names();
+    write_string_list(json, exo.get_coord_names());
+    json.write(",\n  \"num-nodes\": {},\n", exo.get_num_nodes());
+    write_coordinates(dir, exo);
+    write_element_blocks(json, dir, exo);
+    write_side_sets(json, dir, exo);
+    write_node_sets(json, dir, exo);
+    write_variables(json, dir, exo);
+    json.write("}}\n");
+    json.close();
+}
+
+void
+exo2npy(const std::string & exo_file_name, const std::string & npy_dir_name)
+{
+    try {
+        exodusIIcpp::File exo(exo_file_name, exodusIIcpp::FileAccess::READ);
+        if (exo.is_opened())
+            save_npy(npy_dir_name, exo);
+    }
+    catch (std::runtime_error & e) {
+        fmt::print("{}\n", e.what());
+    }
+}
+
+int
+main(int argc, char * argv[])
+{
+    cxxopts::Options opts("exo2npy");
+    opts.add_option("", "h", "help", "Show this help page", cxxopts::value<bool>(), "");
+    opts.add_option("",
+                    "",
+                    "exo-file",
+                    "The ExodusII file name",
+                    cxxopts::value<std::string>(),
+                    "");
+    opts.add_option("",
+                    "",
+                    "npy-dir",
+                    "The output directory for .npy files",
+                    cxxopts::value<std::string>(),
+                    "");
+
+    opts.positional_help("<exo-file> <npy-dir>");
+
+    opts.parse_positional({ "exo-file", "npy-dir" });
+    auto res = opts.parse(argc, argv);
+    if (res.count("help"))
+        fmt::print("{}", opts.help());
+    else if (res.count("exo-file") && res.count("npy-dir"))
+        exo2npy(res["exo-file"].as<std::string>(), res["npy-dir"].as<std::string>());
+    else
+        fmt::print("{}", opts.help());
+
+    return 0;
+}
@@ -1,9 +1,12 @@
 #include <cstdint>
 #include "cxxopts/cxxopts.hpp"
 #include "fmt/printf.h"
-#include "yaml-cpp/yaml.h"
 #include "exodusIIcpp/exodusIIcpp.h"
-#include <fstream>
+#include "common/error.h"
+#include "common/yaml_writer.h"
+
+/// Number of nodes or elements read from the file at once
+static const int64_t CHUNK_SIZE = 65536;
 
 exodusIIcpp::File
 load_exo(const std::string & file_name)
@@ -13,208 +16,182 @@ load_exo(const std::string & file_name)
 }
 
 void
-write_header(YAML::Emitter & yml, exodusIIcpp::File & exo)
+write_header(YamlWriter & yml, exodusIIcpp::File & exo)
 {
-    yml << YAML::Key << "title";
-    yml << YAML::Value << exo.get_title();
+    yml.key(2, "title");
+    yml.write(" ");
+    yml.string(exo.get_title());
+    yml.write("\n");
 
-    yml << YAML::Key << "dim";
-    yml << YAML::Value << exo.get_dim();
+    yml.key(2, "dim");
+    yml.write(" {}\n", exo.get_dim());
 }
 
 void
-write_coordinates(YAML::Emitter & yml, exodusIIcpp::File & exo)
+write_coordinates(YamlWriter & yml, exodusIIcpp::File & exo)
 {
     auto dim = exo.get_dim();
-    exo.read_coords();
-    if (dim == 1) {
-        const std::vector<double> & x = exo.get_x_coords();
-        yml << YAML::Key << "coords";
-        yml << YAML::Value;
-        yml << YAML::BeginSeq;
-        for (std::size_t i = 0; i < x.size(); i++) {
-            yml << YAML::Flow;
-            yml << YAML::BeginSeq;
-            yml << x[i];
-            yml << YAML::EndSeq;
-        }
-        yml << YAML::EndSeq;
-    }
-    else if (dim == 2) {
-        const std::vector<double> & x = exo.get_x_coords();
-        const std::vector<double> & y = exo.get_y_coords();
-        yml << YAML::Key << "coords";
-        yml << YAML::Value;
-        yml << YAML::BeginSeq;
-        for (std::size_t i = 0; i < x.size(); i++) {
-            yml << YAML::Flow;
-            yml << YAML::BeginSeq;
-            yml << x[i] << y[i];
-            yml << YAML::EndSeq;
-        }
-        yml << YAML::EndSeq;
+    int64_t n_nodes = exo.get_num_nodes();
+    yml.key(2, "coords");
+    if (n_nodes <= 0) {
+        yml.write(" []\n");
+        return;
     }
-    else if (dim == 3) {
-        const std::vector<double> & x = exo.get_x_coords();
-        const std::vector<double> & y = exo.get_y_coords();
-        const std::vector<double> & z = exo.get_z_coords();
-        yml << YAML::Key << "coords";
-        yml << YAML::Value;
-        yml << YAML::BeginSeq;
-        for (std::size_t i = 0; i < x.size(); i++) {
-            yml << YAML::Flow;
-            yml << YAML::BeginSeq;
-            yml << x[i] << y[i] << z[i];
-            yml << YAML::EndSeq;
+    yml.write("\n");
+
+    std::vector<double> x, y, z;
+    for (int64_t start = 0; start < n_nodes; start += CHUNK_SIZE) {
+        auto count = std::min(CHUNK_SIZE, n_nodes - start);
+        exo.read_partial_coords(start, count, x, y, z);
+        for (int64_t i = 0; i < count; i++) {
+            if (dim == 1)
+                yml.write("    - [{}]\n", x[i]);
+            else if (dim == 2)
+                yml.write("    - [{}, {}]\n", x[i], y[i]);
+            else
+                yml.write("    - [{}, {}, {}]\n", x[i], y[i], z[i]);
         }
-        yml << YAML::EndSeq;
     }
 }
 
 void
-write_coordinate_names(YAML::Emitter & yml, exodusIIcpp::File & exo)
+write_coordinate_names(YamlWriter & yml, exodusIIcpp::File & exo)
 {
     exo.read_coord_names();
-    auto coord_names = exo.get_coord_names();
-    yml << YAML::Key << "coord-names";
-    yml << YAML::Value;
-    yml << YAML::BeginSeq;
-    yml << YAML::Flow;
-    yml << coord_names;
-    yml << YAML::EndSeq;
+    auto & coord_names = exo.get_coord_names();
+    yml.key(2, "coord-names");
+    yml.write(" [");
+    for (std::size_t i = 0; i < coord_names.size(); i++) {
+        if (i > 0)
+            yml.write(", ");
+        yml.string(coord_names[i]);
+    }
+    yml.write("]\n");
 }
 
 void
-write_element_block(YAML::Emitter & yml, exodusIIcpp::File & exo)
+write_element_blocks(YamlWriter & yml, exodusIIcpp::File & exo)
 {
-    exo.read_blocks();
-    auto el_blocks = exo.get_element_blocks();
-    yml << YAML::Key << "element-blocks";
-    yml << YAML::Value;
-    yml << YAML::BeginSeq;
-    for (auto & blk : el_blocks) {
-        yml << YAML::BeginMap;
-
-        yml << YAML::Key << "id";
-        yml << YAML::Value << blk.get_id();
+    auto & blk_ids = exo.get_element_block_ids();
+    yml.key(2, "element-blocks");
+    if (blk_ids.empty()) {
+        yml.write(" []\n");
+        return;
+    }
+    yml.write("\n");
 
+    std::vector<int> connect;
+    for (auto id : blk_ids) {
+        auto blk = exo.read_block_info(id);
+        yml.write("    - id: {}\n", id);
         if (!blk.get_name().empty()) {
-            yml << YAML::Key << "name";
-            yml << YAML::Value << blk.get_name();
+            yml.key(6, "name");
+            yml.write(" ");
+            yml.string(blk.get_name());
+            yml.write("\n");
         }
-
-        yml << YAML::Key << "element-type";
-        yml << YAML::Value << blk.get_element_type();
-
-        yml << YAML::Key << "connectivity";
-        yml << YAML::Value;
-        yml << YAML::BeginSeq;
-        for (int e = 0; e < blk.get_num_elements(); e++) {
-            std::vector<int> connect = blk.get_element_connectivity(e);
-            yml << YAML::Flow;
-            yml << connect;
+        yml.key(6, "element-type");
+        yml.write(" ");
+        yml.string(blk.get_element_type());
+        yml.write("\n");
+
+        yml.key(6, "connectivity");
+        int64_t n_elems = std::max(blk.get_num_elements(), 0);
+        if (n_elems == 0) {
+            yml.write(" []\n");
+            continue;
+        }
+        yml.write("\n");
+        std::size_t n_nodes_per_elem = blk.get_num_nodes_per_element();
+        for (int64_t start = 0; start < n_elems; start += CHUNK_SIZE) {
+            auto count = std::min(CHUNK_SIZE, n_elems - start);
+            exo.read_partial_connectivity(id, start, count, connect);
+            for (int64_t e = 0; e < count; e++) {
+                yml.write("        - ");
+                yml.flow_seq(connect.data() + e * n_nodes_per_elem, n_nodes_per_elem);
+                yml.write("\n");
+            }
         }
-        yml << YAML::EndSeq;
-
-        yml << YAML::EndMap;
     }
-    yml << YAML::EndSeq;
 }
 
 void
-write_side_sets(YAML::Emitter & yml, exodusIIcpp::File & exo)
+write_side_sets(YamlWriter & yml, exodusIIcpp::File & exo)
 {
-    exo.read_side_sets();
-    auto side_sets = exo.get_side_sets();
-    yml << YAML::Key << "side-sets";
-    yml << YAML::Value;
-    yml << YAML::BeginSeq;
-    for (auto & ss : side_sets) {
-        yml << YAML::BeginMap;
-
-        yml << YAML::Key << "id";
-        yml << YAML::Value << ss.get_id();
+    auto ids = exo.read_side_set_ids();
+    yml.key(2, "side-sets");
+    if (ids.empty()) {
+        yml.write(" []\n");
+        return;
+    }
+    yml.write("\n");
 
+    for (auto id : ids) {
+        auto ss = exo.read_side_set(id);
+        yml.write("    - id: {}\n", id);
         if (!ss.get_name().empty()) {
-            yml << YAML::Key << "name";
-            yml << YAML::Value << ss.get_name();
+            yml.key(6, "name");
+            yml.write(" ");
+            yml.string(ss.get_name());
+            yml.write("\n");
         }
-
-        yml << YAML::Key << "data";
-        yml << YAML::Value;
-        yml << YAML::BeginSeq;
-        for (int i = 0; i < ss.get_size(); i++) {
-            yml << YAML::Flow;
-            std::vector<int> pair = { ss.get_element_id(i), ss.get_side_id(i) };
-            yml << pair;
+        yml.key(6, "data");
+        if (ss.get_size() == 0) {
+            yml.write(" []\n");
+            continue;
         }
-        yml << YAML::EndSeq;
-
-        yml << YAML::EndMap;
+        yml.write("\n");
+        auto & elems = ss.get_element_ids();
+        auto & sides = ss.get_side_ids();
+        for (int i = 0; i < ss.get_size(); i++)
+            yml.write("        - [{}, {}]\n", elems[i], sides[i]);
     }
-    yml << YAML::EndSeq;
 }
 
 void
-write_node_sets(YAML::Emitter & yml, exodusIIcpp::File & exo)
+write_node_sets(YamlWriter & yml, exodusIIcpp::File & exo)
 {
-    exo.read_node_sets();
-    auto node_sets = exo.get_node_sets();
-    yml << YAML::Key << "node-sets";
-    yml << YAML::Value;
-    yml << YAML::BeginSeq;
-    for (auto & ns : node_sets) {
-        yml << YAML::BeginMap;
-
-        yml << YAML::Key << "id";
-        yml << YAML::Value << ns.get_id();
+    auto ids = exo.read_node_set_ids();
+    yml.key(2, "node-sets");
+    if (ids.empty()) {
+        yml.write(" []\n");
+        return;
+    }
+    yml.write("\n");
 
+    for (auto id : ids) {
+        auto ns = exo.read_node_set(id);
+        yml.write("    - id: {}\n", id);
         if (!ns.get_name().empty()) {
-            yml << YAML::Key << "name";
-            yml << YAML::Value << ns.get_name();
+            yml.key(6, "name");
+            yml.write(" ");
+            yml.string(ns.get_name());
+            yml.write("\n");
         }
-
-        yml << YAML::Key << "data";
-        yml << YAML::Value;
-        yml << YAML::Flow;
-        yml << YAML::BeginSeq;
-        for (int i = 0; i < ns.get_size(); i++)
-            yml << ns.get_node_id(i);
-        yml << YAML::EndSeq;
-
-        yml << YAML::EndMap;
+        yml.key(6, "data");
+        yml.write(" ");
+        auto & node_ids = ns.get_node_ids();
+        yml.flow_seq(node_ids.data(), node_ids.size());
+        yml.write("\n");
     }
-    yml << YAML::EndSeq;
 }
 
 void
 save_yml(const std::string & file_name, exodusIIcpp::File & exo)
 {
-    std::ofstream out;
-    out.open(file_name);
-    YAML::Emitter yml(out);
-
-    yml << YAML::BeginMap;
-    yml << YAML::Key << "exodusII";
-    yml << YAML::Value;
-
-    exo.init();
-    yml << YAML::BeginMap;
+    YamlWriter yml(file_name);
+    yml.write("exodusII:\n");
     write_header(yml, exo);
     write_coordinate_names(yml, exo);
     write_coordinates(yml, exo);
-    write_element_block(yml, exo);
+    write_element_blocks(yml, exo);
     write_side_sets(yml, exo);
     write_node_sets(yml, exo);
-    yml << YAML::EndMap;
-
-    yml << YAML::EndMap;
-
-    out.close();
+    yml.close();
 }
 
 void
-yml2exo(const std::string & yml_file_name, const std::string & exo_file_name)
+exo2yml(const std::string & yml_file_name, const std::string & exo_file_name)
 {
     try {
         auto exo = load_exo(exo_file_name);
@@ -244,7 +221,7 @@ main(int argc, char * argv[])
     opts.parse_positional({ "exo-file", "yml-file" });
     auto res = opts.parse(argc, argv);
     if (res.count("yml-file") && res.count("exo-file"))
-        yml2exo(res["yml-file"].as<std::string>(), res["exo-file"].as<std::string>());
+        exo2yml(res["yml-file"].as<std::string>(), res["exo-file"].as<std::string>());
     else
         fmt::print("{}", opts.help());
 
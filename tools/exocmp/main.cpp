@@ -0,0 +1,538 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include "cxxopts/cxxopts.hpp"
+#include "fmt/printf.h"
+#include "fmt/ranges.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+
+// Compares two ExodusII files: the mesh (counts, coordinates, element blocks, node and side sets),
+// the time values and the nodal, elemental and global variables. Values `a` and `b` are equal if
+// `|a - b| <= max(abs_tol, rel_tol * max(|a|, |b|))`. Connectivity and sets must match exactly.
+//
+// Variables are matched by name and compared one time step at a time, nodal and elemental
+// variables in chunks. Several variables are compared at once by a pool of threads. The ExodusII
+// library is not thread-safe, so reads are serialized while the comparisons run in parallel.
+//
+// Exit status is 0 if the files are equal, 1 if they differ and 2 if they could not be compared.
+
+using exodusIIcpp::File;
+
+/// Number of nodes or elements compared at once
+static const int64_t CHUNK_SIZE = 65536;
+
+struct Options {
+    /// Absolute tolerance
+    double abs_tol;
+    /// Relative tolerance
+    double rel_tol;
+    /// Stop at the first difference
+    bool fail_fast;
+    /// Number of threads comparing variables
+    unsigned int n_jobs;
+};
+
+/// Result of comparing sequences of values
+struct Diff {
+    /// Largest absolute difference
+    double max_abs_diff = 0.;
+    /// Time step (1-based) of the largest difference, 0 for values that do not depend on time
+    int step = 0;
+    /// Index (0-based) of the largest difference, -1 if all values are identical
+    int64_t index = -1;
+    /// Number of values out of tolerance
+    int64_t n_fail = 0;
+};
+
+enum class VarKind { NODAL, ELEMENTAL, GLOBAL };
+
+/// Comparison of a variable present in both files
+struct VarTask {
+    VarKind kind;
+    std::string name;
+    /// Variable index (1-based) in the first file
+    int idx1;
+    /// Variable index (1-based) in the second file
+    int idx2;
+    Diff diff;
+    /// Set when the comparison ran to the end
+    bool done = false;
+};
+
+/// Bounds on the differences of two arrays
+struct Bounds {
+    /// Largest absolute difference
+    double max_abs_diff;
+    /// Largest amount by which a difference exceeds its tolerance, <= 0 if all are within it
+    double max_excess;
+    /// Set if a difference is NaN
+    bool has_nan;
+};
+
+/// Bound the differences of two arrays in a single pass
+///
+/// Plain loop that the compiler vectorizes; floating-point max reductions need the `simd` pragma
+/// (enabled by `-fopenmp-simd`) to be vectorized without `-ffast-math`.
+Bounds
+bound_diff(const double * a, const double * b, std::size_t n, const Options & opts)
+{
+    double mx = 0.;
+    double excess = -std::numeric_limits<double>::infinity();
+    int nan = 0;
+#pragma omp simd reduction(max : mx, excess) reduction(| : nan)
+    for (std::size_t i = 0; i < n; i++) {
+        double d = std::abs(a[i] - b[i]);
+        double scale = std::max(std::abs(a[i]), std::abs(b[i]));
+        double tol = std::max(opts.abs_tol, opts.rel_tol * scale);
+        nan |= d != d;
+        mx = d > mx ? d : mx;
+        excess = d - tol > excess ? d - tol : excess;
+    }
+    return { mx, excess, nan != 0 };
+}
+
+/// Compare a chunk of values
+///
+/// @param ofst Index of the first value of the chunk
+void
+compare(const double * a,
+        const double * b,
+        std::size_t n,
+        const Options & opts,
+        int step,
+        int64_t ofst,
+        Diff & diff)
+{
+    auto bnd = bound_diff(a, b, n, opts);
+    // nothing out of tolerance and no new maximum: skip the per-value pass
+    if (!bnd.has_nan && bnd.max_excess <= 0. &&
+        (bnd.max_abs_diff <= diff.max_abs_diff || bnd.max_abs_diff == 0.))
+        return;
+
+    for (std::size_t i = 0; i < n; i++) {
+        double d = std::abs(a[i] - b[i]);
+        bool a_nan = std::isnan(a[i]);
+        bool b_nan = std::isnan(b[i]);
+        if (a_nan || b_nan) {
+            if (a_nan == b_nan)
+                continue;
+            d = std::numeric_limits<double>::infinity();
+            diff.n_fail++;
+        }
+        else {
+            double scale = std::max(std::abs(a[i]), std::abs(b[i]));
+            if (d > std::max(opts.abs_tol, opts.rel_tol * scale))
+                diff.n_fail++;
+        }
+        if (d > diff.max_abs_diff) {
+            diff.max_abs_diff = d;
+            diff.step = step;
+            diff.index = ofst + static_cast<int64_t>(i);
+        }
+    }
+}
+
+/// Print the result of a comparison
+///
+/// @return `true` if all values are within tolerance
+bool
+report(const std::string & what, const Diff & diff, const char * entity)
+{
+    std::string loc;
+    if (diff.index >= 0) {
+        if (diff.step > 0)
+            loc = fmt::format(" at step {}", diff.step);
+        if (entity != nullptr)
+            loc += fmt::format("{} {} {}", loc.empty() ? " at" : ",", entity, diff.index + 1);
+    }
+    if (diff.n_fail > 0)
+        fmt::print("  {:<32} max abs diff {:.6e}{}  FAILED ({} values)\n",
+                   what,
+                   diff.max_abs_diff,
+                   loc,
+                   diff.n_fail);
+    else
+        fmt::print("  {:<32} max abs diff {:.6e}{}\n", what, diff.max_abs_diff, loc);
+    return diff.n_fail == 0;
+}
+
+template <typename T>
+bool
+check_equal(const char * what, const T & v1, const T & v2)
+{
+    if (v1 == v2)
+        return true;
+    fmt::print("  {} differ: {} vs. {}\n", what, v1, v2);
+    return false;
+}
+
+bool
+compare_counts(File & f1, File & f2)
+{
+    bool same = true;
+    same &= check_equal("dimensions", f1.get_dim(), f2.get_dim());
+    same &= check_equal("numbers of nodes", f1.get_num_nodes(), f2.get_num_nodes());
+    same &= check_equal("numbers of elements", f1.get_num_elements(), f2.get_num_elements());
+    same &= check_equal("numbers of element blocks",
+                        f1.get_num_element_blocks(),
+                        f2.get_num_element_blocks());
+    same &= check_equal("numbers of node sets", f1.get_num_node_sets(), f2.get_num_node_sets());
+    same &= check_equal("numbers of side sets", f1.get_num_side_sets(), f2.get_num_side_sets());
+    return same;
+}
+
+bool
+compare_coordinates(File & f1, File & f2, const Options & opts)
+{
+    int dim = f1.get_dim();
+    int64_t n_nodes = std::max(f1.get_num_nodes(), 0);
+    Diff diff[3];
+    std::vector<double> a[3], b[3];
+    for (int64_t start = 0; start < n_nodes; start += CHUNK_SIZE) {
+        auto count = std::min(CHUNK_SIZE, n_nodes - start);
+        f1.read_partial_coords(start, count, a[0], a[1], a[2]);
+        f2.read_partial_coords(start, count, b[0], b[1], b[2]);
+        for (int d = 0; d < dim; d++)
+            compare(a[d].data(), b[d].data(), count, opts, 0, start, diff[d]);
+    }
+
+    bool same = true;
+    const char * names[] = { "x", "y", "z" };
+    for (int d = 0; d < dim; d++)
+        same &= report(fmt::format("coordinate {}", names[d]), diff[d], "node");
+    return same;
+}
+
+bool
+compare_blocks(File & f1, File & f2)
+{
+    auto & ids = f1.get_element_block_ids();
+    if (!check_equal("element block IDs",
+                     fmt::format("{}", fmt::join(ids, ", ")),
+                     fmt::format("{}", fmt::join(f2.get_element_block_ids(), ", "))))
+        return false;
+
+    bool same = true;
+    std::vector<int> c1, c2;
+    for (auto & id : ids) {
+        auto b1 = f1.read_block_info(id);
+        auto b2 = f2.read_block_info(id);
+        auto what = fmt::format("block {}", id);
+        if (!check_equal(fmt::format("{} element types", what).c_str(),
+                         b1.get_element_type(),
+                         b2.get_element_type()) ||
+            !check_equal(fmt::format("{} numbers of elements", what).c_str(),
+                         b1.get_num_elements(),
+                         b2.get_num_elements()) ||
+            !check_equal(fmt::format("{} numbers of nodes per element", what).c_str(),
+                         b1.get_num_nodes_per_element(),
+                         b2.get_num_nodes_per_element())) {
+            same = false;
+            continue;
+        }
+
+        int64_t n_elems = b1.get_num_nodes_per_element() > 0 ? b1.get_num_elements() : 0;
+        for (int64_t start = 0; start < n_elems; start += CHUNK_SIZE) {
+            auto count = std::min(CHUNK_SIZE, n_elems - start);
+            f1.read_partial_connectivity(id, start, count, c1);
+            f2.read_partial_connectivity(id, start, count, c2);
+            auto mm = std::mismatch(c1.begin(), c1.end(), c2.begin());
+            if (mm.first != c1.end()) {
+                auto elem = start + (mm.first - c1.begin()) / b1.get_num_nodes_per_element();
+                fmt::print("  {} connectivity differs at element {}\n", what, elem + 1);
+                same = false;
+                break;
+            }
+        }
+    }
+    return same;
+}
+
+bool
+compare_sets(File & f1, File & f2)
+{
+    bool same = true;
+    auto ns_ids = f1.read_node_set_ids();
+    if (check_equal("node set IDs",
+                    fmt::format("{}", fmt::join(ns_ids, ", ")),
+                    fmt::format("{}", fmt::join(f2.read_node_set_ids(), ", ")))) {
+        for (auto & id : ns_ids)
+            if (f1.read_node_set(id).get_node_ids() != f2.read_node_set(id).get_node_ids()) {
+                fmt::print("  node set {} differs\n", id);
+                same = false;
+            }
+    }
+    else
+        same = false;
+
+    auto ss_ids = f1.read_side_set_ids();
+    if (check_equal("side set IDs",
+                    fmt::format("{}", fmt::join(ss_ids, ", ")),
+                    fmt::format("{}", fmt::join(f2.read_side_set_ids(), ", ")))) {
+        for (auto & id : ss_ids) {
+            auto s1 = f1.read_side_set(id);
+            auto s2 = f2.read_side_set(id);
+            if (s1.get_element_ids() != s2.get_element_ids() ||
+                s1.get_side_ids() != s2.get_side_ids()) {
+                fmt::print("  side set {} differs\n", id);
+                same = false;
+            }
+        }
+    }
+    else
+        same = false;
+    return same;
+}
+
+bool
+compare_mesh(File & f1, File & f2, const Options & opts)
+{
+    bool same = compare_coordinates(f1, f2, opts);
+    if (!same && opts.fail_fast)
+        return false;
+    same &= compare_blocks(f1, f2);
+    if (!same && opts.fail_fast)
+        return false;
+    same &= compare_sets(f1, f2);
+    return same;
+}
+
+bool
+compare_times(File & f1, File & f2, const Options & opts)
+{
+    fmt::print("Time steps:\n");
+    f1.read_times();
+    f2.read_times();
+    auto & t1 = f1.get_times();
+    auto & t2 = f2.get_times();
+    if (!check_equal("numbers of time steps", t1.size(), t2.size()))
+        return false;
+    Diff diff;
+    compare(t1.data(), t2.data(), t1.size(), opts, 0, 0, diff);
+    return report("time", diff, "step");
+}
+
+/// Match variables by name
+///
+/// @return `true` if both files have the same variables
+bool
+match_variables(VarKind kind,
+                const std::vector<std::string> & names1,
+                const std::vector<std::string> & names2,
+                std::vector<VarTask> & tasks)
+{
+    bool same = true;
+    for (std::size_t i = 0; i < names1.size(); i++) {
+        auto it = std::find(names2.begin(), names2.end(), names1[i]);
+        if (it != names2.end()) {
+            VarTask task;
+            task.kind = kind;
+            task.name = names1[i];
+            task.idx1 = static_cast<int>(i + 1);
+            task.idx2 = static_cast<int>(it - names2.begin()) + 1;
+            tasks.push_back(task);
+        }
+        else {
+            fmt::print("  variable '{}' is only in the first file\n", names1[i]);
+            same = false;
+        }
+    }
+    for (auto & name : names2)
+        if (std::find(names1.begin(), names1.end(), name) == names1.end()) {
+            fmt::print("  variable '{}' is only in the second file\n", name);
+            same = false;
+        }
+    return same;
+}
+
+/// Compare a variable
+///
+/// Reads are serialized by `io_mutex`, the comparison runs without holding it.
+void
+compare_variable(File & f1,
+                 File & f2,
+                 const Options & opts,
+                 std::mutex & io_mutex,
+                 const std::atomic<bool> & stop,
+                 VarTask & task)
+{
+    int n_steps = static_cast<int>(f1.get_times().size());
+    if (task.kind == VarKind::GLOBAL) {
+        std::vector<double> a, b;
+        if (n_steps > 0) {
+            std::lock_guard<std::mutex> lock(io_mutex);
+            a = f1.get_global_variable_values(task.idx1, 1, n_steps);
+            b = f2.get_global_variable_values(task.idx2, 1, n_steps);
+        }
+        compare(a.data(), b.data(), a.size(), opts, 0, 0, task.diff);
+        // the index of a global variable value is its time step
+        if (task.diff.index >= 0)
+            task.diff.step = static_cast<int>(task.diff.index + 1);
+        task.done = true;
+        return;
+    }
+
+    int64_t n = task.kind == VarKind::NODAL ? f1.get_num_nodes() : f1.get_num_elements();
+    std::vector<double> a, b;
+    for (int step = 1; step <= n_steps; step++) {
+        if (stop || (opts.fail_fast && task.diff.n_fail > 0))
+            return;
+        for (int64_t start = 0; start < n; start += CHUNK_SIZE) {
+            auto count = std::min(CHUNK_SIZE, n - start);
+            {
+                std::lock_guard<std::mutex> lock(io_mutex);
+                if (task.kind == VarKind::NODAL) {
+                    a = f1.get_partial_nodal_variable_values(step, task.idx1, start, count);
+                    b = f2.get_partial_nodal_variable_values(step, task.idx2, start, count);
+                }
+                else {
+                    a = f1.get_partial_elemental_variable_values(step, task.idx1, start, count);
+                    b = f2.get_partial_elemental_variable_values(step, task.idx2, start, count);
+                }
+            }
+            compare(a.data(), b.data(), count, opts, step, start, task.diff);
+        }
+    }
+    task.done = true;
+}
+
+bool
+compare_variables(File & f1, File & f2, const Options & opts)
+{
+    fmt::print("Variables:\n");
+    std::vector<VarTask> tasks;
+    bool same = match_variables(VarKind::NODAL,
+                                f1.get_nodal_variable_names(),
+                                f2.get_nodal_variable_names(),
+                                tasks);
+    same &= match_variables(VarKind::ELEMENTAL,
+                            f1.get_elemental_variable_names(),
+                            f2.get_elemental_variable_names(),
+                            tasks);
+    same &= match_variables(VarKind::GLOBAL,
+                            f1.get_global_variable_names(),
+                            f2.get_global_variable_names(),
+                            tasks);
+    if (!same && opts.fail_fast)
+        return false;
+
+    std::mutex io_mutex;
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> stop(false);
+    std::string error_msg;
+    auto worker = [&]() {
+        for (std::size_t t; !stop && (t = next++) < tasks.size();) {
+            try {
+                compare_variable(f1, f2, opts, io_mutex, stop, tasks[t]);
+            }
+            catch (std::exception & e) {
+                std::lock_guard<std::mutex> lock(io_mutex);
+                if (error_msg.empty())
+                    error_msg = e.what();
+                stop = true;
+            }
+            if (opts.fail_fast && tasks[t].diff.n_fail > 0)
+                stop = true;
+        }
+    };
+    auto n_threads = std::max(1u, std::min<unsigned int>(opts.n_jobs, tasks.size()));
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < n_threads; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto & th : threads)
+        th.join();
+    if (!error_msg.empty())
+        throw std::runtime_error(error_msg);
+
+    const char * kinds[] = { "nodal", "elemental", "global" };
+    const char * entities[] = { "node", "element", nullptr };
+    for (auto & task : tasks) {
+        if (!task.done && task.diff.n_fail == 0)
+            continue;
+        auto k = static_cast<int>(task.kind);
+        same &= report(fmt::format("{} '{}'", kinds[k], task.name), task.diff, entities[k]);
+    }
+    return same;
+}
+
+int
+exocmp(const std::string & file_name1, const std::string & file_name2, const Options & opts)
+{
+    try {
+        File f1(file_name1, exodusIIcpp::FileAccess::READ);
+        File f2(file_name2, exodusIIcpp::FileAccess::READ);
+
+        fmt::print("Mesh:\n");
+        if (!compare_counts(f1, f2)) {
+            fmt::print("Files are different.\n");
+            return 1;
+        }
+        bool same = compare_mesh(f1, f2, opts);
+        if (same || !opts.fail_fast)
+            same &= compare_times(f1, f2, opts);
+        if (same || (!opts.fail_fast && f1.get_times().size() == f2.get_times().size()))
+            same &= compare_variables(f1, f2, opts);
+
+        fmt::print("Files are {}.\n", same ? "the same" : "different");
+        return same ? 0 : 1;
+    }
+    catch (std::runtime_error & e) {
+        fmt::print(stderr, "[ERROR] {}\n", e.what());
+        return 2;
+    }
+}
+
+int
+main(int argc, char * argv[])
+{
+    cxxopts::Options opts("exocmp");
+    opts.add_option("", "h", "help", "Show this help page", cxxopts::value<bool>(), "");
+    opts.add_option("",
+                    "a",
+                    "abs-tol",
+                    "Absolute tolerance",
+                    cxxopts::value<double>()->default_value("1e-12"),
+                    "<tol>");
+    opts.add_option("",
+                    "r",
+                    "rel-tol",
+                    "Relative tolerance",
+                    cxxopts::value<double>()->default_value("1e-6"),
+                    "<tol>");
+    opts.add_option("",
+                    "f",
+                    "fail-fast",
+                    "Stop at the first difference",
+                    cxxopts::value<bool>(),
+                    "");
+    opts.add_option("",
+                    "j",
+                    "jobs",
+                    "Number of threads comparing variables (default: number of cores)",
+                    cxxopts::value<unsigned int>(),
+                    "<n>");
+    opts.add_option("", "", "file1", "The first ExodusII file", cxxopts::value<std::string>(), "");
+    opts.add_option("", "", "file2", "The second ExodusII file", cxxopts::value<std::string>(), "");
+
+    opts.positional_help("<file1> <file2>");
+
+    opts.parse_positional({ "file1", "file2" });
+    auto res = opts.parse(argc, argv);
+    if (res.count("help") || !res.count("file1") || !res.count("file2")) {
+        fmt::print("{}", opts.help());
+        return 0;
+    }
+
+    Options cmp_opts;
+    cmp_opts.abs_tol = res["abs-tol"].as<double>();
+    cmp_opts.rel_tol = res["rel-tol"].as<double>();
+    cmp_opts.fail_fast = res.count("fail-fast") > 0;
+    cmp_opts.n_jobs = res.count("jobs") ? res["jobs"].as<unsigned int>()
+                                        : std::max(1u, std::thread::hardware_concurrency());
+    return exocmp(res["file1"].as<std::string>(), res["file2"].as<std::string>(), cmp_opts);
+}
@@ -0,0 +1,61 @@
+#include <thread>
+#include "cxxopts/cxxopts.hpp"
+#include "fmt/printf.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+#include "common/error.h"
+
+// Decomposes a mesh into parts for parallel runs and writes one Nemesis file per part, named
+// `<input>.<n>.<part>`. Elements are partitioned by recursive coordinate bisection of their
+// centroids. Only the mesh is decomposed, time steps are not copied.
+
+void
+exodecomp(const std::string & input, int n_parts, unsigned int n_threads)
+{
+    try {
+        exodusIIcpp::File f(input, exodusIIcpp::FileAccess::READ);
+        f.read();
+        exodusIIcpp::Decomposition dd(f, n_parts);
+        dd.write(f, input, n_threads);
+
+        fmt::print("Wrote {} parts: '{}' ... '{}'.\n",
+                   n_parts,
+                   exodusIIcpp::Decomposition::get_part_file_path(input, n_parts, 0).string(),
+                   exodusIIcpp::Decomposition::get_part_file_path(input, n_parts, n_parts - 1)
+                       .string());
+    }
+    catch (std::runtime_error & e) {
+        error("{}", e.what());
+    }
+}
+
+int
+main(int argc, char * argv[])
+{
+    cxxopts::Options opts("exodecomp");
+    opts.add_option("", "h", "help", "Show this help page", cxxopts::value<bool>(), "");
+    opts.add_option("", "n", "parts", "Number of parts", cxxopts::value<int>(), "<n>");
+    opts.add_option("",
+                    "j",
+                    "jobs",
+                    "Number of threads building parts (default: number of cores)",
+                    cxxopts::value<unsigned int>(),
+                    "<n>");
+    opts.add_option("", "", "input", "The input ExodusII file", cxxopts::value<std::string>(), "");
+
+    opts.positional_help("<input>");
+
+    opts.parse_positional({ "input" });
+    auto res = opts.parse(argc, argv);
+    if (res.count("help") || !res.count("input") || !res.count("parts")) {
+        fmt::print("{}", opts.help());
+        return 0;
+    }
+
+    auto n_parts = res["parts"].as<int>();
+    if (n_parts < 1)
+        error("The number of parts must be a positive number, got {}.", n_parts);
+    auto n_jobs = res.count("jobs") ? res["jobs"].as<unsigned int>()
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    exodecomp(res["input"].as<std::string>(), n_parts, n_jobs);
+    return 0;
+}
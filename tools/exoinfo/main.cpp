@@ -0,0 +1,362 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+#include "cxxopts/cxxopts.hpp"
+#include "fmt/printf.h"
+#include "exodusII.h"
+#include "netcdf.h"
+#include "hdf5.h"
+#include "common/error.h"
+
+// Prints a summary of an ExodusII file using metadata queries only (`ex_get_init`, `ex_inquire`,
+// block and set parameters, netCDF variable inquiries), so it takes about the same time for any
+// file size. The only values read are the first and the last time.
+//
+// Storage of netCDF-4 files is queried from HDF5, for other formats the on-disk size of a
+// variable is its uncompressed size.
+
+namespace fs = std::filesystem;
+
+void
+check_ex(int err)
+{
+    if (err < 0)
+        error("{}", ex_strerror(err));
+}
+
+void
+check_nc(int err)
+{
+    if (err != NC_NOERR)
+        error("{}", nc_strerror(err));
+}
+
+/// Format a size in bytes for humans
+std::string
+human_size(uint64_t bytes)
+{
+    const char * units[] = { "B", "KiB", "MiB", "GiB", "TiB" };
+    double size = static_cast<double>(bytes);
+    int u = 0;
+    for (; size >= 1024. && u < 4; u++)
+        size /= 1024.;
+    if (u == 0)
+        return fmt::format("{} B", bytes);
+    return fmt::format("{:.1f} {}", size, units[u]);
+}
+
+std::vector<std::string>
+read_names(int exoid, ex_entity_type type, int n)
+{
+    std::vector<std::string> names;
+    if (n <= 0)
+        return names;
+    std::vector<char> buffer((std::size_t) n * (MAX_STR_LENGTH + 1), 0);
+    std::vector<char *> ptrs(n);
+    for (int i = 0; i < n; i++)
+        ptrs[i] = buffer.data() + (std::size_t) i * (MAX_STR_LENGTH + 1);
+    check_ex(ex_get_names(exoid, type, ptrs.data()));
+    for (auto & p : ptrs)
+        names.emplace_back(p);
+    return names;
+}
+
+std::vector<int>
+read_ids(int exoid, ex_entity_type type, int n)
+{
+    std::vector<int> ids(std::max(n, 0));
+    if (n > 0)
+        check_ex(ex_get_ids(exoid, type, ids.data()));
+    return ids;
+}
+
+void
+print_header(int exoid, const fs::path & path, float version)
+{
+    char title[MAX_LINE_LENGTH + 1];
+    std::memset(title, 0, sizeof(title));
+    int dim, n_nodes, n_elems, n_blks, n_node_sets, n_side_sets;
+    check_ex(ex_get_init(exoid,
+                         title,
+                         &dim,
+                         &n_nodes,
+                         &n_elems,
+                         &n_blks,
+                         &n_node_sets,
+                         &n_side_sets));
+
+    int format;
+    check_nc(nc_inq_format(exoid, &format));
+    const char * format_name = "unknown";
+    if (format == NC_FORMAT_CLASSIC)
+        format_name = "netCDF classic";
+    else if (format == NC_FORMAT_64BIT_OFFSET)
+        format_name = "netCDF 64-bit offset";
+    else if (format == NC_FORMAT_64BIT_DATA)
+        format_name = "netCDF 64-bit data";
+    else if (format == NC_FORMAT_NETCDF4)
+        format_name = "netCDF-4";
+    else if (format == NC_FORMAT_NETCDF4_CLASSIC)
+        format_name = "netCDF-4 classic model";
+
+    std::error_code ec;
+    auto file_size = fs::file_size(path, ec);
+
+    fmt::print("File:        {}\n", path.string());
+    fmt::print("Size:        {}\n", ec ? std::string("unknown") : human_size(file_size));
+    fmt::print("Format:      {}, ExodusII version {:.2f}, {}-byte floats\n",
+               format_name,
+               version,
+               ex_inquire_int(exoid, EX_INQ_DB_FLOAT_SIZE));
+    fmt::print("Title:       {}\n", title);
+    fmt::print("Dimension:   {}\n", dim);
+    fmt::print("Nodes:       {}\n", n_nodes);
+    fmt::print("Elements:    {}\n", n_elems);
+}
+
+void
+print_blocks(int exoid)
+{
+    int n_blks = ex_inquire_int(exoid, EX_INQ_ELEM_BLK);
+    fmt::print("\nElement blocks: {}\n", n_blks);
+    if (n_blks <= 0)
+        return;
+
+    auto ids = read_ids(exoid, EX_ELEM_BLOCK, n_blks);
+    auto names = read_names(exoid, EX_ELEM_BLOCK, n_blks);
+    fmt::print("  {:>10}  {:<32}  {:<10}  {:>12}  {:>13}\n",
+               "ID",
+               "Name",
+               "Type",
+               "Elements",
+               "Nodes/element");
+    for (int i = 0; i < n_blks; i++) {
+        char elem_type[MAX_STR_LENGTH + 1];
+        std::memset(elem_type, 0, sizeof(elem_type));
+        int n_elems_in_block, n_nodes_per_elem;
+        check_ex(ex_get_block(exoid,
+                              EX_ELEM_BLOCK,
+                              ids[i],
+                              elem_type,
+                              &n_elems_in_block,
+                              &n_nodes_per_elem,
+                              nullptr,
+                              nullptr,
+                              nullptr));
+        fmt::print("  {:>10}  {:<32}  {:<10}  {:>12}  {:>13}\n",
+                   ids[i],
+                   names[i],
+                   elem_type,
+                   n_elems_in_block,
+                   n_nodes_per_elem);
+    }
+}
+
+void
+print_sets(int exoid, ex_entity_type type, ex_inquiry inq, const char * title, const char * item)
+{
+    int n_sets = ex_inquire_int(exoid, inq);
+    fmt::print("\n{}: {}\n", title, n_sets);
+    if (n_sets <= 0)
+        return;
+
+    auto ids = read_ids(exoid, type, n_sets);
+    auto names = read_names(exoid, type, n_sets);
+    fmt::print("  {:>10}  {:<32}  {:>12}\n", "ID", "Name", item);
+    for (int i = 0; i < n_sets; i++) {
+        int n_entries, n_dfs;
+        check_ex(ex_get_set_param(exoid, type, ids[i], &n_entries, &n_dfs));
+        fmt::print("  {:>10}  {:<32}  {:>12}\n", ids[i], names[i], n_entries);
+    }
+}
+
+void
+print_variables(int exoid, ex_entity_type type, const char * title)
+{
+    int n_vars;
+    check_ex(ex_get_variable_param(exoid, type, &n_vars));
+    fmt::print("\n{}: {}\n", title, n_vars);
+    if (n_vars <= 0)
+        return;
+
+    std::vector<char> buffer((std::size_t) n_vars * (MAX_STR_LENGTH + 1), 0);
+    std::vector<char *> names(n_vars);
+    for (int i = 0; i < n_vars; i++)
+        names[i] = buffer.data() + (std::size_t) i * (MAX_STR_LENGTH + 1);
+    check_ex(ex_get_variable_names(exoid, type, n_vars, names.data()));
+    for (auto & name : names)
+        fmt::print("  {}\n", name);
+}
+
+void
+print_times(int exoid)
+{
+    int n_steps = ex_inquire_int(exoid, EX_INQ_TIME);
+    fmt::print("\nTime steps: {}\n", n_steps);
+    if (n_steps <= 0)
+        return;
+
+    double t_first, t_last;
+    check_ex(ex_get_time(exoid, 1, &t_first));
+    check_ex(ex_get_time(exoid, n_steps, &t_last));
+    fmt::print("  from {} to {}\n", t_first, t_last);
+}
+
+/// Print type, shape, sizes, chunking and compression of every netCDF variable
+void
+print_storage(int exoid, const fs::path & path)
+{
+    int format;
+    check_nc(nc_inq_format(exoid, &format));
+    bool is_hdf5 = format == NC_FORMAT_NETCDF4 || format == NC_FORMAT_NETCDF4_CLASSIC;
+
+    hid_t h5_file = -1;
+    if (is_hdf5) {
+        H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+        // the file is already open by netCDF, HDF5 requires the same close degree
+        hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+        H5Pset_fclose_degree(fapl, H5F_CLOSE_WEAK);
+        h5_file = H5Fopen(path.c_str(), H5F_ACC_RDONLY, fapl);
+        H5Pclose(fapl);
+    }
+
+    int n_dims, n_vars, n_atts, unlim_dim;
+    check_nc(nc_inq(exoid, &n_dims, &n_vars, &n_atts, &unlim_dim));
+    fmt::print("\nStorage ({} netCDF variables):\n", n_vars);
+    fmt::print("  {:<24}  {:<8}  {:<20}  {:>10}  {:>10}  {:<20}  {}\n",
+               "Variable",
+               "Type",
+               "Shape",
+               "Size",
+               "On disk",
+               "Chunks",
+               "Compression");
+    uint64_t total_size = 0;
+    uint64_t total_disk = 0;
+    bool disk_known = true;
+    for (int varid = 0; varid < n_vars; varid++) {
+        char name[NC_MAX_NAME + 1];
+        nc_type xtype;
+        int ndims;
+        int dimids[NC_MAX_VAR_DIMS];
+        check_nc(nc_inq_var(exoid, varid, name, &xtype, &ndims, dimids, nullptr));
+
+        char type_name[NC_MAX_NAME + 1];
+        std::size_t type_size;
+        check_nc(nc_inq_type(exoid, xtype, type_name, &type_size));
+
+        std::string shape;
+        uint64_t size = type_size;
+        for (int d = 0; d < ndims; d++) {
+            std::size_t len;
+            check_nc(nc_inq_dimlen(exoid, dimids[d], &len));
+            shape += fmt::format("{}{}", d > 0 ? " x " : "", len);
+            size *= len;
+        }
+        if (ndims == 0)
+            shape = "scalar";
+
+        uint64_t disk = size;
+        bool have_disk = true;
+        std::string chunks = "-";
+        std::string compression = "-";
+        if (is_hdf5) {
+            have_disk = false;
+            hid_t dset = h5_file >= 0 ? H5Dopen2(h5_file, name, H5P_DEFAULT) : -1;
+            if (dset >= 0) {
+                disk = H5Dget_storage_size(dset);
+                have_disk = true;
+                H5Dclose(dset);
+            }
+
+            int storage;
+            std::vector<std::size_t> chunk_sizes(std::max(ndims, 1));
+            check_nc(nc_inq_var_chunking(exoid, varid, &storage, chunk_sizes.data()));
+            if (storage == NC_CHUNKED) {
+                chunks.clear();
+                for (int d = 0; d < ndims; d++)
+                    chunks += fmt::format("{}{}", d > 0 ? " x " : "", chunk_sizes[d]);
+            }
+            else
+                chunks = storage == NC_CONTIGUOUS ? "contiguous" : "compact";
+
+            int shuffle, deflate, level;
+            check_nc(nc_inq_var_deflate(exoid, varid, &shuffle, &deflate, &level));
+            if (deflate)
+                compression = fmt::format("zlib {}{}", level, shuffle ? ", shuffle" : "");
+        }
+        total_size += size;
+        if (have_disk)
+            total_disk += disk;
+        disk_known &= have_disk;
+
+        fmt::print("  {:<24}  {:<8}  {:<20}  {:>10}  {:>10}  {:<20}  {}\n",
+                   name,
+                   type_name,
+                   shape,
+                   human_size(size),
+                   have_disk ? human_size(disk) : std::string("?"),
+                   chunks,
+                   compression);
+    }
+    fmt::print("  {:<24}  {:<8}  {:<20}  {:>10}  {:>10}\n",
+               "Total",
+               "",
+               "",
+               human_size(total_size),
+               disk_known ? human_size(total_disk) : std::string("?"));
+
+    if (h5_file >= 0)
+        H5Fclose(h5_file);
+}
+
+void
+exoinfo(const std::string & file_name)
+{
+    int cpu_word_size = sizeof(double);
+    int io_word_size = 0;
+    float version;
+    int exoid = ex_open(file_name.c_str(), EX_READ, &cpu_word_size, &io_word_size, &version);
+    if (exoid < 0)
+        error("Unable to open file '{}'.", file_name);
+
+    fs::path path(file_name);
+    print_header(exoid, path, version);
+    print_blocks(exoid);
+    print_sets(exoid, EX_NODE_SET, EX_INQ_NODE_SETS, "Node sets", "Nodes");
+    print_sets(exoid, EX_SIDE_SET, EX_INQ_SIDE_SETS, "Side sets", "Sides");
+    print_variables(exoid, EX_NODAL, "Nodal variables");
+    print_variables(exoid, EX_ELEM_BLOCK, "Elemental variables");
+    print_variables(exoid, EX_GLOBAL, "Global variables");
+    print_times(exoid);
+    print_storage(exoid, path);
+
+    ex_close(exoid);
+}
+
+int
+main(int argc, char * argv[])
+{
+    cxxopts::Options opts("exoinfo");
+    opts.add_option("", "h", "help", "Show this help page", cxxopts::value<bool>(), "");
+    opts.add_option("",
+                    "",
+                    "exo-file",
+                    "The ExodusII file name",
+                    cxxopts::value<std::string>(),
+                    "");
+
+    opts.positional_help("<exo-file>");
+
+    opts.parse_positional({ "exo-file" });
+    auto res = opts.parse(argc, argv);
+    if (res.count("help"))
+        fmt::print("{}", opts.help());
+    else if (res.count("exo-file"))
+        exoinfo(res["exo-file"].as<std::string>());
+    else
+        fmt::print("{}", opts.help());
+
+    return 0;
+}
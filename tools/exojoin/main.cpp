@@ -0,0 +1,82 @@
+#include <cstdint>
+#include <filesystem>
+#include "cxxopts/cxxopts.hpp"
+#include "fmt/printf.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+#include "common/error.h"
+
+// Joins results of restarted runs along time into one ExodusII file. The files must share a mesh,
+// which is checked by comparing mesh fingerprints. Where time ranges overlap, the later file takes
+// over from its first time on, so time steps recomputed after a restart replace the old ones. Time
+// steps are copied one variable and one time step at a time, unless `--buffer` allows reading
+// several time steps at once.
+
+namespace fs = std::filesystem;
+
+void
+exojoin(const std::vector<fs::path> & inputs,
+        const std::string & output,
+        const std::vector<std::string> & dropped_variables,
+        int64_t max_buffered_values)
+{
+    try {
+        exodusIIcpp::File dest(output, exodusIIcpp::FileAccess::WRITE);
+        exodusIIcpp::join_time_steps(inputs, dest, dropped_variables, max_buffered_values);
+        fmt::print("Joined {} files into '{}' with {} time steps.\n",
+                   inputs.size(),
+                   output,
+                   dest.get_num_times());
+        dest.close();
+    }
+    catch (std::runtime_error & e) {
+        error("{}", e.what());
+    }
+}
+
+int
+main(int argc, char * argv[])
+{
+    cxxopts::Options opts("exojoin");
+    opts.add_option("", "h", "help", "Show this help page", cxxopts::value<bool>(), "");
+    opts.add_option("",
+                    "o",
+                    "output",
+                    "The output ExodusII file",
+                    cxxopts::value<std::string>(),
+                    "<file>");
+    opts.add_option("",
+                    "d",
+                    "drop",
+                    "Comma-separated names of variables not to copy",
+                    cxxopts::value<std::vector<std::string>>(),
+                    "<names>");
+    opts.add_option("",
+                    "b",
+                    "buffer",
+                    "Read up to this many values of a variable at once, spanning several time "
+                    "steps, instead of one time step at a time",
+                    cxxopts::value<int64_t>()->default_value("0"),
+                    "<n>");
+    opts.add_option("",
+                    "",
+                    "inputs",
+                    "ExodusII files ordered as the runs were restarted",
+                    cxxopts::value<std::vector<std::string>>(),
+                    "");
+
+    opts.positional_help("<input> [<input> ...]");
+
+    opts.parse_positional({ "inputs" });
+    auto res = opts.parse(argc, argv);
+    if (res.count("help") || !res.count("inputs") || !res.count("output")) {
+        fmt::print("{}", opts.help());
+        return 0;
+    }
+
+    auto names = res["inputs"].as<std::vector<std::string>>();
+    std::vector<fs::path> inputs(names.begin(), names.end());
+    auto dropped = res.count("drop") ? res["drop"].as<std::vector<std::string>>()
+                                     : std::vector<std::string>();
+    exojoin(inputs, res["output"].as<std::string>(), dropped, res["buffer"].as<int64_t>());
+    return 0;
+}
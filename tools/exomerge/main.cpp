@@ -0,0 +1,95 @@
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include "cxxopts/cxxopts.hpp"
+#include "fmt/printf.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+#include "common/error.h"
+
+// Merges the per-part files of a decomposed run, e.g. `out.e.16.00` ... `out.e.16.15`, into one
+// ExodusII file. The numbering of the merged mesh is built from the node and element ID maps of
+// the parts. Time steps are streamed from all parts by a pool of threads. The reads are serialized,
+// the threads only overlap scattering values with reading. The elapsed time and throughput are
+// reported, so the effect of the number of threads can be measured.
+
+namespace fs = std::filesystem;
+
+void
+exomerge(const std::vector<fs::path> & inputs,
+         const std::string & output,
+         const std::vector<std::string> & dropped_variables,
+         unsigned int n_threads)
+{
+    try {
+        auto start = std::chrono::steady_clock::now();
+        exodusIIcpp::File dest(output, exodusIIcpp::FileAccess::WRITE);
+        exodusIIcpp::join_parts(inputs, dest, dropped_variables, n_threads);
+        auto n_times = dest.get_num_times();
+        dest.close();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        uintmax_t n_bytes = 0;
+        for (auto & path : inputs)
+            n_bytes += fs::file_size(path);
+        fmt::print("Merged {} parts into '{}' with {} time steps.\n",
+                   inputs.size(),
+                   output,
+                   n_times);
+        fmt::print("Time: {:.3f} s ({:.1f} MB/s read, {} threads)\n",
+                   elapsed.count(),
+                   n_bytes / 1.e6 / elapsed.count(),
+                   n_threads);
+    }
+    catch (std::runtime_error & e) {
+        error("{}", e.what());
+    }
+}
+
+int
+main(int argc, char * argv[])
+{
+    cxxopts::Options opts("exomerge");
+    opts.add_option("", "h", "help", "Show this help page", cxxopts::value<bool>(), "");
+    opts.add_option("",
+                    "o",
+                    "output",
+                    "The output ExodusII file",
+                    cxxopts::value<std::string>(),
+                    "<file>");
+    opts.add_option("",
+                    "d",
+                    "drop",
+                    "Comma-separated names of variables not to copy",
+                    cxxopts::value<std::vector<std::string>>(),
+                    "<names>");
+    opts.add_option("",
+                    "j",
+                    "jobs",
+                    "Number of threads scattering the values (default: number of cores)",
+                    cxxopts::value<unsigned int>(),
+                    "<n>");
+    opts.add_option("",
+                    "",
+                    "inputs",
+                    "Files with the parts of the run",
+                    cxxopts::value<std::vector<std::string>>(),
+                    "");
+
+    opts.positional_help("<part> [<part> ...]");
+
+    opts.parse_positional({ "inputs" });
+    auto res = opts.parse(argc, argv);
+    if (res.count("help") || !res.count("inputs") || !res.count("output")) {
+        fmt::print("{}", opts.help());
+        return 0;
+    }
+
+    auto names = res["inputs"].as<std::vector<std::string>>();
+    std::vector<fs::path> inputs(names.begin(), names.end());
+    auto dropped = res.count("drop") ? res["drop"].as<std::vector<std::string>>()
+                                     : std::vector<std::string>();
+    auto n_jobs = res.count("jobs") ? res["jobs"].as<unsigned int>()
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    exomerge(inputs, res["output"].as<std::string>(), dropped, n_jobs);
+    return 0;
+}
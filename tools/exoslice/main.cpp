@@ -0,0 +1,144 @@
+#include <cstdint>
+#include <limits>
+#include "cxxopts/cxxopts.hpp"
+#include "fmt/printf.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+#include "common/error.h"
+
+// Copies a subset of time steps of an ExodusII file into a new file, e.g. to keep every Nth step
+// or a time window of a long transient. The mesh is copied once, then the selected time steps are
+// streamed one variable at a time, so only a single time step of a single variable is held in
+// memory. With `--buffer`, runs of consecutive time steps are read in ranges of whole storage
+// chunks, which holds up to that many values instead. Variables can be dropped from the output.
+
+/// Select time steps to copy
+///
+/// @param times Time values of all time steps
+/// @param t_begin Start of the time window
+/// @param t_end End of the time window
+/// @param every Keep every `every`-th time step within the window, starting with the first one
+/// @param keep_last Keep the last time step within the window even if it is not on the stride
+/// @return Time steps (1-based) to copy
+std::vector<int>
+select_time_steps(const std::vector<double> & times,
+                  double t_begin,
+                  double t_end,
+                  int every,
+                  bool keep_last)
+{
+    std::vector<int> window;
+    for (std::size_t i = 0; i < times.size(); i++)
+        if (times[i] >= t_begin && times[i] <= t_end)
+            window.push_back(static_cast<int>(i + 1));
+
+    std::vector<int> steps;
+    for (std::size_t i = 0; i < window.size(); i += every)
+        steps.push_back(window[i]);
+    if (keep_last && !window.empty() && steps.back() != window.back())
+        steps.push_back(window.back());
+    return steps;
+}
+
+void
+exoslice(const std::string & input,
+         const std::string & output,
+         const std::vector<std::string> & dropped_variables,
+         double t_begin,
+         double t_end,
+         int every,
+         bool keep_last,
+         int64_t max_buffered_values)
+{
+    try {
+        exodusIIcpp::File src(input, exodusIIcpp::FileAccess::READ);
+        src.read_times();
+        auto steps = select_time_steps(src.get_times(), t_begin, t_end, every, keep_last);
+
+        exodusIIcpp::File dest(output, exodusIIcpp::FileAccess::WRITE);
+        exodusIIcpp::copy_mesh(src, dest);
+        exodusIIcpp::copy_time_steps(src, dest, steps, dropped_variables, max_buffered_values);
+        dest.close();
+
+        fmt::print("Copied {} of {} time steps into '{}'.\n",
+                   steps.size(),
+                   src.get_num_times(),
+                   output);
+    }
+    catch (std::runtime_error & e) {
+        error("{}", e.what());
+    }
+}
+
+int
+main(int argc, char * argv[])
+{
+    cxxopts::Options opts("exoslice");
+    opts.add_option("", "h", "help", "Show this help page", cxxopts::value<bool>(), "");
+    opts.add_option("",
+                    "n",
+                    "every",
+                    "Keep every n-th time step",
+                    cxxopts::value<int>()->default_value("1"),
+                    "<n>");
+    opts.add_option("",
+                    "",
+                    "begin",
+                    "Start of the time window",
+                    cxxopts::value<double>(),
+                    "<time>");
+    opts.add_option("", "", "end", "End of the time window", cxxopts::value<double>(), "<time>");
+    opts.add_option("",
+                    "l",
+                    "keep-last",
+                    "Keep the last time step of the window even if it is not on the stride",
+                    cxxopts::value<bool>(),
+                    "");
+    opts.add_option("",
+                    "d",
+                    "drop",
+                    "Comma-separated names of variables not to copy",
+                    cxxopts::value<std::vector<std::string>>(),
+                    "<names>");
+    opts.add_option("",
+                    "b",
+                    "buffer",
+                    "Read up to this many values of a variable at once, spanning several time "
+                    "steps, instead of one time step at a time",
+                    cxxopts::value<int64_t>()->default_value("0"),
+                    "<n>");
+    opts.add_option("", "", "input", "The input ExodusII file", cxxopts::value<std::string>(), "");
+    opts.add_option("",
+                    "",
+                    "output",
+                    "The output ExodusII file",
+                    cxxopts::value<std::string>(),
+                    "");
+
+    opts.positional_help("<input> <output>");
+
+    opts.parse_positional({ "input", "output" });
+    auto res = opts.parse(argc, argv);
+    if (res.count("help") || !res.count("input") || !res.count("output")) {
+        fmt::print("{}", opts.help());
+        return 0;
+    }
+
+    auto every = res["every"].as<int>();
+    if (every < 1)
+        error("The stride must be a positive number, got {}.", every);
+    auto t_begin =
+        res.count("begin") ? res["begin"].as<double>() : -std::numeric_limits<double>::infinity();
+    auto t_end =
+        res.count("end") ? res["end"].as<double>() : std::numeric_limits<double>::infinity();
+    auto dropped = res.count("drop") ? res["drop"].as<std::vector<std::string>>()
+                                     : std::vector<std::string>();
+    exoslice(res["input"].as<std::string>(),
+             res["output"].as<std::string>(),
+             dropped,
+             t_begin,
+             t_end,
+             every,
+             res.count("keep-last") > 0,
+             res["buffer"].as<int64_t>());
+    return 0;
+}
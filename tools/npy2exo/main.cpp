@@ -0,0 +1,356 @@
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include "cxxopts/cxxopts.hpp"
+#include "fmt/printf.h"
+#include "fmt/ranges.h"
+#include "yaml-cpp/yaml.h"
+#include "exodusIIcpp/exodusIIcpp.h"
+#include "common/error.h"
+#include "common/npy.h"
+
+// Reads a directory written by `exo2npy`, see `tools/exo2npy/main.cpp` for the layout. Arrays are
+// memory-mapped and written to the ExodusII file in chunks. Arrays can be stored in either row- or
+// column-major order and integer arrays can be 32- or 64-bit. Elemental variables are not defined
+// on element blocks where all their values are NaN.
+
+namespace fs = std::filesystem;
+
+/// Number of nodes or elements written to the file at once
+static const int64_t CHUNK_SIZE = 65536;
+
+void
+check_shape(const NpyArray & arr, const std::vector<int64_t> & shape, const fs::path & path)
+{
+    if (arr.get_shape() != shape)
+        error("'{}' has shape ({}), expected ({}).",
+              path.string(),
+              fmt::join(arr.get_shape(), ", "),
+              fmt::join(shape, ", "));
+}
+
+/// Read a range of rows of a 2D array in row-major order
+template <typename T>
+void
+read_rows(const NpyArray & arr, int64_t start, int64_t count, std::vector<T> & out)
+{
+    auto & shape = arr.get_shape();
+    int64_t n_rows = shape[0];
+    int64_t n_cols = shape.size() > 1 ? shape[1] : 1;
+    out.resize(count * n_cols);
+    if (!arr.is_fortran_order() || n_cols == 1)
+        arr.copy(start * n_cols, count * n_cols, out.data());
+    else {
+        std::vector<T> col(count);
+        for (int64_t c = 0; c < n_cols; c++) {
+            arr.copy(c * n_rows + start, count, col.data());
+            for (int64_t i = 0; i < count; i++)
+                out[i * n_cols + c] = col[i];
+        }
+    }
+}
+
+/// Get names of blocks or sets, if at least one of them has a name
+///
+/// Entities without a name are named by their ID.
+std::vector<std::string>
+get_names(const YAML::Node & entities)
+{
+    bool have_names = false;
+    std::vector<std::string> names;
+    for (const auto & ent : entities) {
+        auto name = ent["name"] ? ent["name"].as<std::string>() : std::string();
+        if (!name.empty()) {
+            have_names = true;
+            names.push_back(name);
+        }
+        else
+            names.push_back(ent["id"].as<std::string>());
+    }
+    if (!have_names)
+        names.clear();
+    return names;
+}
+
+void
+write_coordinates(exodusIIcpp::File & exo, const fs::path & dir, int dim, int64_t n_nodes)
+{
+    auto path = dir / "coords.npy";
+    NpyArray arr(path.string());
+    check_shape(arr, { n_nodes, dim }, path);
+    std::vector<double> xyz;
+    std::vector<double> comp[3];
+    for (int64_t start = 0; start < n_nodes; start += CHUNK_SIZE) {
+        auto count = std::min(CHUNK_SIZE, n_nodes - start);
+        read_rows(arr, start, count, xyz);
+        for (int d = 0; d < dim; d++) {
+            comp[d].resize(count);
+            for (int64_t i = 0; i < count; i++)
+                comp[d][i] = xyz[i * dim + d];
+        }
+        exo.write_partial_coords(start, comp[0], comp[1], comp[2]);
+    }
+}
+
+void
+write_element_blocks(exodusIIcpp::File & exo, const fs::path & dir, const YAML::Node & blocks)
+{
+    std::vector<int> connect;
+    for (const auto & blk : blocks) {
+        auto id = blk["id"].as<int64_t>();
+        auto n_elems = blk["num-elements"].as<int64_t>();
+        auto n_nodes_per_elem = blk["num-nodes-per-element"].as<int64_t>();
+        exo.write_block_info(id,
+                             blk["element-type"].as<std::string>().c_str(),
+                             n_elems,
+                             n_nodes_per_elem);
+
+        auto path = dir / fmt::format("block-{}.npy", id);
+        NpyArray arr(path.string());
+        check_shape(arr, { n_elems, n_nodes_per_elem }, path);
+        for (int64_t start = 0; start < n_elems && n_nodes_per_elem > 0; start += CHUNK_SIZE) {
+            auto count = std::min(CHUNK_SIZE, n_elems - start);
+            read_rows(arr, start, count, connect);
+            exo.write_partial_connectivity(id, start, count, connect);
+        }
+    }
+}
+
+void
+write_side_sets(exodusIIcpp::File & exo, const fs::path & dir, const YAML::Node & side_sets)
+{
+    std::vector<int> data, elem_ids, side_ids;
+    for (const auto & ss : side_sets) {
+        auto id = ss["id"].as<int64_t>();
+        auto path = dir / fmt::format("side-set-{}.npy", id);
+        NpyArray arr(path.string());
+        auto n = arr.get_shape().empty() ? 0 : arr.get_shape()[0];
+        check_shape(arr, { n, 2 }, path);
+        read_rows(arr, 0, n, data);
+        elem_ids.resize(n);
+        side_ids.resize(n);
+        for (int64_t i = 0; i < n; i++) {
+            elem_ids[i] = data[2 * i];
+            side_ids[i] = data[2 * i + 1];
+        }
+        exo.write_side_set(id, elem_ids, side_ids);
+    }
+}
+
+void
+write_node_sets(exodusIIcpp::File & exo, const fs::path & dir, const YAML::Node & node_sets)
+{
+    std::vector<int> node_ids;
+    for (const auto & ns : node_sets) {
+        auto id = ns["id"].as<int64_t>();
+        auto path = dir / fmt::format("node-set-{}.npy", id);
+        NpyArray arr(path.string());
+        if (arr.get_shape().size() != 1)
+            error("'{}' must be a 1D array.", path.string());
+        read_rows(arr, 0, arr.size(), node_ids);
+        exo.write_node_set(id, node_ids);
+    }
+}
+
+/// Check if an elemental variable is defined on an element block
+///
+/// `exo2npy` stores NaN where a variable is not defined, so the variable is defined on a block
+/// unless all its values there are NaN. Variables are defined on empty blocks.
+bool
+defined_on_block(const NpyArray & arr, int64_t n_times, int64_t first_elem, int64_t last_elem)
+{
+    if (first_elem == last_elem)
+        return true;
+    std::vector<double> vals(last_elem - first_elem);
+    for (int64_t step = 0; step < n_times; step++) {
+        if (arr.is_fortran_order()) {
+            for (int64_t e = first_elem; e < last_elem; e++)
+                arr.copy(e * n_times + step, 1, &vals[e - first_elem]);
+        }
+        else
+            arr.copy(step * arr.get_shape()[1] + first_elem, vals.size(), vals.data());
+        for (auto & v : vals)
+            if (!std::isnan(v))
+                return true;
+    }
+    return false;
+}
+
+void
+write_variables(exodusIIcpp::File & exo, const fs::path & dir, const YAML::Node & meta)
+{
+    auto n_times = meta["num-times"] ? meta["num-times"].as<int64_t>() : 0;
+    if (n_times == 0)
+        return;
+
+    {
+        auto path = dir / "times.npy";
+        NpyArray arr(path.string());
+        check_shape(arr, { n_times }, path);
+        std::vector<double> times;
+        read_rows(arr, 0, n_times, times);
+        for (int64_t i = 0; i < n_times; i++)
+            exo.write_time(static_cast<int>(i + 1), times[i]);
+    }
+
+    auto nodal_names = meta["nodal-variables"].as<std::vector<std::string>>();
+    auto elem_names = meta["elemental-variables"].as<std::vector<std::string>>();
+    auto global_names = meta["global-variables"].as<std::vector<std::string>>();
+    if (!nodal_names.empty())
+        exo.write_nodal_var_names(nodal_names);
+    if (!elem_names.empty())
+        exo.write_elem_var_names(elem_names);
+    if (!global_names.empty())
+        exo.write_global_var_names(global_names);
+
+    std::vector<double> vals;
+    int64_t n_nodes = exo.get_num_nodes();
+    for (std::size_t i = 0; i < nodal_names.size(); i++) {
+        int var_idx = static_cast<int>(i + 1);
+        auto path = dir / fmt::format("nodal-var-{}.npy", var_idx);
+        NpyArray arr(path.string());
+        check_shape(arr, { n_times, n_nodes }, path);
+        for (int step = 1; step <= n_times; step++) {
+            read_rows(arr, step - 1, 1, vals);
+            exo.write_nodal_var(step, var_idx, vals);
+        }
+    }
+
+    int64_t n_elems = exo.get_num_elements();
+    std::vector<int64_t> blk_elem_ofst = { 0 };
+    for (const auto & blk : meta["element-blocks"])
+        blk_elem_ofst.push_back(blk_elem_ofst.back() + blk["num-elements"].as<int64_t>());
+    auto & blk_ids = exo.get_element_block_ids();
+    auto n_blks = blk_ids.size();
+    std::vector<std::unique_ptr<NpyArray>> elem_arrs;
+    std::vector<int> truth_tab(n_blks * elem_names.size());
+    for (std::size_t i = 0; i < elem_names.size(); i++) {
+        auto path = dir / fmt::format("elem-var-{}.npy", i + 1);
+        elem_arrs.push_back(std::make_unique<NpyArray>(path.string()));
+        check_shape(*elem_arrs.back(), { n_times, n_elems }, path);
+        for (std::size_t b = 0; b < n_blks; b++)
+            truth_tab[b * elem_names.size() + i] = defined_on_block(*elem_arrs.back(),
+                                                                     n_times,
+                                                                     blk_elem_ofst[b],
+                                                                     blk_elem_ofst[b + 1]);
+    }
+    if (!elem_names.empty())
+        exo.write_elem_var_truth_table(truth_tab);
+
+    for (std::size_t i = 0; i < elem_names.size(); i++) {
+        int var_idx = static_cast<int>(i + 1);
+        for (int step = 1; step <= n_times; step++) {
+            read_rows(*elem_arrs[i], step - 1, 1, vals);
+            for (std::size_t b = 0; b < n_blks; b++)
+                if (truth_tab[b * elem_names.size() + i])
+                    exo.write_elem_var(
+                        step,
+                        var_idx,
+                        blk_ids[b],
+                        exodusIIcpp::Span<const double>(vals.data() + blk_elem_ofst[b],
+                                                        blk_elem_ofst[b + 1] - blk_elem_ofst[b]));
+        }
+    }
+
+    if (!global_names.empty()) {
+        auto path = dir / "global-vars.npy";
+        NpyArray arr(path.string());
+        check_shape(arr, { n_times, static_cast<int64_t>(global_names.size()) }, path);
+        for (int step = 1; step <= n_times; step++) {
+            read_rows(arr, step - 1, 1, vals);
+            exo.write_global_vars(step, vals);
+        }
+    }
+}
+
+void
+save_exo(const std::string & exo_file_name, const fs::path & dir, const YAML::Node & meta)
+{
+    exodusIIcpp::File exo(exo_file_name, exodusIIcpp::FileAccess::WRITE);
+
+    auto title = meta["title"] ? meta["title"].as<std::string>() : std::string();
+    auto dim = meta["dim"].as<int>();
+    auto n_nodes = meta["num-nodes"].as<int64_t>();
+    auto blocks = meta["element-blocks"];
+    auto side_sets = meta["side-sets"];
+    auto node_sets = meta["node-sets"];
+    int64_t n_elems = 0;
+    for (const auto & blk : blocks)
+        n_elems += blk["num-elements"].as<int64_t>();
+    exo.init(title.c_str(),
+             dim,
+             static_cast<int>(n_nodes),
+             static_cast<int>(n_elems),
+             static_cast<int>(blocks.size()),
+             static_cast<int>(node_sets.size()),
+             static_cast<int>(side_sets.size()));
+
+    if (meta["coord-names"])
+        exo.write_coord_names(meta["coord-names"].as<std::vector<std::string>>());
+    else
+        exo.write_coord_names();
+    auto block_names = get_names(blocks);
+    if (!block_names.empty())
+        exo.write_block_names(block_names);
+    auto ss_names = get_names(side_sets);
+    if (!ss_names.empty())
+        exo.write_side_set_names(ss_names);
+    auto ns_names = get_names(node_sets);
+    if (!ns_names.empty())
+        exo.write_node_set_names(ns_names);
+
+    write_coordinates(exo, dir, dim, n_nodes);
+    write_element_blocks(exo, dir, blocks);
+    write_side_sets(exo, dir, side_sets);
+    write_node_sets(exo, dir, node_sets);
+    write_variables(exo, dir, meta);
+}
+
+void
+npy2exo(const std::string & npy_dir_name, const std::string & exo_file_name)
+{
+    try {
+        fs::path dir(npy_dir_name);
+        auto meta = YAML::LoadFile((dir / "mesh.json").string());
+        save_exo(exo_file_name, dir, meta);
+    }
+    catch (YAML::Exception & e) {
+        fmt::print("{}\n", e.what());
+    }
+    catch (std::runtime_error & e) {
+        fmt::print("{}\n", e.what());
+    }
+}
+
+int
+main(int argc, char * argv[])
+{
+    cxxopts::Options opts("npy2exo");
+    opts.add_option("", "h", "help", "Show this help page", cxxopts::value<bool>(), "");
+    opts.add_option("",
+                    "",
+                    "npy-dir",
+                    "The directory with .npy files",
+                    cxxopts::value<std::string>(),
+                    "");
+    opts.add_option("",
+                    "",
+                    "exo-file",
+                    "The ExodusII file name",
+                    cxxopts::value<std::string>(),
+                    "");
+
+    opts.positional_help("<npy-dir> <exo-file>");
+
+    opts.parse_positional({ "npy-dir", "exo-file" });
+    auto res = opts.parse(argc, argv);
+    if (res.count("help"))
+        fmt::print("{}", opts.help());
+    else if (res.count("npy-dir") && res.count("exo-file"))
+        npy2exo(res["npy-dir"].as<std::string>(), res["exo-file"].as<std::string>());
+    else
+        fmt::print("{}", opts.help());
+
+    return 0;
+}
@@ -1,214 +1,409 @@
+#include <algorithm>
+#include <cerrno>
 #include <cstdint>
+#include <cstdlib>
+#include <fstream>
 #include "cxxopts/cxxopts.hpp"
 #include "fmt/printf.h"
-#include "yaml-cpp/yaml.h"
 #include "exodusIIcpp/exodusIIcpp.h"
 #include "common/error.h"
+#include "common/yaml_reader.h"
 
-YAML::Node
-load_yaml(const std::string & file_name)
+// The YAML file is read twice. The first pass only collects sizes and names, so the ExodusII file
+// can be initialized and its arrays sized up front. The second pass writes nodes and elements in
+// chunks as they are parsed, so memory use does not grow with the size of the mesh.
+
+/// Number of nodes or elements written to the file at once
+static const int64_t CHUNK_SIZE = 65536;
+
+// Levels of the document: 0 - root map, 1 - `exodusII` map, 2 - section (sequence of
+// coordinates, blocks or sets), 3 - item of the section, 4 and 5 - nested data
+
+struct BlockInfo {
+    int64_t id = 0;
+    bool has_id = false;
+    std::string name;
+    std::string element_type;
+    int64_t n_elems = 0;
+    int64_t n_nodes_per_elem = 0;
+};
+
+struct SetInfo {
+    int64_t id = 0;
+    bool has_id = false;
+    std::string name;
+    int64_t size = 0;
+};
+
+struct MeshInfo {
+    bool has_root = false;
+    std::string title;
+    int dim = 0;
+    std::vector<std::string> coord_names;
+    int64_t n_nodes = 0;
+    std::vector<BlockInfo> blocks;
+    std::vector<SetInfo> side_sets;
+    std::vector<SetInfo> node_sets;
+};
+
+int64_t
+to_int(const std::string & str)
 {
-    return YAML::LoadFile(file_name);
+    char * end = nullptr;
+    errno = 0;
+    auto val = std::strtoll(str.c_str(), &end, 10);
+    if (str.empty() || *end != '\0' || errno == ERANGE)
+        error("Invalid integer '{}'.", str);
+    return val;
 }
 
-void
-write_coordinate_names(exodusIIcpp::File & exo, int dim, const YAML::Node & yml_coords)
+double
+to_double(const std::string & str)
 {
-    if (yml_coords) {
-        auto names = yml_coords.as<std::vector<std::string>>();
-        exo.write_coord_names(names);
+    char * end = nullptr;
+    auto val = std::strtod(str.c_str(), &end);
+    if (str.empty() || *end != '\0')
+        error("Invalid number '{}'.", str);
+    return val;
+}
+
+/// First pass: collect sizes and names
+class MeshScanner : public YamlReader {
+public:
+    explicit MeshScanner(MeshInfo & info) : info(info) {}
+
+protected:
+    void
+    on_begin() override
+    {
+        if (depth() == 2 && key_is(0, "exodusII"))
+            this->info.has_root = true;
+        else if (depth() == 4 && key_is(0, "exodusII")) {
+            if (key_is(1, "element-blocks"))
+                this->info.blocks.emplace_back();
+            else if (key_is(1, "side-sets"))
+                this->info.side_sets.emplace_back();
+            else if (key_is(1, "node-sets"))
+                this->info.node_sets.emplace_back();
+        }
     }
-    else {
-        if (dim == 1)
-            exo.write_coord_names({ "x" });
-        else if (dim == 2)
-            exo.write_coord_names({ "x", "y" });
-        else if (dim == 3)
-            exo.write_coord_names({ "x", "y", "z" });
-        else
-            error("Unsupported dimension '{}'.", dim);
+
+    void
+    on_scalar(const std::string & value) override
+    {
+        if (!key_is(0, "exodusII"))
+            return;
+
+        if (depth() == 2) {
+            if (key_is(1, "title"))
+                this->info.title = value;
+            else if (key_is(1, "dim"))
+                this->info.dim = static_cast<int>(to_int(value));
+        }
+        else if (depth() == 3) {
+            if (key_is(1, "coord-names"))
+                this->info.coord_names.push_back(value);
+            else if (key_is(1, "coords"))
+                error("Coordinates of a node must be a sequence.");
+        }
+        else if (depth() == 4) {
+            if (key_is(1, "element-blocks")) {
+                auto & blk = this->info.blocks.back();
+                if (key_is(3, "id")) {
+                    blk.id = to_int(value);
+                    blk.has_id = true;
+                }
+                else if (key_is(3, "name"))
+                    blk.name = value;
+                else if (key_is(3, "element-type"))
+                    blk.element_type = value;
+            }
+            else if (key_is(1, "side-sets") || key_is(1, "node-sets")) {
+                auto & set = key_is(1, "side-sets") ? this->info.side_sets.back()
+                                                    : this->info.node_sets.back();
+                if (key_is(3, "id")) {
+                    set.id = to_int(value);
+                    set.has_id = true;
+                }
+                else if (key_is(3, "name"))
+                    set.name = value;
+            }
+        }
+        else if (depth() == 5 && key_is(1, "node-sets") && key_is(3, "data"))
+            this->info.node_sets.back().size++;
     }
-}
 
-void
-write_coordinates(exodusIIcpp::File & exo, int dim, const YAML::Node & yml_coords)
-{
-    std::vector<double> xyz[3];
-
-    for (auto & node : yml_coords) {
-        auto coord = node.as<std::vector<double>>();
-        if (coord.size() != static_cast<std::size_t>(dim))
-            error("Mismatch in mesh dimension and coordinate dimension.");
-        for (std::size_t i = 0; i < coord.size(); i++)
-            xyz[i].push_back(coord[i]);
+    void
+    on_end() override
+    {
+        if (!key_is(0, "exodusII"))
+            return;
+
+        if (depth() == 4) {
+            if (key_is(1, "coords"))
+                this->info.n_nodes++;
+            else if (key_is(1, "element-blocks") && !this->info.blocks.back().has_id)
+                error("Element block is missing 'id'.");
+            else if (key_is(1, "side-sets") && !this->info.side_sets.back().has_id)
+                error("Side set is missing 'id'.");
+            else if (key_is(1, "node-sets") && !this->info.node_sets.back().has_id)
+                error("Node set is missing 'id'.");
+        }
+        else if (depth() == 6) {
+            if (key_is(1, "element-blocks") && key_is(3, "connectivity")) {
+                auto & blk = this->info.blocks.back();
+                if (blk.n_elems == 0)
+                    blk.n_nodes_per_elem = index(5);
+                blk.n_elems++;
+            }
+            else if (key_is(1, "side-sets") && key_is(3, "data"))
+                this->info.side_sets.back().size++;
+        }
     }
 
-    if (dim == 1)
-        exo.write_coords(xyz[0]);
-    else if (dim == 2)
-        exo.write_coords(xyz[0], xyz[1]);
-    else if (dim == 3)
-        exo.write_coords(xyz[0], xyz[1], xyz[2]);
-}
+    MeshInfo & info;
+};
 
-void
-write_block_names(exodusIIcpp::File & exo, const YAML::Node & yml)
-{
-    bool have_names = false;
-    std::vector<std::string> block_names;
-    for (auto & n : yml) {
-        if (n["name"]) {
-            auto name = n["name"].as<std::string>();
-            have_names = true;
-            block_names.push_back(name);
+/// Second pass: write coordinates, connectivity and sets
+class MeshWriter : public YamlReader {
+public:
+    MeshWriter(const MeshInfo & info, exodusIIcpp::File & exo) : info(info), exo(exo) {}
+
+protected:
+    void
+    on_begin() override
+    {
+        if (depth() != 4 || !key_is(0, "exodusII"))
+            return;
+
+        if (key_is(1, "coords") && this->x.empty()) {
+            auto n = std::min(CHUNK_SIZE, this->info.n_nodes);
+            this->x.reserve(n);
+            if (this->info.dim >= 2)
+                this->y.reserve(n);
+            if (this->info.dim >= 3)
+                this->z.reserve(n);
+        }
+        else if (key_is(1, "element-blocks")) {
+            auto & blk = this->info.blocks[index(2)];
+            this->exo.write_block_info(blk.id,
+                                       blk.element_type.c_str(),
+                                       blk.n_elems,
+                                       blk.n_nodes_per_elem);
+            this->elem_ofst = 0;
+            this->connect.clear();
+            this->connect.reserve(std::min(CHUNK_SIZE, blk.n_elems) * blk.n_nodes_per_elem);
         }
-        else {
-            std::string name = fmt::format("{}", n["id"].as<int>());
-            block_names.push_back(name);
+        else if (key_is(1, "side-sets")) {
+            auto n = this->info.side_sets[index(2)].size;
+            this->elem_list.clear();
+            this->elem_list.reserve(n);
+            this->side_list.clear();
+            this->side_list.reserve(n);
+        }
+        else if (key_is(1, "node-sets")) {
+            this->node_list.clear();
+            this->node_list.reserve(this->info.node_sets[index(2)].size);
         }
     }
-    if (have_names)
-        exo.write_block_names(block_names);
-}
 
-void
-write_element_blocks(exodusIIcpp::File & exo, const YAML::Node & yml)
-{
-    for (auto & blk : yml) {
-        int64_t id = blk["id"].as<int>();
-        auto element_type = blk["element-type"].as<std::string>();
-        int64_t n_elems_in_block = 0;
-        std::vector<int> connect;
-        for (auto & m : blk["connectivity"]) {
-            auto elem = m.as<std::vector<int>>();
-            // TODO: check that number of nodes matches the `element-type`
-            n_elems_in_block++;
-            connect.insert(connect.end(), elem.begin(), elem.end());
-        }
-        exo.write_block(id, element_type.c_str(), n_elems_in_block, connect);
+    void
+    on_scalar(const std::string & value) override
+    {
+        if (!key_is(0, "exodusII"))
+            return;
+
+        if (depth() == 4 && key_is(1, "coords")) {
+            auto comp = index(3);
+            if (comp >= this->info.dim)
+                error("Mismatch in mesh dimension and coordinate dimension.");
+            auto val = to_double(value);
+            if (comp == 0)
+                this->x.push_back(val);
+            else if (comp == 1)
+                this->y.push_back(val);
+            else
+                this->z.push_back(val);
+        }
+        else if (depth() == 6 && key_is(1, "element-blocks") && key_is(3, "connectivity"))
+            this->connect.push_back(static_cast<int>(to_int(value)));
+        else if (depth() == 6 && key_is(1, "side-sets") && key_is(3, "data")) {
+            if (index(5) == 0)
+                this->elem_list.push_back(static_cast<int>(to_int(value)));
+            else if (index(5) == 1)
+                this->side_list.push_back(static_cast<int>(to_int(value)));
+        }
+        else if (depth() == 5 && key_is(1, "node-sets") && key_is(3, "data"))
+            this->node_list.push_back(static_cast<int>(to_int(value)));
     }
-}
 
-void
-write_side_set_names(exodusIIcpp::File & exo, const YAML::Node & yml)
-{
-    bool have_names = false;
-    std::vector<std::string> ss_names;
-    for (auto & n : yml) {
-        if (n["name"]) {
-            auto name = n["name"].as<std::string>();
-            have_names = true;
-            ss_names.push_back(name);
+    void
+    on_end() override
+    {
+        if (!key_is(0, "exodusII"))
+            return;
+
+        if (depth() == 3 && key_is(1, "coords"))
+            flush_coords();
+        else if (depth() == 4 && key_is(1, "coords")) {
+            if (index(3) != this->info.dim)
+                error("Mismatch in mesh dimension and coordinate dimension.");
+            if (static_cast<int64_t>(this->x.size()) >= CHUNK_SIZE)
+                flush_coords();
+        }
+        else if (depth() == 4 && key_is(1, "element-blocks"))
+            flush_connectivity();
+        else if (depth() == 6 && key_is(1, "element-blocks") && key_is(3, "connectivity")) {
+            auto & blk = this->info.blocks[index(2)];
+            if (index(5) != blk.n_nodes_per_elem)
+                error("Element block {} has elements with different number of nodes.", blk.id);
+            if (static_cast<int64_t>(this->connect.size()) >= CHUNK_SIZE * blk.n_nodes_per_elem)
+                flush_connectivity();
         }
-        else {
-            std::string name = fmt::format("{}", n["id"].as<int>());
-            ss_names.push_back(name);
+        else if (depth() == 6 && key_is(1, "side-sets") && key_is(3, "data")) {
+            if (index(5) != 2)
+                error("Side set {} has an entry that is not an (element, side) pair.",
+                      this->info.side_sets[index(2)].id);
         }
+        else if (depth() == 4 && key_is(1, "side-sets"))
+            this->exo.write_side_set(this->info.side_sets[index(2)].id,
+                                     this->elem_list,
+                                     this->side_list);
+        else if (depth() == 4 && key_is(1, "node-sets"))
+            this->exo.write_node_set(this->info.node_sets[index(2)].id, this->node_list);
     }
-    if (have_names)
-        exo.write_side_set_names(ss_names);
-}
+
+    void
+    flush_coords()
+    {
+        this->exo.write_partial_coords(this->node_ofst, this->x, this->y, this->z);
+        this->node_ofst += this->x.size();
+        this->x.clear();
+        this->y.clear();
+        this->z.clear();
+    }
+
+    void
+    flush_connectivity()
+    {
+        auto & blk = this->info.blocks[index(2)];
+        if (blk.n_nodes_per_elem == 0)
+            return;
+        int64_t count = this->connect.size() / blk.n_nodes_per_elem;
+        this->exo.write_partial_connectivity(blk.id, this->elem_ofst, count, this->connect);
+        this->elem_ofst += count;
+        this->connect.clear();
+    }
+
+    const MeshInfo & info;
+    exodusIIcpp::File & exo;
+    /// Index of the first node in the coordinate buffers
+    int64_t node_ofst = 0;
+    std::vector<double> x, y, z;
+    /// Index (within the block) of the first element in the connectivity buffer
+    int64_t elem_ofst = 0;
+    std::vector<int> connect;
+    std::vector<int> elem_list, side_list;
+    std::vector<int> node_list;
+};
 
 void
-write_side_sets(exodusIIcpp::File & exo, const YAML::Node & yml)
+open_yaml(std::ifstream & in, const std::string & file_name)
 {
-    for (auto & ss : yml) {
-        int64_t id = ss["id"].as<int>();
-        auto name = ss["name"].as<std::string>();
-        std::vector<int> elem_list;
-        std::vector<int> side_list;
-        for (auto & m : ss["data"]) {
-            auto arr = m.as<std::vector<int>>();
-            elem_list.push_back(arr[0]);
-            side_list.push_back(arr[1]);
-        }
-        exo.write_side_set(id, elem_list, side_list);
-    }
+    in.open(file_name);
+    if (!in.is_open())
+        error("Unable to open '{}'.", file_name);
 }
 
 void
-write_node_set_names(exodusIIcpp::File & exo, const YAML::Node & yml)
+write_coordinate_names(exodusIIcpp::File & exo, const MeshInfo & info)
 {
-    bool have_names = false;
-    std::vector<std::string> ns_names;
-    for (auto & n : yml) {
-        if (n["name"]) {
-            auto name = n["name"].as<std::string>();
-            have_names = true;
-            ns_names.push_back(name);
-        }
-        else {
-            std::string name = fmt::format("{}", n["id"].as<int>());
-            ns_names.push_back(name);
-        }
+    if (!info.coord_names.empty())
+        exo.write_coord_names(info.coord_names);
+    else {
+        if (info.dim == 1)
+            exo.write_coord_names({ "x" });
+        else if (info.dim == 2)
+            exo.write_coord_names({ "x", "y" });
+        else if (info.dim == 3)
+            exo.write_coord_names({ "x", "y", "z" });
+        else
+            error("Unsupported dimension '{}'.", info.dim);
     }
-    if (have_names)
-        exo.write_node_set_names(ns_names);
 }
 
-void
-write_node_sets(exodusIIcpp::File & exo, const YAML::Node & yml)
+/// Get names of blocks or sets, if at least one of them has a name
+///
+/// Entities without a name are named by their ID.
+template <typename T>
+std::vector<std::string>
+get_names(const std::vector<T> & entities)
 {
-    for (auto & ns : yml) {
-        int64_t id = ns["id"].as<int>();
-        auto name = ns["name"].as<std::string>();
-        std::vector<int> node_ids;
-        for (auto & m : ns["data"]) {
-            auto nid = m.as<int>();
-            node_ids.push_back(nid);
-        }
-        exo.write_node_set(id, node_ids);
+    bool have_names = false;
+    std::vector<std::string> names;
+    names.reserve(entities.size());
+    for (auto & ent : entities) {
+        if (!ent.name.empty()) {
+            have_names = true;
+            names.push_back(ent.name);
+        }
+        else
+            names.push_back(fmt::format("{}", ent.id));
     }
+    if (!have_names)
+        names.clear();
+    return names;
 }
 
 void
-save_exo(const std::string & exo_file_name, const YAML::Node & yml)
+save_exo(const std::string & exo_file_name,
+         const std::string & yml_file_name,
+         const MeshInfo & info)
 {
     exodusIIcpp::File exo(exo_file_name, exodusIIcpp::FileAccess::WRITE);
 
-    int n_nodes = yml["coords"].size();
-    int n_elem_blks = 0;
-    int n_elems = 0;
-    if (yml["element-blocks"]) {
-        n_elem_blks = static_cast<int>(yml["element-blocks"].size());
-        for (auto & blk : yml["element-blocks"])
-            n_elems += blk["connectivity"].size();
-    }
-    int n_node_sets = 0;
-    if (yml["node-sets"])
-        n_node_sets = static_cast<int>(yml["node-sets"].size());
-    int n_side_sets = 0;
-    if (yml["side-sets"])
-        n_side_sets = static_cast<int>(yml["side-sets"].size());
-    std::string title = yml["title"] ? yml["title"].as<std::string>() : "";
-    int dim = yml["dim"].as<int>();
-    exo.init(title.c_str(), dim, n_nodes, n_elems, n_elem_blks, n_node_sets, n_side_sets);
-
-    write_coordinate_names(exo, dim, yml["coord-names"]);
-    write_coordinates(exo, dim, yml["coords"]);
-    if (yml["element-blocks"]) {
-        write_block_names(exo, yml["element-blocks"]);
-        write_element_blocks(exo, yml["element-blocks"]);
-    }
-    if (yml["side-sets"]) {
-        write_side_set_names(exo, yml["side-sets"]);
-        write_side_sets(exo, yml["side-sets"]);
-    }
-    if (yml["node-sets"]) {
-        write_node_set_names(exo, yml["node-sets"]);
-        write_node_sets(exo, yml["node-sets"]);
-    }
+    int64_t n_elems = 0;
+    for (auto & blk : info.blocks)
+        n_elems += blk.n_elems;
+    exo.init(info.title.c_str(),
+             info.dim,
+             static_cast<int>(info.n_nodes),
+             static_cast<int>(n_elems),
+             static_cast<int>(info.blocks.size()),
+             static_cast<int>(info.node_sets.size()),
+             static_cast<int>(info.side_sets.size()));
+
+    write_coordinate_names(exo, info);
+    auto block_names = get_names(info.blocks);
+    if (!block_names.empty())
+        exo.write_block_names(block_names);
+    auto ss_names = get_names(info.side_sets);
+    if (!ss_names.empty())
+        exo.write_side_set_names(ss_names);
+    auto ns_names = get_names(info.node_sets);
+    if (!ns_names.empty())
+        exo.write_node_set_names(ns_names);
+
+    std::ifstream in;
+    open_yaml(in, yml_file_name);
+    MeshWriter writer(info, exo);
+    writer.parse(in);
 }
 
 void
 yml2exo(const std::string & yml_file_name, const std::string & exo_file_name)
 {
     try {
-        YAML::Node yml = load_yaml(yml_file_name);
-        if (yml["exodusII"])
-            save_exo(exo_file_name, yml["exodusII"]);
-        else
+        MeshInfo info;
+        std::ifstream in;
+        open_yaml(in, yml_file_name);
+        MeshScanner scanner(info);
+        scanner.parse(in);
+        in.close();
+
+        if (!info.has_root)
             error("The YML file is missing the root node 'exodusII'.");
+        save_exo(exo_file_name, yml_file_name, info);
     }
     catch (YAML::Exception & e) {
         fmt::print("{}\n", e.what());